@@ -31,13 +31,24 @@
 #include <string.h>
 #include <math.h>
 
+// SSE2 (Optional)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define SK_JSON_PARSER_SSE2 1
+# include <emmintrin.h>
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // JSON Parser (Defines, Enumerations, Types)
 ////////////////////////////////////////////////////////////////////////////////
 
-#define SK_JSON_PARSER_BUFFER_SIZE 1024
 #define SK_JSON_PARSER_TOKEN_SIZE 1
 #define SK_JSON_PARSER_PEEK_SIZE 2
+#define SK_JSON_ARENA_BLOCK_SIZE 4096
+#define SK_JSON_ARENA_ALIGNMENT 8
+#define SK_JSON_OBJECT_INDEX_THRESHOLD 8
 #define SK_ISNUM(v)  ((v) >= '0' && (v) <= '9')
 #define SK_ISALPHA(v) ((tolower(v) >= 'a' && tolower(v) <= 'z'))
 #define SK_ISALNUM(v) (SK_ISNUM(v) || SK_ISALPHA(v))
@@ -73,11 +84,6 @@ typedef enum SkJsonParserTagIMPL {
   SK_JSON_PARSER_TAG_EOF_IMPL
 } SkJsonParserTagIMPL;
 
-typedef enum SkJsonParserSourceTypeIMPL {
-  SK_JSON_PARSER_SOURCE_TYPE_FILE_IMPL,
-  SK_JSON_PARSER_SOURCE_TYPE_STRING_IMPL
-} SkJsonParserSourceTypeIMPL;
-
 typedef struct SkJsonParserTokenIMPL {
   SkJsonParserTagIMPL                   tag;
   size_t                                stringLength;
@@ -86,34 +92,15 @@ typedef struct SkJsonParserTokenIMPL {
   double                                numberAttribute;
 } SkJsonParserTokenIMPL;
 
-typedef struct SkJsonParserStringInputIMPL {
-  SkJsonParserSourceTypeIMPL            sourceType;
-  char const*                           pString;
-} SkJsonParserStringInputIMPL;
-
-typedef struct SkJsonParserFileInputIMPL {
-  SkJsonParserSourceTypeIMPL            sourceType;
-  FILE*                                 pFile;
-  char                                  buffer[SK_JSON_PARSER_BUFFER_SIZE + 1];
-  int                                   currCharIndex;
-} SkJsonParserFileInputIMPL;
-
-typedef union SkJsonParserInputIMPL {
-  SkJsonParserSourceTypeIMPL            sourceType;
-  SkJsonParserFileInputIMPL             fileInput;
-  SkJsonParserStringInputIMPL           stringInput;
+// All input is parsed from a contiguous range of memory. File input is read in
+// a single block up-front, which allows whitespace and strings to be scanned
+// in spans rather than pulling the source one character at a time.
+typedef struct SkJsonParserInputIMPL {
+  char*                                 pBuffer;
+  unsigned char const*                  pCurr;
+  unsigned char const*                  pEnd;
 } SkJsonParserInputIMPL;
 
-typedef struct SkJsonParserIMPL {
-  SkAllocationCallbacks const*          pAllocator;
-  SkJsonParserInputIMPL                 input;
-  SkJsonParserTokenIMPL                 peekToken[SK_JSON_PARSER_TOKEN_SIZE];
-  int                                   peekChar[SK_JSON_PARSER_PEEK_SIZE];
-  int                                   currCharIndex;
-  int                                   currTokenIndex;
-  SkSystemAllocationScope               allocationScope;
-} SkJsonParserIMPL;
-
 ////////////////////////////////////////////////////////////////////////////////
 // JSON Types
 ////////////////////////////////////////////////////////////////////////////////
@@ -146,10 +133,28 @@ typedef struct SkJsonValue_T {
   SkJsonInternalIMPL                    internal;
 } SkJsonValue_T;
 
+// The entire JSON DOM (values, property arrays and strings) is allocated out of
+// a single arena, which is owned by the root object and released all at once.
+typedef struct SkJsonArenaBlockIMPL {
+  struct SkJsonArenaBlockIMPL*          pNext;
+  size_t                                capacity;
+  size_t                                offset;
+} SkJsonArenaBlockIMPL;
+
+typedef struct SkJsonArenaIMPL {
+  SkJsonArenaBlockIMPL*                 pBlocks;
+  size_t                                nextBlockSize;
+} SkJsonArenaIMPL;
+
+// Objects with at least SK_JSON_OBJECT_INDEX_THRESHOLD properties also carry
+// an open-addressing index of (property index + 1), zero marks an empty slot.
 typedef struct SkJsonObject_T {
   SkJsonType                            jType;
   SkObject*                             pParent;
   SkJsonPropertyVectorIMPL              properties;
+  uint32_t*                             pPropertyIndex;
+  uint32_t                              propertyIndexMask;
+  SkJsonArenaIMPL*                      pArena;
 } SkJsonObject_T;
 
 typedef struct SkJsonArray_T {
@@ -158,102 +163,213 @@ typedef struct SkJsonArray_T {
   SkJsonValueVectorIMPL                 elements;
 } SkJsonArray_T;
 
+////////////////////////////////////////////////////////////////////////////////
+// JSON Parser (Types)
+////////////////////////////////////////////////////////////////////////////////
+
+// Properties and elements are gathered on shared scratch stacks while their
+// parent is being parsed, and copied into the arena once the parent is closed.
+typedef struct SkJsonParserIMPL {
+  SkAllocationCallbacks const*          pAllocator;
+  SkJsonParserInputIMPL                 input;
+  SkJsonParserTokenIMPL                 peekToken[SK_JSON_PARSER_TOKEN_SIZE];
+  int                                   currTokenIndex;
+  SkSystemAllocationScope               allocationScope;
+  SkJsonArenaIMPL*                      pArena;
+  SkJsonPropertyVectorIMPL              propertyStack;
+  SkJsonValueVectorIMPL                 valueStack;
+} SkJsonParserIMPL;
+
 ////////////////////////////////////////////////////////////////////////////////
 // JSON Source (Functionality)
 ////////////////////////////////////////////////////////////////////////////////
 
-static void skUpdateJsonParserCharacter_FileSourceIMPL(
-  SkJsonParserFileInputIMPL*            pFileInput
+static SkJsonParserResultIMPL skInitializeJsonParserInput_StringIMPL(
+  SkJsonParserIMPL*                     pParser,
+  char const*                           pString
 ) {
-  size_t bytesRead;
-  bytesRead = fread(
-    pFileInput->buffer,
-    sizeof(char),
-    SK_JSON_PARSER_BUFFER_SIZE,
-    pFileInput->pFile
-  );
-  pFileInput->buffer[bytesRead] = 0;
+  pParser->input.pBuffer = NULL;
+  pParser->input.pCurr = (unsigned char const*)pString;
+  pParser->input.pEnd = pParser->input.pCurr + strlen(pString);
+  return SK_JSON_PARSER_SUCCESS_IMPL;
 }
 
-static int skNextJsonParserCharacter_FileSourceIMPL(
-  SkJsonParserIMPL*                     pParser
+static SkJsonParserResultIMPL skInitializeJsonParserInput_FileIMPL(
+  SkJsonParserIMPL*                     pParser,
+  FILE*                                 pFile
 ) {
-  int currChar;
+  long fileSize;
+  size_t bytesRead;
 
-  // Grab the next buffer input, and check that it's not EoF
-  currChar = pParser->input.fileInput.buffer[pParser->input.fileInput.currCharIndex];
-  if (currChar == 0) {
-    return 0;
+  // Determine the size of the file, so that it can be read in one block.
+  if (fseek(pFile, 0, SEEK_END) != 0) {
+    return SK_JSON_PARSER_ERROR_UNSUPPORTED_FILE_SOURCE_IMPL;
+  }
+  fileSize = ftell(pFile);
+  if (fileSize < 0 || fseek(pFile, 0, SEEK_SET) != 0) {
+    return SK_JSON_PARSER_ERROR_UNSUPPORTED_FILE_SOURCE_IMPL;
   }
 
-  // Move to the next buffer index, check if we should wrap and read
-  ++pParser->input.fileInput.currCharIndex;
-  if (pParser->input.fileInput.currCharIndex == SK_JSON_PARSER_BUFFER_SIZE) {
-    pParser->input.fileInput.currCharIndex = 0;
-    skUpdateJsonParserCharacter_FileSourceIMPL(&pParser->input.fileInput);
+  // Read the entire file into memory (+1 for null-terminator).
+  pParser->input.pBuffer = skAllocate(
+    pParser->pAllocator,
+    (size_t)fileSize + 1,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!pParser->input.pBuffer) {
+    return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
+  bytesRead = fread(pParser->input.pBuffer, 1, (size_t)fileSize, pFile);
+  pParser->input.pBuffer[bytesRead] = 0;
+  pParser->input.pCurr = (unsigned char const*)pParser->input.pBuffer;
+  pParser->input.pEnd = pParser->input.pCurr + bytesRead;
 
-  return currChar;
+  return SK_JSON_PARSER_SUCCESS_IMPL;
 }
 
-static int skNextJsonParserCharacter_StringSourceIMPL(
+static void skNextJsonParserCharacterIMPL(
   SkJsonParserIMPL*                     pParser
 ) {
-  if (*(pParser->input.stringInput.pString)) {
-    return *(pParser->input.stringInput.pString++);
+  if (pParser->input.pCurr < pParser->input.pEnd) {
+    ++pParser->input.pCurr;
   }
-  return 0;
 }
 
-static int skNextJsonParserCharacter_SourceIMPL(
+static int skGetJsonParserCharacterIMPL(
   SkJsonParserIMPL*                     pParser
 ) {
-  switch (pParser->input.sourceType) {
-    case SK_JSON_PARSER_SOURCE_TYPE_FILE_IMPL:
-      return skNextJsonParserCharacter_FileSourceIMPL(pParser);
-    case SK_JSON_PARSER_SOURCE_TYPE_STRING_IMPL:
-      return skNextJsonParserCharacter_StringSourceIMPL(pParser);
+  if (pParser->input.pCurr < pParser->input.pEnd) {
+    return *pParser->input.pCurr;
   }
-  return SK_JSON_PARSER_ERROR_UNSUPPORTED_FILE_SOURCE_IMPL;
+  return 0;
 }
 
-static void skInitializeJsonParserCharacter_SourceIMPL(
-  SkJsonParserIMPL*                     pParser
+static int skPeekJsonParserCharacterIMPL(
+  SkJsonParserIMPL*                     pParser,
+  uint32_t                              peekIndex
 ) {
-  switch (pParser->input.sourceType) {
-    case SK_JSON_PARSER_SOURCE_TYPE_FILE_IMPL:
-      skUpdateJsonParserCharacter_FileSourceIMPL(&pParser->input.fileInput);
-      break;
-    default:
-      break;
+  if (peekIndex >= SK_JSON_PARSER_PEEK_SIZE) {
+    return -1;
   }
+  if (peekIndex < (size_t)(pParser->input.pEnd - pParser->input.pCurr)) {
+    return pParser->input.pCurr[peekIndex];
+  }
+  return 0;
 }
 
-static void skNextJsonParserCharacterIMPL(
+#ifdef    SK_JSON_PARSER_SSE2
+static int skCountTrailingZerosIMPL(
+  uint32_t                              mask
+) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (int)index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+#endif // SK_JSON_PARSER_SSE2
+
+static void skSkipJsonParserWhiteSpaceIMPL(
   SkJsonParserIMPL*                     pParser
 ) {
-  // Read the next character into the current slot
-  pParser->peekChar[pParser->currCharIndex] =
-    skNextJsonParserCharacter_SourceIMPL(pParser);
+  unsigned char const* pCurr;
+  unsigned char const* pEnd;
+#ifdef    SK_JSON_PARSER_SSE2
+  uint32_t mask;
+  __m128i chunk;
+#endif // SK_JSON_PARSER_SSE2
+
+  pCurr = pParser->input.pCurr;
+  pEnd = pParser->input.pEnd;
+
+#ifdef    SK_JSON_PARSER_SSE2
+  // Consume 16 characters at a time, stopping at the first non-whitespace.
+  while (pEnd - pCurr >= 16) {
+    chunk = _mm_loadu_si128((__m128i const*)pCurr);
+    mask = (uint32_t)_mm_movemask_epi8(
+      _mm_or_si128(
+        _mm_or_si128(
+          _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x20)),
+          _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x0A))
+        ),
+        _mm_or_si128(
+          _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x09)),
+          _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x0D))
+        )
+      )
+    );
+    if (mask != 0xFFFF) {
+      pParser->input.pCurr = pCurr + skCountTrailingZerosIMPL(~mask);
+      return;
+    }
+    pCurr += 16;
+  }
+#endif // SK_JSON_PARSER_SSE2
 
-  // Increment the peek character and modulo for next character
-  pParser->currCharIndex = (pParser->currCharIndex + 1) % SK_JSON_PARSER_PEEK_SIZE;
+  // Consume the remaining characters one at a time.
+  while (pCurr < pEnd) {
+    switch (*pCurr) {
+      case 0x09:
+      case 0x0A:
+      case 0x0D:
+      case 0x20:
+        ++pCurr;
+        break;
+      default:
+        pParser->input.pCurr = pCurr;
+        return;
+    }
+  }
+  pParser->input.pCurr = pCurr;
 }
 
-static int skGetJsonParserCharacterIMPL(
+static size_t skScanJsonParserStringSpanIMPL(
   SkJsonParserIMPL*                     pParser
 ) {
-  return pParser->peekChar[pParser->currCharIndex];
+  unsigned char const* pCurr;
+  unsigned char const* pEnd;
+#ifdef    SK_JSON_PARSER_SSE2
+  uint32_t mask;
+  __m128i chunk;
+#endif // SK_JSON_PARSER_SSE2
+
+  // Find the length of the span which contains no quotes, escapes or nulls.
+  // The caller is expected to handle whichever character ended the span.
+  pCurr = pParser->input.pCurr;
+  pEnd = pParser->input.pEnd;
+
+#ifdef    SK_JSON_PARSER_SSE2
+  while (pEnd - pCurr >= 16) {
+    chunk = _mm_loadu_si128((__m128i const*)pCurr);
+    mask = (uint32_t)_mm_movemask_epi8(
+      _mm_or_si128(
+        _mm_or_si128(
+          _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+          _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))
+        ),
+        _mm_cmpeq_epi8(chunk, _mm_setzero_si128())
+      )
+    );
+    if (mask) {
+      return (size_t)(pCurr - pParser->input.pCurr) + skCountTrailingZerosIMPL(mask);
+    }
+    pCurr += 16;
+  }
+#endif // SK_JSON_PARSER_SSE2
+
+  while (pCurr < pEnd && *pCurr != '"' && *pCurr != '\\' && *pCurr != 0) {
+    ++pCurr;
+  }
+  return (size_t)(pCurr - pParser->input.pCurr);
 }
 
-static int skPeekJsonParserCharacterIMPL(
-  SkJsonParserIMPL*                     pParser,
-  uint32_t                              peekIndex
+static void skDeinitializeJsonParserInputIMPL(
+  SkJsonParserIMPL*                     pParser
 ) {
-  if (peekIndex >= SK_JSON_PARSER_PEEK_SIZE) {
-    return -1;
-  }
-  return pParser->peekChar[(pParser->currCharIndex + peekIndex) % SK_JSON_PARSER_PEEK_SIZE];
+  skFree(pParser->pAllocator, pParser->input.pBuffer);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -308,22 +424,33 @@ static SkJsonParserResultIMPL skPushJsonParserTokenStringIMPL(
   return SK_JSON_PARSER_SUCCESS_IMPL;
 }
 
-static void skUpdateJsonParserTokens_WhiteSpaceIMPL(
-  SkJsonParserIMPL*                     pParser
+static SkJsonParserResultIMPL skAppendJsonParserTokenStringIMPL(
+  SkJsonParserIMPL*                     pParser,
+  SkJsonParserTokenIMPL*                pToken,
+  char const*                           pCharacters,
+  size_t                                characterCount
 ) {
-  for (;;) {
-    switch (skGetJsonParserCharacterIMPL(pParser)) {
-      case 0x09:
-      case 0x0A:
-      case 0x0D:
-      case 0x20:
-        skNextJsonParserCharacterIMPL(pParser);
-        break;
-      default:
-        // Not a whitespace character, this function is done
-        return;
+  SkJsonParserResultIMPL result;
+
+  // Check that the string is large enough to hold the characters
+  while (pToken->stringCapacity - pToken->stringLength < characterCount) {
+    result = skGrowJsonParserTokenStringIMPL(pParser, pToken);
+    if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
+      return result;
     }
   }
+
+  // Copy the characters onto the attribute
+  memcpy(&pToken->stringAttribute[pToken->stringLength], pCharacters, characterCount);
+  pToken->stringLength += characterCount;
+
+  return SK_JSON_PARSER_SUCCESS_IMPL;
+}
+
+static void skUpdateJsonParserTokens_WhiteSpaceIMPL(
+  SkJsonParserIMPL*                     pParser
+) {
+  skSkipJsonParserWhiteSpaceIMPL(pParser);
 }
 
 static void skUpdateJsonParserTokens_Comments_SingleLineIMPL(
@@ -438,6 +565,7 @@ static SkJsonParserResultIMPL skUpdateJsonParserTokens_String_EscapeSequenceIMPL
 ) {
   int currChar;
   currChar = skGetJsonParserCharacterIMPL(pParser);
+  skNextJsonParserCharacterIMPL(pParser);
   switch (currChar) {
     case '"':
       return skPushJsonParserTokenStringIMPL(pParser, pToken, 0x22);
@@ -467,23 +595,41 @@ static SkJsonParserResultIMPL skUpdateJsonParserTokens_StringIMPL(
   SkJsonParserTokenIMPL*                pToken
 ) {
   int currChar;
+  size_t spanLength;
   SkJsonParserResultIMPL result;
 
   pToken->stringLength = 0;
   pToken->tag = SK_JSON_PARSER_TAG_INVALID_IMPL;
   for (;;) {
+
+    // Copy the span of plain characters in one go
+    spanLength = skScanJsonParserStringSpanIMPL(pParser);
+    if (spanLength) {
+      result = skAppendJsonParserTokenStringIMPL(
+        pParser,
+        pToken,
+        (char const*)pParser->input.pCurr,
+        spanLength
+      );
+      if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
+        return result;
+      }
+      pParser->input.pCurr += spanLength;
+    }
+
+    // Handle the character which terminated the span
     currChar = skGetJsonParserCharacterIMPL(pParser);
     skNextJsonParserCharacterIMPL(pParser);
     switch (currChar) {
       case '\\':
         result = skUpdateJsonParserTokens_String_EscapeSequenceIMPL(pParser, pToken);
         break;
-      default:
-        result = skPushJsonParserTokenStringIMPL(pParser, pToken, (char)currChar);
-        break;
       case '"':
         pToken->tag = SK_JSON_PARSER_TAG_STRING_IMPL;
         return skPushJsonParserTokenStringIMPL(pParser, pToken, 0);
+      default:
+        // Note: The input ended before the string was terminated.
+        return SK_JSON_PARSER_ERROR_UNEXPECTED_TOKEN_IMPL;
     }
     if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
       return result;
@@ -742,70 +888,144 @@ static SkJsonParserTokenIMPL* skGetJsonParserTokenIMPL(
 // JSON Private Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-void skDestroyJsonValueIMPL(
-  SkAllocationCallbacks const*          pAllocator,
-  SkJsonValue                           value
-);
+static SkJsonArenaBlockIMPL* skAllocateJsonArenaBlockIMPL(
+  SkJsonParserIMPL*                     pParser,
+  size_t                                capacity
+) {
+  SkJsonArenaBlockIMPL* pBlock;
 
-static void skDestroyJsonArrayIMPL(
-  SkAllocationCallbacks const*          pAllocator,
-  SkJsonArray                           array
+  // Note: Aligned allocations must be a multiple of the alignment.
+  capacity = (capacity + SK_JSON_ARENA_ALIGNMENT - 1) & ~(size_t)(SK_JSON_ARENA_ALIGNMENT - 1);
+  pBlock = skAllocate(
+    pParser->pAllocator,
+    sizeof(SkJsonArenaBlockIMPL) + capacity,
+    SK_JSON_ARENA_ALIGNMENT,
+    pParser->allocationScope
+  );
+  if (!pBlock) {
+    return NULL;
+  }
+  pBlock->pNext = NULL;
+  pBlock->capacity = capacity;
+  pBlock->offset = 0;
+
+  return pBlock;
+}
+
+static SkJsonParserResultIMPL skCreateJsonArenaIMPL(
+  SkJsonParserIMPL*                     pParser
 ) {
-  uint32_t idx;
-  for (idx = 0; idx < array->elements.count; ++idx) {
-    skDestroyJsonValueIMPL(pAllocator, array->elements.pData[idx]);
+  size_t blockSize;
+  SkJsonArenaIMPL* pArena;
+  SkJsonArenaBlockIMPL* pBlock;
+
+  // Size the first block from the input, most documents fit in one block.
+  blockSize = SK_JSON_ARENA_BLOCK_SIZE
+            + 2 * (size_t)(pParser->input.pEnd - pParser->input.pCurr);
+  pBlock = skAllocateJsonArenaBlockIMPL(pParser, blockSize);
+  if (!pBlock) {
+    return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
-  skFree(pAllocator, array->elements.pData);
-  skFree(pAllocator, array);
+
+  // The arena itself lives at the front of the first block.
+  pArena = (SkJsonArenaIMPL*)(pBlock + 1);
+  pArena->pBlocks = pBlock;
+  pArena->nextBlockSize = blockSize * 2;
+  pBlock->offset = (sizeof(SkJsonArenaIMPL) + SK_JSON_ARENA_ALIGNMENT - 1)
+                 & ~(size_t)(SK_JSON_ARENA_ALIGNMENT - 1);
+  pParser->pArena = pArena;
+
+  return SK_JSON_PARSER_SUCCESS_IMPL;
 }
 
-static void skDestroyJsonStringIMPL(
+static void skDestroyJsonArenaIMPL(
   SkAllocationCallbacks const*          pAllocator,
-  SkJsonValue                           value
+  SkJsonArenaIMPL*                      pArena
 ) {
-  skFree(pAllocator, value->internal.string);
-  skFree(pAllocator, value);
+  SkJsonArenaBlockIMPL* pBlock;
+  SkJsonArenaBlockIMPL* pNextBlock;
+
+  // Note: The arena is stored within the last block, don't access it after.
+  pBlock = pArena->pBlocks;
+  while (pBlock) {
+    pNextBlock = pBlock->pNext;
+    skFree(pAllocator, pBlock);
+    pBlock = pNextBlock;
+  }
 }
 
-static void skDestroyJsonLiteralIMPL(
-  SkAllocationCallbacks const*          pAllocator,
-  SkJsonValue                           value
+static void* skAllocateJsonArenaIMPL(
+  SkJsonParserIMPL*                     pParser,
+  size_t                                size
+) {
+  void* pMemory;
+  size_t blockSize;
+  SkJsonArenaIMPL* pArena;
+  SkJsonArenaBlockIMPL* pBlock;
+
+  // Find a block with enough room, or allocate a new one.
+  pArena = pParser->pArena;
+  size = (size + SK_JSON_ARENA_ALIGNMENT - 1) & ~(size_t)(SK_JSON_ARENA_ALIGNMENT - 1);
+  pBlock = pArena->pBlocks;
+  if (pBlock->capacity - pBlock->offset < size) {
+    blockSize = (size > pArena->nextBlockSize) ? size : pArena->nextBlockSize;
+    pBlock = skAllocateJsonArenaBlockIMPL(pParser, blockSize);
+    if (!pBlock) {
+      return NULL;
+    }
+    pBlock->pNext = pArena->pBlocks;
+    pArena->pBlocks = pBlock;
+    pArena->nextBlockSize *= 2;
+  }
+
+  // Carve the allocation out of the block.
+  pMemory = (uint8_t*)(pBlock + 1) + pBlock->offset;
+  pBlock->offset += size;
+  return pMemory;
+}
+
+static void* skClearAllocateJsonArenaIMPL(
+  SkJsonParserIMPL*                     pParser,
+  size_t                                size
 ) {
-  skFree(pAllocator, value);
+  void* pMemory;
+  pMemory = skAllocateJsonArenaIMPL(pParser, size);
+  if (pMemory) {
+    memset(pMemory, 0, size);
+  }
+  return pMemory;
 }
 
-void skDestroyJsonValueIMPL(
-  SkAllocationCallbacks const*          pAllocator,
-  SkJsonValue                           value
+static char* skCopyJsonArenaStringIMPL(
+  SkJsonParserIMPL*                     pParser,
+  SkJsonParserTokenIMPL const*          pToken
 ) {
+  char* pString;
 
-  switch (value->jType) {
-    case SK_JSON_TYPE_OBJECT:
-      skDestroyJsonObject(pAllocator, (SkJsonObject)value);
-      break;
-    case SK_JSON_TYPE_ARRAY:
-      skDestroyJsonArrayIMPL(pAllocator, (SkJsonArray)value);
-      break;
-    case SK_JSON_TYPE_NUMBER:
-      skDestroyJsonLiteralIMPL(pAllocator, value);
-      break;
-    case SK_JSON_TYPE_STRING:
-      skDestroyJsonStringIMPL(pAllocator, value);
-      break;
-    case SK_JSON_TYPE_TRUE:
-      skDestroyJsonLiteralIMPL(pAllocator, value);
-      break;
-    case SK_JSON_TYPE_FALSE:
-      skDestroyJsonLiteralIMPL(pAllocator, value);
-      break;
-    case SK_JSON_TYPE_NULL:
-      skDestroyJsonLiteralIMPL(pAllocator, value);
-      break;
-    default:
-      // Ignore other cases, they are not valid
-      break;
+  // Note: The token's string length already includes the null-terminator.
+  pString = skAllocateJsonArenaIMPL(pParser, pToken->stringLength + 1);
+  if (!pString) {
+    return NULL;
   }
+  memcpy(pString, pToken->stringAttribute, pToken->stringLength);
+  pString[pToken->stringLength] = 0;
 
+  return pString;
+}
+
+static uint32_t skHashJsonPropertyNameIMPL(
+  char const*                           pPropertyName
+) {
+  uint32_t hash;
+
+  // FNV-1a (32-bit)
+  hash = 2166136261u;
+  while (*pPropertyName) {
+    hash ^= (uint8_t)*pPropertyName++;
+    hash *= 16777619u;
+  }
+
+  return hash;
 }
 
 static SkJsonPropertyIMPL* skGetJsonObjectPropertyIMPL(
@@ -813,8 +1033,23 @@ static SkJsonPropertyIMPL* skGetJsonObjectPropertyIMPL(
   char const*                           pPropertyName
 ) {
   uint32_t idx;
+  uint32_t slot;
   SkJsonPropertyIMPL* pProperty;
 
+  // Large objects are looked up through the hashed property index
+  if (object->pPropertyIndex) {
+    slot = skHashJsonPropertyNameIMPL(pPropertyName) & object->propertyIndexMask;
+    while (object->pPropertyIndex[slot]) {
+      pProperty = &object->properties.pData[object->pPropertyIndex[slot] - 1];
+      if (strcmp(pProperty->name, pPropertyName) == 0) {
+        return pProperty;
+      }
+      slot = (slot + 1) & object->propertyIndexMask;
+    }
+    return NULL;
+  }
+
+  // Small objects are faster to search linearly
   for (idx = 0; idx < object->properties.count; ++idx) {
     pProperty = &object->properties.pData[idx];
     if (strcmp(pProperty->name, pPropertyName) == 0) {
@@ -825,6 +1060,19 @@ static SkJsonPropertyIMPL* skGetJsonObjectPropertyIMPL(
   return NULL;
 }
 
+static void skInsertJsonObjectPropertyIndexIMPL(
+  SkJsonObject                          object,
+  uint32_t                              propertyIndex
+) {
+  uint32_t slot;
+  slot = skHashJsonPropertyNameIMPL(object->properties.pData[propertyIndex].name)
+       & object->propertyIndexMask;
+  while (object->pPropertyIndex[slot]) {
+    slot = (slot + 1) & object->propertyIndexMask;
+  }
+  object->pPropertyIndex[slot] = propertyIndex + 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // JSON Parser (Functionality)
 ////////////////////////////////////////////////////////////////////////////////
@@ -940,13 +1188,102 @@ static SkJsonParserResultIMPL skPushJsonValueVectorIMPL(
   return SK_JSON_PARSER_SUCCESS_IMPL;
 }
 
+static SkJsonParserResultIMPL skFinalizeJsonObjectIMPL(
+  SkJsonParserIMPL*                     pParser,
+  SkJsonObject                          object,
+  uint32_t                              firstProperty
+) {
+  uint32_t idx;
+  uint32_t indexCapacity;
+  uint32_t propertyCount;
+  SkJsonPropertyIMPL* pProperty;
+  SkJsonPropertyIMPL* pStackProperty;
+
+  // Allocate the final property array (and index, if the object is large).
+  propertyCount = pParser->propertyStack.count - firstProperty;
+  if (!propertyCount) {
+    return SK_JSON_PARSER_SUCCESS_IMPL;
+  }
+  object->properties.pData = skAllocateJsonArenaIMPL(
+    pParser,
+    sizeof(SkJsonPropertyIMPL) * propertyCount
+  );
+  if (!object->properties.pData) {
+    return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
+  }
+  object->properties.capacity = propertyCount;
+  if (propertyCount >= SK_JSON_OBJECT_INDEX_THRESHOLD) {
+    indexCapacity = SK_JSON_OBJECT_INDEX_THRESHOLD * 2;
+    while (indexCapacity < propertyCount * 2) {
+      indexCapacity *= 2;
+    }
+    object->pPropertyIndex = skClearAllocateJsonArenaIMPL(
+      pParser,
+      sizeof(uint32_t) * indexCapacity
+    );
+    if (!object->pPropertyIndex) {
+      return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
+    }
+    object->propertyIndexMask = indexCapacity - 1;
+  }
+
+  // Move the properties into the object, later duplicates replace the value.
+  for (idx = firstProperty; idx < pParser->propertyStack.count; ++idx) {
+    pStackProperty = &pParser->propertyStack.pData[idx];
+    pProperty = skGetJsonObjectPropertyIMPL(object, pStackProperty->name);
+    if (pProperty) {
+      pProperty->value = pStackProperty->value;
+      continue;
+    }
+    object->properties.pData[object->properties.count] = *pStackProperty;
+    if (object->pPropertyIndex) {
+      skInsertJsonObjectPropertyIndexIMPL(object, object->properties.count);
+    }
+    ++object->properties.count;
+  }
+
+  // Pop the object's properties off of the stack
+  pParser->propertyStack.count = firstProperty;
+  return SK_JSON_PARSER_SUCCESS_IMPL;
+}
+
+static SkJsonParserResultIMPL skFinalizeJsonArrayIMPL(
+  SkJsonParserIMPL*                     pParser,
+  SkJsonArray                           array,
+  uint32_t                              firstElement
+) {
+  uint32_t elementCount;
+
+  // Allocate the final element array and move the elements into it.
+  elementCount = pParser->valueStack.count - firstElement;
+  if (!elementCount) {
+    return SK_JSON_PARSER_SUCCESS_IMPL;
+  }
+  array->elements.pData = skAllocateJsonArenaIMPL(
+    pParser,
+    sizeof(SkJsonValue) * elementCount
+  );
+  if (!array->elements.pData) {
+    return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
+  }
+  memcpy(
+    array->elements.pData,
+    &pParser->valueStack.pData[firstElement],
+    sizeof(SkJsonValue) * elementCount
+  );
+  array->elements.capacity = elementCount;
+  array->elements.count = elementCount;
+
+  // Pop the array's elements off of the stack
+  pParser->valueStack.count = firstElement;
+  return SK_JSON_PARSER_SUCCESS_IMPL;
+}
+
 static SkJsonParserResultIMPL skParseJsonObject_PropertyIMPL(
   SkJsonParserIMPL*                     pParser,
   SkJsonObject                          object
 ) {
-  SkJsonValue value;
   SkJsonPropertyIMPL newProperty;
-  SkJsonPropertyIMPL* pProperty;
   SkJsonParserResultIMPL result;
   SkJsonParserTokenIMPL* currToken;
 
@@ -956,65 +1293,34 @@ static SkJsonParserResultIMPL skParseJsonObject_PropertyIMPL(
     return SK_JSON_PARSER_ERROR_UNEXPECTED_TOKEN_IMPL;
   }
 
-  // Check to see that there isn't already a property of that name.
-  pProperty = skGetJsonObjectPropertyIMPL(object, currToken->stringAttribute);
-  if (!pProperty) {
-
-    // Allocate the property name (+1 for null-terminator)
-    newProperty.name = skAllocate(
-      pParser->pAllocator,
-      currToken->stringLength + 1,
-      1,
-      pParser->allocationScope
-    );
-    if (!newProperty.name) {
-      return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
-    }
-
-    // Copy the property name string and continue to parse value
-    strcpy(newProperty.name, currToken->stringAttribute);
-
-    // Add the property to the Json object
-    result = skPushJsonPropertyVectorIMPL(pParser, &object->properties, &newProperty);
-    if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-      skFree(pParser->pAllocator, newProperty.name);
-      --object->properties.count;
-      return result;
-    }
-
-    pProperty = &object->properties.pData[object->properties.count - 1];
-  }
-  else {
-    skDestroyJsonValueIMPL(pParser->pAllocator, pProperty->value);
+  // Copy the property name string and continue to parse value
+  // Note: Duplicate properties are resolved when the object is finalized.
+  newProperty.name = skCopyJsonArenaStringIMPL(pParser, currToken);
+  if (!newProperty.name) {
+    return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
 
   // Consume the string token
   result = skNextJsonParserTokenIMPL(pParser);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skFree(pParser->pAllocator, pProperty->name);
-    --object->properties.count;
     return result;
   }
 
   // Check that the next token is a colon
   result = skExpectJsonParserTokenIMPL(pParser, SK_JSON_PARSER_TAG_COLON_IMPL);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skFree(pParser->pAllocator, pProperty->name);
-    --object->properties.count;
     return result;
   }
 
   // Read the property value in:
-  result = skParseJsonValueIMPL(pParser, &value);
+  result = skParseJsonValueIMPL(pParser, &newProperty.value);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skFree(pParser->pAllocator, pProperty->name);
-    --object->properties.count;
     return result;
   }
-  value->parent = (SkJsonValue)object;
-  pProperty->value = value;
+  newProperty.value->parent = (SkJsonValue)object;
 
-  return SK_JSON_PARSER_SUCCESS_IMPL;
+  // Add the property to the object's pending properties
+  return skPushJsonPropertyVectorIMPL(pParser, &pParser->propertyStack, &newProperty);
 }
 
 static SkJsonParserResultIMPL skParseJsonObjectIMPL(
@@ -1022,6 +1328,7 @@ static SkJsonParserResultIMPL skParseJsonObjectIMPL(
   SkJsonObject*                         pObject
 ) {
   SkJsonObject object;
+  uint32_t firstProperty;
   SkJsonParserResultIMPL result;
   SkJsonParserTokenIMPL* currToken;
 
@@ -1032,18 +1339,15 @@ static SkJsonParserResultIMPL skParseJsonObjectIMPL(
   }
 
   // Allocate the JSON object
-  object = skClearAllocate(
-    pParser->pAllocator,
-    sizeof(SkJsonObject_T),
-    1,
-    pParser->allocationScope
-  );
+  object = skClearAllocateJsonArenaIMPL(pParser, sizeof(SkJsonObject_T));
   if (!object) {
     return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
 
   // Begin parsing the object
+  // Note: On failure, everything allocated is released with the arena.
   object->jType = SK_JSON_TYPE_OBJECT;
+  firstProperty = pParser->propertyStack.count;
   currToken = skGetJsonParserTokenIMPL(pParser);
 
   // Parse properties until there are none left
@@ -1055,7 +1359,6 @@ static SkJsonParserResultIMPL skParseJsonObjectIMPL(
       // Consume the property
       result = skParseJsonObject_PropertyIMPL(pParser, object);
       if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-        skDestroyJsonObject(pParser->pAllocator, object);
         return result;
       }
 
@@ -1068,7 +1371,6 @@ static SkJsonParserResultIMPL skParseJsonObjectIMPL(
       // Consume the comma
       result = skNextJsonParserTokenIMPL(pParser);
       if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-        skDestroyJsonObject(pParser->pAllocator, object);
         return result;
       }
 
@@ -1079,7 +1381,12 @@ static SkJsonParserResultIMPL skParseJsonObjectIMPL(
   // Check that the next token is indeed }
   result = skExpectJsonParserTokenIMPL(pParser, SK_JSON_PARSER_TAG_RIGHT_CURLY_BRACKET_IMPL);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skDestroyJsonObject(pParser->pAllocator, object);
+    return result;
+  }
+
+  // Move the parsed properties into the object
+  result = skFinalizeJsonObjectIMPL(pParser, object, firstProperty);
+  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
     return result;
   }
 
@@ -1094,6 +1401,7 @@ static SkJsonParserResultIMPL skParseJsonArrayIMPL(
 ) {
   SkJsonValue value;
   SkJsonArray array;
+  uint32_t firstElement;
   SkJsonParserResultIMPL result;
   SkJsonParserTokenIMPL* currToken;
 
@@ -1104,18 +1412,15 @@ static SkJsonParserResultIMPL skParseJsonArrayIMPL(
   }
 
   // Allocate the JSON array
-  array = skClearAllocate(
-    pParser->pAllocator,
-    sizeof(SkJsonArray_T),
-    1,
-    pParser->allocationScope
-  );
+  array = skClearAllocateJsonArenaIMPL(pParser, sizeof(SkJsonArray_T));
   if (!array) {
     return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
 
   // Begin parsing the array
+  // Note: On failure, everything allocated is released with the arena.
   array->jType = SK_JSON_TYPE_ARRAY;
+  firstElement = pParser->valueStack.count;
   currToken = skGetJsonParserTokenIMPL(pParser);
 
   // Parse values until there are none left
@@ -1127,16 +1432,13 @@ static SkJsonParserResultIMPL skParseJsonArrayIMPL(
       // Consume the value
       result = skParseJsonValueIMPL(pParser, &value);
       if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-        skDestroyJsonArrayIMPL(pParser->pAllocator, array);
         return result;
       }
       value->parent = (SkJsonValue)array;
 
-      // Push the value into the array
-      result = skPushJsonValueVectorIMPL(pParser, &array->elements, &value);
+      // Push the value into the array's pending elements
+      result = skPushJsonValueVectorIMPL(pParser, &pParser->valueStack, &value);
       if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-        skDestroyJsonArrayIMPL(pParser->pAllocator, array);
-        --array->elements.count;
         return result;
       }
 
@@ -1149,7 +1451,6 @@ static SkJsonParserResultIMPL skParseJsonArrayIMPL(
       // Consume the comma
       result = skNextJsonParserTokenIMPL(pParser);
       if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-        skDestroyJsonArrayIMPL(pParser->pAllocator, array);
         return result;
       }
 
@@ -1160,7 +1461,12 @@ static SkJsonParserResultIMPL skParseJsonArrayIMPL(
   // Check that the next token is indeed ]
   result = skExpectJsonParserTokenIMPL(pParser, SK_JSON_PARSER_TAG_RIGHT_SQUARE_BRACKET_IMPL);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skDestroyJsonArrayIMPL(pParser->pAllocator, array);
+    return result;
+  }
+
+  // Move the parsed elements into the array
+  result = skFinalizeJsonArrayIMPL(pParser, array, firstElement);
+  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
     return result;
   }
 
@@ -1174,7 +1480,6 @@ static SkJsonParserResultIMPL skParseJsonNumberIMPL(
   SkJsonValue*                          pValue
 ) {
   SkJsonValue value;
-  SkJsonParserResultIMPL result;
   SkJsonParserTokenIMPL* currToken;
 
   // Check that the proper token is found.
@@ -1184,12 +1489,7 @@ static SkJsonParserResultIMPL skParseJsonNumberIMPL(
   }
 
   // Allocate the JSON value
-  value = skClearAllocate(
-    pParser->pAllocator,
-    sizeof(SkJsonValue_T),
-    1,
-    pParser->allocationScope
-  );
+  value = skClearAllocateJsonArenaIMPL(pParser, sizeof(SkJsonValue_T));
   if (!value) {
     return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
@@ -1200,13 +1500,7 @@ static SkJsonParserResultIMPL skParseJsonNumberIMPL(
   (*pValue) = value;
 
   // Consume the token
-  result = skNextJsonParserTokenIMPL(pParser);
-  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skFree(pParser->pAllocator, value);
-    return result;
-  }
-
-  return SK_JSON_PARSER_SUCCESS_IMPL;
+  return skNextJsonParserTokenIMPL(pParser);
 }
 
 static SkJsonParserResultIMPL skParseJsonStringIMPL(
@@ -1214,7 +1508,6 @@ static SkJsonParserResultIMPL skParseJsonStringIMPL(
   SkJsonValue*                          pValue
 ) {
   SkJsonValue value;
-  SkJsonParserResultIMPL result;
   SkJsonParserTokenIMPL* currToken;
 
   // Check that the proper token is found.
@@ -1224,41 +1517,23 @@ static SkJsonParserResultIMPL skParseJsonStringIMPL(
   }
 
   // Allocate the JSON value
-  value = skClearAllocate(
-    pParser->pAllocator,
-    sizeof(SkJsonValue_T),
-    1,
-    pParser->allocationScope
-  );
+  value = skClearAllocateJsonArenaIMPL(pParser, sizeof(SkJsonValue_T));
   if (!value) {
     return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
 
   // Allocate the string value
-  value->internal.string = skClearAllocate(
-    pParser->pAllocator,
-    currToken->stringLength + 1,
-    1,
-    pParser->allocationScope
-  );
+  value->internal.string = skCopyJsonArenaStringIMPL(pParser, currToken);
   if (!value->internal.string) {
-    skFree(pParser->pAllocator, value);
     return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
 
   // Assign the properties
   value->jType = SK_JSON_TYPE_STRING;
-  strcpy(value->internal.string, currToken->stringAttribute);
   (*pValue) = value;
 
   // Consume the token
-  result = skNextJsonParserTokenIMPL(pParser);
-  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    skFree(pParser->pAllocator, value);
-    return result;
-  }
-
-  return SK_JSON_PARSER_SUCCESS_IMPL;
+  return skNextJsonParserTokenIMPL(pParser);
 }
 
 static SkJsonParserResultIMPL skParseJsonLiteralIMPL(
@@ -1277,12 +1552,7 @@ static SkJsonParserResultIMPL skParseJsonLiteralIMPL(
   }
 
   // Allocate the JSON value
-  value = skClearAllocate(
-    pParser->pAllocator,
-    sizeof(SkJsonValue_T),
-    1,
-    pParser->allocationScope
-  );
+  value = skClearAllocateJsonArenaIMPL(pParser, sizeof(SkJsonValue_T));
   if (!value) {
     return SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL;
   }
@@ -1328,10 +1598,10 @@ static SkJsonParserResultIMPL skInitializeJsonParserIMPL(
   uint32_t idx;
   SkJsonParserResultIMPL result;
 
-  // Read in all of the characters possible
-  skInitializeJsonParserCharacter_SourceIMPL(pParser);
-  for (idx = 0; idx < SK_JSON_PARSER_PEEK_SIZE; ++idx) {
-    skNextJsonParserCharacterIMPL(pParser);
+  // Create the arena which will hold the parsed DOM
+  result = skCreateJsonArenaIMPL(pParser);
+  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
+    return result;
   }
 
   // Read in all of the tokens possible
@@ -1352,6 +1622,29 @@ static void skDeinitializeJsonParserIMPL(
   for (idx = 0; idx < SK_JSON_PARSER_TOKEN_SIZE; ++idx) {
     skFree(pParser->pAllocator, pParser->peekToken[idx].stringAttribute);
   }
+  skFree(pParser->pAllocator, pParser->propertyStack.pData);
+  skFree(pParser->pAllocator, pParser->valueStack.pData);
+  if (pParser->pArena) {
+    skDestroyJsonArenaIMPL(pParser->pAllocator, pParser->pArena);
+  }
+  skDeinitializeJsonParserInputIMPL(pParser);
+}
+
+static SkJsonParserResultIMPL skParseJsonRootObjectIMPL(
+  SkJsonParserIMPL*                     pParser,
+  SkJsonObject*                         pObject
+) {
+  SkJsonParserResultIMPL result;
+
+  // Parse the root object, and transfer ownership of the arena to it.
+  result = skParseJsonObjectIMPL(pParser, pObject);
+  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
+    return result;
+  }
+  (*pObject)->pArena = pParser->pArena;
+  pParser->pArena = NULL;
+
+  return SK_JSON_PARSER_SUCCESS_IMPL;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1371,17 +1664,17 @@ SkResult SKAPI_CALL skCreateJsonObjectFromString(
   memset(&jsonParser, 0, sizeof(SkJsonParserIMPL));
   jsonParser.pAllocator = pAllocator;
   jsonParser.allocationScope = allocationScope;
-  jsonParser.input.sourceType = SK_JSON_PARSER_SOURCE_TYPE_STRING_IMPL;
-  jsonParser.input.stringInput.pString = pString;
+  (void)skInitializeJsonParserInput_StringIMPL(&jsonParser, pString);
 
   // Initialize the parser
   result = skInitializeJsonParserIMPL(&jsonParser);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
+    skDeinitializeJsonParserIMPL(&jsonParser);
     return SK_ERROR_INVALID;
   }
 
   // Parse the JSON Object
-  result = skParseJsonObjectIMPL(&jsonParser, pObject);
+  result = skParseJsonRootObjectIMPL(&jsonParser, pObject);
   skDeinitializeJsonParserIMPL(&jsonParser);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
     return SK_ERROR_INVALID;
@@ -1401,7 +1694,7 @@ SkResult SKAPI_CALL skCreateJsonObjectFromFile(
   SkJsonParserResultIMPL result;
 
   // Check that the file exists
-  pFile = fopen(pFilepath, "r");
+  pFile = fopen(pFilepath, "rb");
   if (!pFile) {
     return SK_ERROR_DEVICE_LOST;
   }
@@ -1410,19 +1703,26 @@ SkResult SKAPI_CALL skCreateJsonObjectFromFile(
   memset(&jsonParser, 0, sizeof(SkJsonParserIMPL));
   jsonParser.pAllocator = pAllocator;
   jsonParser.allocationScope = allocationScope;
-  jsonParser.input.sourceType = SK_JSON_PARSER_SOURCE_TYPE_FILE_IMPL;
-  jsonParser.input.fileInput.pFile = pFile;
+
+  // Read the file contents (the file isn't needed after this point)
+  result = skInitializeJsonParserInput_FileIMPL(&jsonParser, pFile);
+  (void)fclose(pFile);
+  if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
+    skDeinitializeJsonParserIMPL(&jsonParser);
+    return (result == SK_JSON_PARSER_ERROR_OUT_OF_HOST_MEMORY_IMPL)
+      ? SK_ERROR_OUT_OF_HOST_MEMORY
+      : SK_ERROR_INVALID;
+  }
 
   // Initialize the parser
   result = skInitializeJsonParserIMPL(&jsonParser);
   if (result != SK_JSON_PARSER_SUCCESS_IMPL) {
-    (void)fclose(pFile);
+    skDeinitializeJsonParserIMPL(&jsonParser);
     return SK_ERROR_INVALID;
   }
 
   // Start parsing into the object
-  result = skParseJsonObjectIMPL(&jsonParser, pObject);
-  (void)fclose(pFile);
+  result = skParseJsonRootObjectIMPL(&jsonParser, pObject);
 
   // Return the OpenSK error codes
   skDeinitializeJsonParserIMPL(&jsonParser);
@@ -1437,15 +1737,10 @@ void SKAPI_CALL skDestroyJsonObject(
   SkAllocationCallbacks const*          pAllocator,
   SkJsonObject                          object
 ) {
-  uint32_t idx;
-  SkJsonPropertyIMPL* pProperty;
-  for (idx = 0; idx < object->properties.count; ++idx) {
-    pProperty = &object->properties.pData[idx];
-    skFree(pAllocator, pProperty->name);
-    skDestroyJsonValueIMPL(pAllocator, pProperty->value);
+  // Only the root object owns the arena, which holds the entire DOM.
+  if (object->pArena) {
+    skDestroyJsonArenaIMPL(pAllocator, object->pArena);
   }
-  skFree(pAllocator, object->properties.pData);
-  skFree(pAllocator, object);
 }
 
 SkJsonType SKAPI_CALL skGetJsonType(
@@ -40,7 +40,8 @@ typedef enum SkInternalResult {
   SKI_ERROR_MANIFEST_OVERFLOW = -8,
   SKI_ERROR_MANIFEST_UNSUPPORTED = -9,
   SKI_ERROR_MANIFEST_UNEXPECTED_TYPE = -10,
-  SKI_ERROR_MANIFEST_DUPLICATE = -11
+  SKI_ERROR_MANIFEST_DUPLICATE = -11,
+  SKI_ERROR_MANIFEST_CACHE_MISS = -12
 } SkInternalResult;
 
 extern SkBool32 SKAPI_CALL skIsIntegerBigEndian();
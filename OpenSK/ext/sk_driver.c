@@ -72,6 +72,10 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreateDriverFunctionTable(
   HANDLE_PROC(QueryEndpointFeatures);
   HANDLE_PROC(QueryEndpointProperties);
   HANDLE_PROC(RequestPcmStream);
+  HANDLE_PROC(RegisterDeviceChangeCallback);
+  HANDLE_PROC(EnumerateEndpointPcmFormats);
+  HANDLE_PROC(ConfigurePcmStreamPool);
+  HANDLE_PROC(GetDriverTopologyVersion);
 
   // Return success
   *ppFunctionTable = pFunctionTable;
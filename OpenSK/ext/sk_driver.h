@@ -31,6 +31,7 @@ extern "C" {
 
 typedef SkResult (SKAPI_PTR *PFN_skCreateDriver)(SkDriverCreateInfo const* pCreateInfo, SkAllocationCallbacks const* pAllocator, SkDriver* pDriver);
 typedef SkResult (SKAPI_PTR *PFN_skDestroyDriver)(SkAllocationCallbacks const* pAllocator, SkDriver driver);
+typedef uint32_t (SKAPI_PTR *PFN_skGetDriverTopologyVersion)(SkDriver driver);
 
 typedef struct SkDeviceCreateInfo {
   SK_INTERNAL_STRUCTURE_BASE;
@@ -59,6 +60,12 @@ typedef struct SkDriverFunctionTable {
   PFN_skQueryEndpointFeatures           pfnQueryEndpointFeatures;
   PFN_skQueryEndpointProperties         pfnQueryEndpointProperties;
   PFN_skRequestPcmStream                pfnRequestPcmStream;
+  PFN_skRegisterDeviceChangeCallback    pfnRegisterDeviceChangeCallback;
+  PFN_skEnumerateEndpointPcmFormats     pfnEnumerateEndpointPcmFormats;
+  PFN_skConfigurePcmStreamPool          pfnConfigurePcmStreamPool;
+  // Optional: Changes whenever the driver's devices or endpoints may have
+  // changed, this allows the loader to cache objects it has resolved.
+  PFN_skGetDriverTopologyVersion        pfnGetDriverTopologyVersion;
 } SkDriverFunctionTable;
 SK_DEFINE_HANDLE(SkDriverLayer);
 
@@ -19,6 +19,7 @@
 // OpenSK
 #include <OpenSK/dev/objects.h>
 #include <OpenSK/ext/sk_layer.h>
+#include <OpenSK/ext/sk_trace.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Helper Functions
@@ -132,6 +133,7 @@ SKAPI_ATTR SkResult SKAPI_CALL skInitializeInstanceLayerBase(
   SkInstance*                           pInstance
 ) {
   SkResult result;
+  uint64_t traceTime;
   PFN_skCreateInstance pfnCreateInstance;
   SkLayerCreateInfo const* pLayerCreateInfo;
   SkLayerCreateInfo const* pNextLayerCreateInfo;
@@ -167,11 +169,13 @@ SKAPI_ATTR SkResult SKAPI_CALL skInitializeInstanceLayerBase(
 
   // Call the next instance creation function, assess the results.
   // If this fails, we should always return the failure provided.
+  traceTime = skBeginStartupTraceEvent();
   result = pfnCreateInstance(
     pCreateInfo,
     pAllocator,
     pInstance
   );
+  skEndStartupTraceEvent(traceTime, "pfnCreateInstance", pNextLayerCreateInfo->properties.layerName);
   if (result != SK_SUCCESS) {
     return result;
   }
@@ -211,6 +215,7 @@ SKAPI_ATTR SkResult SKAPI_CALL skInitializeDriverLayerBase(
   SkDriver*                             pDriver
 ) {
   SkResult result;
+  uint64_t traceTime;
   PFN_skCreateDriver pfnCreateDriver;
   SkLayerCreateInfo const* pLayerCreateInfo;
   SkLayerCreateInfo const* pNextLayerCreateInfo;
@@ -246,11 +251,13 @@ SKAPI_ATTR SkResult SKAPI_CALL skInitializeDriverLayerBase(
 
   // Call the next instance creation function, assess the results.
   // If this fails, we should always return the failure provided.
+  traceTime = skBeginStartupTraceEvent();
   result = pfnCreateDriver(
     pCreateInfo,
     pAllocator,
     pDriver
   );
+  skEndStartupTraceEvent(traceTime, "skCreateDriver", pNextLayerCreateInfo->properties.layerName);
   if (result != SK_SUCCESS) {
     return result;
   }
@@ -24,7 +24,9 @@
 #include <OpenSK/dev/vector.h>
 #include <OpenSK/ext/sk_global.h>
 #include <OpenSK/ext/sk_loader.h>
+#include <OpenSK/ext/sk_trace.h>
 #include <OpenSK/man/manifest.h>
+#include <OpenSK/man/manifest_cache.h>
 #include <OpenSK/plt/platform.h>
 
 // C99
@@ -49,59 +51,151 @@ typedef struct SkLoader_T {
 
 static SkLoader_T skDefaultLoaderIMPL = { NULL };
 
+typedef struct SkManifestTaskIMPL {
+  SkAllocationCallbacks const*          pAllocator;
+  char const**                          ppManifests;
+  SkManifestMAN*                        pManifests;
+} SkManifestTaskIMPL;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Private Helper Functions
 ////////////////////////////////////////////////////////////////////////////////
 
 static SK_DEFINE_VECTOR_PUSH_METHOD_IMPL(ManifestVector, SkManifestMAN)
 
-static SkResult skProcessManifestFileIMPL(
+static void SKAPI_PTR skParseManifestFileIMPL(
+  void*                                 pUserData,
+  uint32_t                              taskIndex
+) {
+  uint64_t traceTime;
+  SkManifestTaskIMPL* pTask;
+  SkManifestCreateInfoMAN createInfo;
+
+  // Skip manifests which were already resolved from the manifest cache.
+  pTask = pUserData;
+  if (pTask->pManifests[taskIndex]) {
+    return;
+  }
+
+  // Attempt to parse the manifest file (failed manifests are left as NULL).
+  traceTime = skBeginStartupTraceEvent();
+  createInfo.pFilepath = pTask->ppManifests[taskIndex];
+  if (skCreateManifestMAN(&createInfo, pTask->pAllocator, &pTask->pManifests[taskIndex]) != SKI_SUCCESS) {
+    pTask->pManifests[taskIndex] = NULL;
+  }
+  skEndStartupTraceEvent(traceTime, "skCreateManifestMAN", createInfo.pFilepath);
+}
+
+static SkResult skProcessManifestFilesIMPL(
   SkLoader                              loader,
-  char const*                           pManifestFile
+  SkManifestCacheMAN                    cache,
+  uint32_t                              manifestCount,
+  char const**                          ppManifests
 ) {
+  uint32_t idx;
   SkResult result;
-  SkManifestMAN manifest;
-  SkInternalResult iresult;
-  SkManifestCreateInfoMAN createInfo;
+  uint64_t traceTime;
+  uint32_t parseCount;
+  SkManifestTaskIMPL task;
+  SkBool32* pIsCached;
 
-  // Attempt to parse the manifest file.
-  createInfo.pFilepath = pManifestFile;
-  iresult = skCreateManifestMAN(
-    &createInfo,
-    loader->pAllocator,
-    &manifest
-  );
-  if (iresult != SKI_SUCCESS) {
-    return SK_ERROR_INITIALIZATION_FAILED;
+  // Nothing to process, so nothing to do.
+  if (!manifestCount) {
+    return SK_SUCCESS;
   }
 
-  // Store the manifest in the loader
-  result = skPushManifestVectorIMPL(
+  // Allocate a result slot for every manifest file.
+  task.pAllocator = loader->pAllocator;
+  task.ppManifests = ppManifests;
+  task.pManifests = skClearAllocate(
     loader->pAllocator,
-    &loader->manifests,
-    &manifest
+    (sizeof(SkManifestMAN) + sizeof(SkBool32)) * manifestCount,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
   );
-  if (result != SK_SUCCESS) {
-    skDestroyManifestMAN(manifest, loader->pAllocator);
+  if (!task.pManifests) {
     return SK_ERROR_OUT_OF_HOST_MEMORY;
   }
+  pIsCached = (SkBool32*)&task.pManifests[manifestCount];
+
+  // Attempt to use previously-parsed manifests from the cache.
+  // Note: The cache is not thread-safe, but lookups are cheap (only a stat).
+  parseCount = manifestCount;
+  traceTime = skBeginStartupTraceEvent();
+  if (cache) {
+    for (idx = 0; idx < manifestCount; ++idx) {
+      if (skGetCachedManifestMAN(cache, ppManifests[idx], loader->pAllocator, &task.pManifests[idx]) == SKI_SUCCESS) {
+        pIsCached[idx] = SK_TRUE;
+        --parseCount;
+      }
+      else {
+        task.pManifests[idx] = NULL;
+      }
+    }
+    skEndStartupTraceEvent(traceTime, "skGetCachedManifestMAN", NULL);
+  }
 
-  return SK_SUCCESS;
+  // Otherwise, parse all of the remaining manifests in parallel.
+  // Note: Parsing dominates loader initialization (file IO, JSON, and loading
+  //       libraries), so this is bounded by the slowest file, not the sum.
+  //       Allocators set through skSetLoaderAllocator aren't required to be
+  //       thread-safe, so with one of those the manifests are parsed serially.
+  if (parseCount) {
+    traceTime = skBeginStartupTraceEvent();
+    skDispatchTasksPLT(
+      loader->pAllocator,
+      manifestCount,
+      (loader->pAllocator) ? 1 : SK_MAX_LOADER_THREADS_PLT,
+      &skParseManifestFileIMPL,
+      &task
+    );
+    skEndStartupTraceEvent(traceTime, "skDispatchTasksPLT", "manifests");
+  }
+
+  // Store the manifests in the loader (and update the cache).
+  // Note: This is done in manifest order so that results are deterministic.
+  result = SK_SUCCESS;
+  for (idx = 0; idx < manifestCount; ++idx) {
+    if (!task.pManifests[idx]) {
+      continue;
+    }
+    if (result == SK_SUCCESS) {
+      if (cache && !pIsCached[idx]) {
+        (void)skUpdateManifestCacheMAN(cache, ppManifests[idx], task.pManifests[idx]);
+      }
+      result = skPushManifestVectorIMPL(
+        loader->pAllocator,
+        &loader->manifests,
+        &task.pManifests[idx]
+      );
+      if (result == SK_SUCCESS) {
+        continue;
+      }
+    }
+    skDestroyManifestMAN(task.pManifests[idx], loader->pAllocator);
+  }
+  skFree(loader->pAllocator, task.pManifests);
+
+  return result;
 }
 
 static SkResult skInitializeLoader_InternalIMPL(
   SkLoader                              loader
 ) {
-  uint32_t idx;
   SkResult result;
+  uint64_t traceTime;
   uint32_t manifestCount;
+  char* pCachePath;
   char const** ppManifests;
+  SkManifestCacheMAN cache;
 
   // Initialize the platform
+  traceTime = skBeginStartupTraceEvent();
   result = skCreatePlatformPLT(
     loader->pAllocator,
     &loader->platform
   );
+  skEndStartupTraceEvent(traceTime, "skCreatePlatformPLT", NULL);
   if (result != SK_SUCCESS) {
     return result;
   }
@@ -141,26 +235,41 @@ static SkResult skInitializeLoader_InternalIMPL(
     return result;
   }
 
-  // Start processing all of the manifest files
-  for (idx = 0; idx < manifestCount; ++idx) {
-    result = skProcessManifestFileIMPL(
-      loader,
-      ppManifests[idx]
-    );
-    if (result != SK_SUCCESS) {
-      continue;
+  // Open the manifest cache (if caching is disabled or fails, parse directly).
+  cache = NULL;
+  pCachePath = skGetManifestCachePathPLT(loader->platform, loader->pAllocator);
+  if (pCachePath) {
+    if (skCreateManifestCacheMAN(pCachePath, loader->pAllocator, &cache) != SKI_SUCCESS) {
+      cache = NULL;
     }
+    skFree(loader->pAllocator, pCachePath);
   }
 
+  // Start processing all of the manifest files
+  result = skProcessManifestFilesIMPL(
+    loader,
+    cache,
+    manifestCount,
+    ppManifests
+  );
+
+  // Write back any manifests which were stale or missing from the cache.
+  if (cache) {
+    traceTime = skBeginStartupTraceEvent();
+    (void)skFlushManifestCacheMAN(cache);
+    skEndStartupTraceEvent(traceTime, "skFlushManifestCacheMAN", NULL);
+    skDestroyManifestCacheMAN(cache, loader->pAllocator);
+  }
   skFree(loader->pAllocator, ppManifests);
 
-  return SK_SUCCESS;
+  return result;
 }
 
 static SkResult skInitializeLoaderIMPL(
   SkLoader                              loader
 ) {
   SkResult result;
+  uint64_t traceTime;
 
   // Skip initialization if it already happened or is happening.
   if (loader->isInitialized || loader->isInitializing) {
@@ -171,7 +280,9 @@ static SkResult skInitializeLoaderIMPL(
   loader->isInitializing = SK_TRUE;
   loader->manifests.allocationScope = SK_SYSTEM_ALLOCATION_SCOPE_LOADER;
   loader->searchPaths.allocationScope = SK_SYSTEM_ALLOCATION_SCOPE_LOADER;
+  traceTime = skBeginStartupTraceEvent();
   result = skInitializeLoader_InternalIMPL(loader);
+  skEndStartupTraceEvent(traceTime, "skInitializeLoader", NULL);
   loader->isInitializing = SK_FALSE;
   if (result != SK_SUCCESS) {
     return result;
@@ -75,6 +75,16 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreatePcmStreamFunctionTable(
   HANDLE_PROC(WritePcmStreamNoninterleaved);
   HANDLE_PROC(ReadPcmStreamInterleaved);
   HANDLE_PROC(ReadPcmStreamNoninterleaved);
+  HANDLE_PROC(ProcessPcmStreamInterleaved);
+  HANDLE_PROC(WritePcmStreamv);
+  HANDLE_PROC(ReadPcmStreamv);
+  HANDLE_PROC(WritePcmStreamSilence);
+  HANDLE_PROC(GetPcmStreamStatistics);
+  HANDLE_PROC(AvailPcmStreamSamplesCached);
+  HANDLE_PROC(QueryPcmStreamStatus);
+  HANDLE_PROC(FlushPcmStream);
+  HANDLE_PROC(RewindPcmStream);
+  HANDLE_PROC(ForwardPcmStream);
 
   // Return success
   *ppFunctionTable = pFunctionTable;
@@ -151,3 +161,53 @@ SKAPI_ATTR void SKAPI_CALL skDeinitializePcmStreamBase(
     pAttachedObject = pAttachedObject->_pNext;
   }
 }
+
+SKAPI_ATTR int64_t SKAPI_CALL skWritePcmStreamvBase(
+  SkPcmStream                           stream,
+  PFN_skWritePcmStreamInterleaved       pfnWritePcmStreamInterleaved,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  uint32_t idx;
+  int64_t frames;
+  int64_t totalFrames;
+
+  // Stop at the first short write, the remaining spans would be out of order.
+  totalFrames = 0;
+  for (idx = 0; idx < spanCount; ++idx) {
+    frames = pfnWritePcmStreamInterleaved(stream, pSpans[idx].pBuffer, pSpans[idx].samples);
+    if (frames < 0) {
+      return (totalFrames) ? totalFrames : frames;
+    }
+    totalFrames += frames;
+    if (frames < pSpans[idx].samples) {
+      break;
+    }
+  }
+  return totalFrames;
+}
+
+SKAPI_ATTR int64_t SKAPI_CALL skReadPcmStreamvBase(
+  SkPcmStream                           stream,
+  PFN_skReadPcmStreamInterleaved        pfnReadPcmStreamInterleaved,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  uint32_t idx;
+  int64_t frames;
+  int64_t totalFrames;
+
+  // Stop at the first short read, the remaining spans would be out of order.
+  totalFrames = 0;
+  for (idx = 0; idx < spanCount; ++idx) {
+    frames = pfnReadPcmStreamInterleaved(stream, pSpans[idx].pBuffer, pSpans[idx].samples);
+    if (frames < 0) {
+      return (totalFrames) ? totalFrames : frames;
+    }
+    totalFrames += frames;
+    if (frames < pSpans[idx].samples) {
+      break;
+    }
+  }
+  return totalFrames;
+}
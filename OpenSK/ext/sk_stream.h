@@ -57,6 +57,16 @@ typedef struct SkPcmStreamFunctionTable {
   PFN_skWritePcmStreamNoninterleaved    pfnWritePcmStreamNoninterleaved;
   PFN_skReadPcmStreamInterleaved        pfnReadPcmStreamInterleaved;
   PFN_skReadPcmStreamNoninterleaved     pfnReadPcmStreamNoninterleaved;
+  PFN_skProcessPcmStreamInterleaved     pfnProcessPcmStreamInterleaved;
+  PFN_skWritePcmStreamv                 pfnWritePcmStreamv;
+  PFN_skReadPcmStreamv                  pfnReadPcmStreamv;
+  PFN_skWritePcmStreamSilence           pfnWritePcmStreamSilence;
+  PFN_skGetPcmStreamStatistics          pfnGetPcmStreamStatistics;
+  PFN_skAvailPcmStreamSamplesCached     pfnAvailPcmStreamSamplesCached;
+  PFN_skQueryPcmStreamStatus            pfnQueryPcmStreamStatus;
+  PFN_skFlushPcmStream                  pfnFlushPcmStream;
+  PFN_skRewindPcmStream                 pfnRewindPcmStream;
+  PFN_skForwardPcmStream                pfnForwardPcmStream;
 } SkPcmStreamFunctionTable;
 SK_DEFINE_HANDLE(SkPcmStreamLayer);
 
@@ -95,6 +105,22 @@ SKAPI_ATTR void SKAPI_CALL skDeinitializePcmStreamBase(
   SkAllocationCallbacks const*          pAllocator
 );
 
+// Writes each span on its own, for when skWritePcmStreamv isn't available.
+SKAPI_ATTR int64_t SKAPI_CALL skWritePcmStreamvBase(
+  SkPcmStream                           stream,
+  PFN_skWritePcmStreamInterleaved       pfnWritePcmStreamInterleaved,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+);
+
+// Reads each span on its own, for when skReadPcmStreamv isn't available.
+SKAPI_ATTR int64_t SKAPI_CALL skReadPcmStreamvBase(
+  SkPcmStream                           stream,
+  PFN_skReadPcmStreamInterleaved        pfnReadPcmStreamInterleaved,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+);
+
 #ifdef    __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,387 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * The startup trace records a timed breakdown of everything that happens when
+ * an instance is created (loader, manifests, libraries, layers, and drivers).
+ ******************************************************************************/
+
+// OpenSK
+#include <OpenSK/dev/string.h>
+#include <OpenSK/ext/sk_global.h>
+#include <OpenSK/ext/sk_trace.h>
+#include <OpenSK/plt/platform.h>
+
+// C99
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Types
+////////////////////////////////////////////////////////////////////////////////
+
+#define SK_MAX_STARTUP_TRACE_DEPTH_IMPL 32
+
+typedef struct SkStartupTraceIMPL {
+  SkAllocationCallbacks const*          pAllocator;
+  SkInstance                            instance;
+  SkStartupTraceFormat                  format;
+  char*                                 pOutputPath;
+  PFN_skStartupTraceCallback            pfnCallback;
+  void*                                 pUserData;
+  uint64_t                              startTime;
+  uint64_t                              threadId;
+  uint32_t volatile                     eventCount;
+  uint64_t                              threadIds[SK_MAX_STARTUP_TRACE_EVENTS];
+  SkStartupTraceEvent                   events[SK_MAX_STARTUP_TRACE_EVENTS];
+} SkStartupTraceIMPL;
+
+static SkStartupTraceIMPL* volatile skStartupTraceIMPL = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static int skCompareStartupTraceEventsIMPL(
+  void const*                           pLeft,
+  void const*                           pRight
+) {
+  SkStartupTraceEvent const* pLeftEvent;
+  SkStartupTraceEvent const* pRightEvent;
+  pLeftEvent = pLeft;
+  pRightEvent = pRight;
+
+  // Order by thread, then start time, then longest first (so parents lead).
+  if (pLeftEvent->threadIndex != pRightEvent->threadIndex) {
+    return (pLeftEvent->threadIndex < pRightEvent->threadIndex) ? -1 : 1;
+  }
+  if (pLeftEvent->startTime != pRightEvent->startTime) {
+    return (pLeftEvent->startTime < pRightEvent->startTime) ? -1 : 1;
+  }
+  if (pLeftEvent->duration != pRightEvent->duration) {
+    return (pLeftEvent->duration > pRightEvent->duration) ? -1 : 1;
+  }
+  return 0;
+}
+
+static void skAssignStartupTraceThreadsIMPL(
+  SkStartupTraceIMPL*                   pTrace,
+  uint32_t                              eventCount
+) {
+  uint32_t idx;
+  uint32_t prevIdx;
+  uint32_t threadCount;
+
+  // The thread which owns the trace is always thread 0, other threads are
+  // numbered in the order that their first event was recorded.
+  threadCount = 1;
+  for (idx = 0; idx < eventCount; ++idx) {
+    if (pTrace->threadIds[idx] == pTrace->threadId) {
+      pTrace->events[idx].threadIndex = 0;
+      continue;
+    }
+    for (prevIdx = 0; prevIdx < idx; ++prevIdx) {
+      if (pTrace->threadIds[prevIdx] == pTrace->threadIds[idx]) {
+        break;
+      }
+    }
+    if (prevIdx < idx) {
+      pTrace->events[idx].threadIndex = pTrace->events[prevIdx].threadIndex;
+    }
+    else {
+      pTrace->events[idx].threadIndex = threadCount++;
+    }
+  }
+}
+
+static void skWriteJsonStringIMPL(
+  FILE*                                 file,
+  char const*                           pString
+) {
+  fputc('"', file);
+  for (; *pString; ++pString) {
+    switch (*pString) {
+    case '"':
+      fputs("\\\"", file);
+      break;
+    case '\\':
+      fputs("\\\\", file);
+      break;
+    default:
+      if ((unsigned char)*pString < 0x20) {
+        fprintf(file, "\\u%04x", (unsigned)*pString);
+      }
+      else {
+        fputc(*pString, file);
+      }
+      break;
+    }
+  }
+  fputc('"', file);
+}
+
+static void skWriteStartupTraceReportIMPL(
+  FILE*                                 file,
+  SkStartupTraceEvent const*            pEvents,
+  uint32_t                              eventCount,
+  uint64_t                              totalTime
+) {
+  uint32_t idx;
+  uint32_t depth;
+  uint32_t threadIndex;
+  uint64_t endTimes[SK_MAX_STARTUP_TRACE_DEPTH_IMPL];
+
+  fprintf(
+    file,
+    "OpenSK startup trace: %u events over %.3f ms\n"
+    "  thread   start (ms)  duration (ms)  event\n",
+    eventCount,
+    totalTime / 1e6
+  );
+
+  // Nesting is inferred from events which contain one another on one thread.
+  depth = 0;
+  threadIndex = 0;
+  for (idx = 0; idx < eventCount; ++idx) {
+    if (pEvents[idx].threadIndex != threadIndex) {
+      threadIndex = pEvents[idx].threadIndex;
+      depth = 0;
+    }
+    while (depth && endTimes[depth - 1] <= pEvents[idx].startTime) {
+      --depth;
+    }
+    fprintf(
+      file,
+      "  %6u %12.3f %14.3f  %*s%s%s%s\n",
+      pEvents[idx].threadIndex,
+      pEvents[idx].startTime / 1e6,
+      pEvents[idx].duration / 1e6,
+      (int)(depth * 2), "",
+      pEvents[idx].name,
+      (*pEvents[idx].detail) ? " " : "",
+      pEvents[idx].detail
+    );
+    if (depth < SK_MAX_STARTUP_TRACE_DEPTH_IMPL) {
+      endTimes[depth++] = pEvents[idx].startTime + pEvents[idx].duration;
+    }
+  }
+}
+
+static void skWriteStartupTraceJsonIMPL(
+  FILE*                                 file,
+  SkStartupTraceEvent const*            pEvents,
+  uint32_t                              eventCount
+) {
+  uint32_t idx;
+
+  // Uses the Trace Event Format, so the results can be loaded into any of
+  // the common trace viewers (e.g. chrome://tracing) as well as parsed.
+  fputs("{\"traceEvents\":[", file);
+  for (idx = 0; idx < eventCount; ++idx) {
+    fputs((idx) ? ",\n{\"name\":" : "\n{\"name\":", file);
+    skWriteJsonStringIMPL(file, pEvents[idx].name);
+    fprintf(
+      file,
+      ",\"cat\":\"opensk\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"detail\":",
+      pEvents[idx].threadIndex,
+      pEvents[idx].startTime / 1e3,
+      pEvents[idx].duration / 1e3
+    );
+    skWriteJsonStringIMPL(file, pEvents[idx].detail);
+    fputs("}}", file);
+  }
+  fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+}
+
+static void skReportStartupTraceIMPL(
+  SkStartupTraceIMPL*                   pTrace
+) {
+  FILE* file;
+  uint32_t eventCount;
+  uint64_t totalTime;
+
+  // Finalize the events so that they can be reported.
+  totalTime = skGetMonotonicTimePLT() - pTrace->startTime;
+  eventCount = pTrace->eventCount;
+  if (eventCount > SK_MAX_STARTUP_TRACE_EVENTS) {
+    eventCount = SK_MAX_STARTUP_TRACE_EVENTS;
+  }
+  skAssignStartupTraceThreadsIMPL(pTrace, eventCount);
+  qsort(pTrace->events, eventCount, sizeof(SkStartupTraceEvent), &skCompareStartupTraceEventsIMPL);
+
+  // Notify the user (if they requested it).
+  if (pTrace->pfnCallback) {
+    pTrace->pfnCallback(pTrace->pUserData, eventCount, pTrace->events);
+  }
+
+  // Write out the trace in the requested format.
+  if (pTrace->format == SK_STARTUP_TRACE_FORMAT_NONE) {
+    return;
+  }
+  file = stderr;
+  if (pTrace->pOutputPath) {
+    file = fopen(pTrace->pOutputPath, "w");
+    if (!file) {
+      return;
+    }
+  }
+  switch (pTrace->format) {
+  case SK_STARTUP_TRACE_FORMAT_JSON:
+    skWriteStartupTraceJsonIMPL(file, pTrace->events, eventCount);
+    break;
+  default:
+    skWriteStartupTraceReportIMPL(file, pTrace->events, eventCount, totalTime);
+    if (pTrace->eventCount > SK_MAX_STARTUP_TRACE_EVENTS) {
+      fprintf(file, "  (%u events were dropped)\n", pTrace->eventCount - SK_MAX_STARTUP_TRACE_EVENTS);
+    }
+    break;
+  }
+  if (file != stderr) {
+    fclose(file);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+SKAPI_ATTR SkBool32 SKAPI_CALL skBeginStartupTrace(
+  SkInstanceCreateInfo const*           pCreateInfo,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  char const* pEnvironment;
+  SkStartupTraceIMPL* pTrace;
+  SkStartupTraceCreateInfo const* pTraceCreateInfo;
+
+  // Only one startup trace may be active at a time.
+  if (skStartupTraceIMPL) {
+    return SK_FALSE;
+  }
+
+  // Check whether or not the user requested a startup trace.
+  pEnvironment = getenv("SK_STARTUP_TRACE");
+  if (pEnvironment && !*pEnvironment) {
+    pEnvironment = NULL;
+  }
+  pTraceCreateInfo = pCreateInfo->pNext;
+  while (pTraceCreateInfo && pTraceCreateInfo->sType != SK_STRUCTURE_TYPE_STARTUP_TRACE_CREATE_INFO) {
+    pTraceCreateInfo = pTraceCreateInfo->pNext;
+  }
+  if (!pTraceCreateInfo && !pEnvironment) {
+    return SK_FALSE;
+  }
+
+  // Allocate the trace (this is fairly large, but only exists while tracing).
+  pTrace = skClearAllocate(
+    pAllocator,
+    sizeof(SkStartupTraceIMPL),
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
+  );
+  if (!pTrace) {
+    return SK_FALSE;
+  }
+  pTrace->pAllocator = pAllocator;
+
+  // The create info takes precedence over the environment.
+  if (pTraceCreateInfo) {
+    pTrace->format = pTraceCreateInfo->format;
+    pTrace->pfnCallback = pTraceCreateInfo->pfnCallback;
+    pTrace->pUserData = pTraceCreateInfo->pUserData;
+    if (pTraceCreateInfo->pOutputPath) {
+      pTrace->pOutputPath = skDuplicateCString(pTraceCreateInfo->pOutputPath, pAllocator);
+    }
+  }
+  else {
+    pTrace->format = SK_STARTUP_TRACE_FORMAT_REPORT;
+    if (strcmp(pEnvironment, "json") == 0) {
+      pTrace->format = SK_STARTUP_TRACE_FORMAT_JSON;
+    }
+    pEnvironment = getenv("SK_STARTUP_TRACE_FILE");
+    if (pEnvironment && *pEnvironment) {
+      pTrace->pOutputPath = skDuplicateCString(pEnvironment, pAllocator);
+    }
+  }
+
+  // Start the trace
+  pTrace->threadId = skGetCurrentThreadIdPLT();
+  pTrace->startTime = skGetMonotonicTimePLT();
+  skStartupTraceIMPL = pTrace;
+
+  return SK_TRUE;
+}
+
+SKAPI_ATTR void SKAPI_CALL skAttachStartupTrace(
+  SkInstance                            instance
+) {
+  if (skStartupTraceIMPL) {
+    skStartupTraceIMPL->instance = instance;
+  }
+}
+
+SKAPI_ATTR void SKAPI_CALL skEndStartupTrace(
+  SkInstance                            instance
+) {
+  SkStartupTraceIMPL* pTrace;
+
+  // Only the instance which owns the trace may end it.
+  pTrace = skStartupTraceIMPL;
+  if (!pTrace || pTrace->instance != instance) {
+    return;
+  }
+  skStartupTraceIMPL = NULL;
+
+  // Report the results and destroy the trace.
+  skReportStartupTraceIMPL(pTrace);
+  skFree(pTrace->pAllocator, pTrace->pOutputPath);
+  skFree(pTrace->pAllocator, pTrace);
+}
+
+SKAPI_ATTR uint64_t SKAPI_CALL skBeginStartupTraceEvent() {
+  return (skStartupTraceIMPL) ? skGetMonotonicTimePLT() : 0;
+}
+
+SKAPI_ATTR void SKAPI_CALL skEndStartupTraceEvent(
+  uint64_t                              beginTime,
+  char const*                           pName,
+  char const*                           pDetail
+) {
+  uint64_t endTime;
+  uint32_t eventIndex;
+  SkStartupTraceIMPL* pTrace;
+  SkStartupTraceEvent* pEvent;
+
+  // Ignore events which began before there was an active trace.
+  pTrace = skStartupTraceIMPL;
+  if (!pTrace || !beginTime || beginTime < pTrace->startTime) {
+    return;
+  }
+  endTime = skGetMonotonicTimePLT();
+
+  // Reserve a slot for the event, the event count continues past the maximum
+  // so that we know how many events were dropped.
+  eventIndex = skAtomicIncrementPLT(&pTrace->eventCount);
+  if (eventIndex >= SK_MAX_STARTUP_TRACE_EVENTS) {
+    return;
+  }
+  pEvent = &pTrace->events[eventIndex];
+  strncpy(pEvent->name, pName, SK_MAX_TRACE_NAME_SIZE - 1);
+  if (pDetail) {
+    strncpy(pEvent->detail, pDetail, SK_MAX_TRACE_DETAIL_SIZE - 1);
+  }
+  pEvent->startTime = beginTime - pTrace->startTime;
+  pEvent->duration = endTime - beginTime;
+  pTrace->threadIds[eventIndex] = skGetCurrentThreadIdPLT();
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * OpenSK extensibility header. (Will be present in final package.)
+ ******************************************************************************/
+
+#ifndef   OPENSK_EXT_TRACE_H
+#define   OPENSK_EXT_TRACE_H 1
+
+// OpenSK
+#include <OpenSK/opensk.h>
+
+#ifdef    __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+// Startup Trace Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+// The maximum number of events recorded, any further events are dropped.
+#define SK_MAX_STARTUP_TRACE_EVENTS 1024
+
+////////////////////////////////////////////////////////////////////////////////
+// Startup Trace Functions
+////////////////////////////////////////////////////////////////////////////////
+
+// Begins a startup trace if one was requested (either through a
+// SkStartupTraceCreateInfo structure, or the SK_STARTUP_TRACE environment
+// variable). Returns SK_TRUE if the caller now owns the startup trace.
+SKAPI_ATTR SkBool32 SKAPI_CALL skBeginStartupTrace(
+  SkInstanceCreateInfo const*           pCreateInfo,
+  SkAllocationCallbacks const*          pAllocator
+);
+
+// Associates the owned startup trace with the instance which was created.
+SKAPI_ATTR void SKAPI_CALL skAttachStartupTrace(
+  SkInstance                            instance
+);
+
+// Ends the startup trace (only if it is owned by the instance provided, or
+// if instance is SK_NULL_HANDLE), and reports the results.
+SKAPI_ATTR void SKAPI_CALL skEndStartupTrace(
+  SkInstance                            instance
+);
+
+// Returns a timestamp to pass to skEndStartupTraceEvent, or 0 if there is no
+// active startup trace. This is cheap enough to call unconditionally.
+SKAPI_ATTR uint64_t SKAPI_CALL skBeginStartupTraceEvent();
+
+// Records an event which started at beginTime (does nothing if beginTime is 0).
+// Note: This may be called from multiple threads at the same time.
+SKAPI_ATTR void SKAPI_CALL skEndStartupTraceEvent(
+  uint64_t                              beginTime,
+  char const*                           pName,
+  char const*                           pDetail
+);
+
+#ifdef    __cplusplus
+}
+#endif // __cplusplus
+
+#endif // OPENSK_EXT_TRACE_H
@@ -60,6 +60,7 @@ typedef struct SkAlsaHardwareParameters {
   snd_pcm_uframes_t                     bufferSize;
   unsigned int                          bufferTime;
   int                                   bufferTimeDir;
+  unsigned int                          noPeriodWakeup;
 } SkAlsaHardwareParameters;
 
 typedef struct SkAlsaSoftwareParameters {
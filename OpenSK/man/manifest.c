@@ -19,6 +19,9 @@
 #include <OpenSK/man/manifest.h>
 #include <OpenSK/man/manifest_1_0_0.h>
 
+// C99
+#include <string.h>
+
 SkInternalResult SKAPI_CALL skCreateManifestMAN(
   SkManifestCreateInfoMAN const*        pCreateInfo,
   SkAllocationCallbacks const*          pAllocator,
@@ -160,3 +163,144 @@ SkInternalResult SKAPI_CALL skInitializeManifestLayerCreateInfoMAN(
       return SKI_ERROR_MANIFEST_INVALID;
   }
 }
+
+SkInternalResult SKAPI_CALL skSerializeManifestMAN(
+  SkManifestMAN                         manifest,
+  SkManifestWriterMAN*                  pWriter
+) {
+  uint32_t manifestVersion;
+  SkInternalResult result;
+
+  // The manifest version always leads, so that we know how to deserialize.
+  manifestVersion = skGetManifestVersionMAN(manifest);
+  result = skWriteManifestDataMAN(pWriter, &manifestVersion, sizeof(uint32_t));
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+
+  switch (manifestVersion) {
+    case SK_MAKE_VERSION(1, 0, 0):
+      return skSerializeManifestMAN_1_0_0(manifest, pWriter);
+    default:
+      return SKI_ERROR_MANIFEST_INVALID;
+  }
+}
+
+SkInternalResult SKAPI_CALL skDeserializeManifestMAN(
+  SkManifestReaderMAN*                  pReader,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestMAN*                        pManifest
+) {
+  uint32_t manifestVersion;
+  SkInternalResult result;
+
+  // Read the manifest version to determine the proper deserializer
+  result = skReadManifestDataMAN(pReader, &manifestVersion, sizeof(uint32_t));
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+
+  switch (manifestVersion) {
+    case SK_MAKE_VERSION(1, 0, 0):
+      return skDeserializeManifestMAN_1_0_0(pReader, pAllocator, pManifest);
+    default:
+      return SKI_ERROR_MANIFEST_UNSUPPORTED;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Serialization Functions
+////////////////////////////////////////////////////////////////////////////////
+
+SkInternalResult SKAPI_CALL skWriteManifestDataMAN(
+  SkManifestWriterMAN*                  pWriter,
+  void const*                           pData,
+  size_t                                size
+) {
+  uint8_t* pNewData;
+  size_t newCapacity;
+
+  // Grow the writer's buffer (by 2) if the data doesn't fit.
+  if (pWriter->size + size > pWriter->capacity) {
+    newCapacity = (pWriter->capacity) ? pWriter->capacity : 256;
+    while (pWriter->size + size > newCapacity) {
+      newCapacity *= 2;
+    }
+    pNewData = skReallocate(
+      pWriter->pAllocator,
+      pWriter->pData,
+      newCapacity,
+      1,
+      pWriter->allocationScope
+    );
+    if (!pNewData) {
+      return SKI_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    pWriter->pData = pNewData;
+    pWriter->capacity = newCapacity;
+  }
+
+  if (size) {
+    memcpy(&pWriter->pData[pWriter->size], pData, size);
+    pWriter->size += size;
+  }
+  return SKI_SUCCESS;
+}
+
+SkInternalResult SKAPI_CALL skWriteManifestStringMAN(
+  SkManifestWriterMAN*                  pWriter,
+  char const*                           pString
+) {
+  uint32_t length;
+  SkInternalResult result;
+
+  // Strings are written with their null-terminator, zero-length means NULL.
+  length = (pString) ? (uint32_t)strlen(pString) + 1 : 0;
+  result = skWriteManifestDataMAN(pWriter, &length, sizeof(uint32_t));
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+  return skWriteManifestDataMAN(pWriter, pString, length);
+}
+
+SkInternalResult SKAPI_CALL skReadManifestDataMAN(
+  SkManifestReaderMAN*                  pReader,
+  void*                                 pData,
+  size_t                                size
+) {
+  if (pReader->size - pReader->offset < size) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+  memcpy(pData, &pReader->pData[pReader->offset], size);
+  pReader->offset += size;
+  return SKI_SUCCESS;
+}
+
+SkInternalResult SKAPI_CALL skReadManifestStringMAN(
+  SkManifestReaderMAN*                  pReader,
+  char const**                          ppString
+) {
+  uint32_t length;
+  SkInternalResult result;
+
+  // Read the length of the string (including the null-terminator).
+  result = skReadManifestDataMAN(pReader, &length, sizeof(uint32_t));
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+  if (!length) {
+    *ppString = NULL;
+    return SKI_SUCCESS;
+  }
+
+  // Make sure the string is actually terminated where we expect it to be.
+  // Note: The string is not copied, it points into the reader's data.
+  if (pReader->size - pReader->offset < length
+  ||  pReader->pData[pReader->offset + length - 1] != 0
+  ) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+  *ppString = (char const*)&pReader->pData[pReader->offset];
+  pReader->offset += length;
+  return SKI_SUCCESS;
+}
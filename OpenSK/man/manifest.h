@@ -49,6 +49,22 @@ typedef struct SkManifestPropertiesMAN {
   uint32_t                              definedDriverCount;
 } SkManifestPropertiesMAN;
 
+// Manifests can be serialized to a compact binary form, which is used by the
+// manifest cache. The format is native-endian and is not meant to be portable.
+typedef struct SkManifestWriterMAN {
+  SkAllocationCallbacks const*          pAllocator;
+  SkSystemAllocationScope               allocationScope;
+  size_t                                capacity;
+  size_t                                size;
+  uint8_t*                              pData;
+} SkManifestWriterMAN;
+
+typedef struct SkManifestReaderMAN {
+  uint8_t const*                        pData;
+  size_t                                size;
+  size_t                                offset;
+} SkManifestReaderMAN;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Manifest Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,4 +111,41 @@ extern SkInternalResult SKAPI_CALL skInitializeManifestLayerCreateInfoMAN(
   SkLayerCreateInfo*                    pCreateInfo
 );
 
+extern SkInternalResult SKAPI_CALL skSerializeManifestMAN(
+  SkManifestMAN                         manifest,
+  SkManifestWriterMAN*                  pWriter
+);
+
+extern SkInternalResult SKAPI_CALL skDeserializeManifestMAN(
+  SkManifestReaderMAN*                  pReader,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestMAN*                        pManifest
+);
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Serialization Functions
+////////////////////////////////////////////////////////////////////////////////
+
+extern SkInternalResult SKAPI_CALL skWriteManifestDataMAN(
+  SkManifestWriterMAN*                  pWriter,
+  void const*                           pData,
+  size_t                                size
+);
+
+extern SkInternalResult SKAPI_CALL skWriteManifestStringMAN(
+  SkManifestWriterMAN*                  pWriter,
+  char const*                           pString
+);
+
+extern SkInternalResult SKAPI_CALL skReadManifestDataMAN(
+  SkManifestReaderMAN*                  pReader,
+  void*                                 pData,
+  size_t                                size
+);
+
+extern SkInternalResult SKAPI_CALL skReadManifestStringMAN(
+  SkManifestReaderMAN*                  pReader,
+  char const**                          ppString
+);
+
 #endif // OPENSK_MAN_MANIFEST_H
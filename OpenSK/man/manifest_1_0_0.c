@@ -19,8 +19,10 @@
 
 // OpenSK
 #include <OpenSK/dev/json.h>
+#include <OpenSK/dev/string.h>
 #include <OpenSK/ext/sk_global.h>
 #include <OpenSK/ext/sk_loader.h>
+#include <OpenSK/ext/sk_trace.h>
 #include <OpenSK/man/manifest.h>
 #include <OpenSK/man/manifest_1_0_0.h>
 #include <OpenSK/plt/platform.h>
@@ -94,10 +96,13 @@ static SkInternalResult skProcessLibraryPropertyIMPL(
   if (skIsAbsolutePathPLT(pLibraryPath)) {
     pFullLibraryPath = skAllocate(
       pAllocator,
-      strlen(pLibraryPath),
+      strlen(pLibraryPath) + 1,
       1,
       SK_SYSTEM_ALLOCATION_SCOPE_LOADER
     );
+    if (pFullLibraryPath) {
+      strcpy(pFullLibraryPath, pLibraryPath);
+    }
   }
   else {
     pFullLibraryPath = skCombinePathsPLT(
@@ -325,6 +330,124 @@ static void skDestroyManifestLayerIMPL(
   skDestroyManifestFunctionMapIMPL(pLayer->pFunctionMap, pLayer->functionMapCount, pAllocator);
 }
 
+static SkInternalResult skSerializeFunctionMapIMPL(
+  SkManifestWriterMAN*                  pWriter,
+  char*                                 (*pFunctionMap)[2],
+  uint32_t                              functionMapCount
+) {
+  uint32_t idx;
+  SkInternalResult result;
+
+  result = skWriteManifestDataMAN(pWriter, &functionMapCount, sizeof(uint32_t));
+  for (idx = 0; idx < functionMapCount && result == SKI_SUCCESS; ++idx) {
+    result = skWriteManifestStringMAN(pWriter, pFunctionMap[idx][0]);
+    if (result == SKI_SUCCESS) {
+      result = skWriteManifestStringMAN(pWriter, pFunctionMap[idx][1]);
+    }
+  }
+
+  return result;
+}
+
+static SkInternalResult skDeserializeFunctionMapIMPL(
+  SkManifestReaderMAN*                  pReader,
+  SkAllocationCallbacks const*          pAllocator,
+  char*                                 (**pDestination)[2],
+  uint32_t*                             pFunctionCount
+) {
+  uint32_t idx;
+  size_t keySize;
+  size_t valueSize;
+  uint32_t functionCount;
+  char const* pFunctionKey;
+  char const* pFunctionValue;
+  char* pFunctionMapEntity;
+  char* (*pFunctionMap)[2];
+  SkInternalResult result;
+
+  // Read the function count, and make sure it's not obviously invalid.
+  result = skReadManifestDataMAN(pReader, &functionCount, sizeof(uint32_t));
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+  if (functionCount > (pReader->size - pReader->offset) / (sizeof(uint32_t) * 2)) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+
+  // Allocate the function map for the manifest
+  pFunctionMap = skClearAllocate(
+    pAllocator,
+    sizeof(char*[2]) * functionCount,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_LOADER
+  );
+  if (!pFunctionMap) {
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  // Read each of the key/value pairs (this mirrors skProcessFunctionMapIMPL).
+  for (idx = 0; idx < functionCount; ++idx) {
+    result = skReadManifestStringMAN(pReader, &pFunctionKey);
+    if (result == SKI_SUCCESS) {
+      result = skReadManifestStringMAN(pReader, &pFunctionValue);
+    }
+    if (result == SKI_SUCCESS && (!pFunctionKey || !pFunctionValue)) {
+      result = SKI_ERROR_MANIFEST_INVALID;
+    }
+    if (result != SKI_SUCCESS) {
+      skDestroyManifestFunctionMapIMPL(pFunctionMap, functionCount, pAllocator);
+      return result;
+    }
+
+    // Allocate space for referencing the key/value pair.
+    keySize = strlen(pFunctionKey);
+    valueSize = strlen(pFunctionValue);
+    pFunctionMapEntity = skAllocate(
+      pAllocator,
+      sizeof(char) * (keySize + valueSize + 2),
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_LOADER
+    );
+    if (!pFunctionMapEntity) {
+      skDestroyManifestFunctionMapIMPL(pFunctionMap, functionCount, pAllocator);
+      return SKI_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    pFunctionMap[idx][0] = pFunctionMapEntity;
+    pFunctionMap[idx][1] = &pFunctionMapEntity[keySize + 1];
+    strcpy(pFunctionMap[idx][0], pFunctionKey);
+    strcpy(pFunctionMap[idx][1], pFunctionValue);
+  }
+
+  *pDestination = pFunctionMap;
+  *pFunctionCount = functionCount;
+  return SKI_SUCCESS;
+}
+
+static SkInternalResult skDeserializeStringIMPL(
+  SkManifestReaderMAN*                  pReader,
+  SkAllocationCallbacks const*          pAllocator,
+  char**                                pDestination
+) {
+  char const* pString;
+  SkInternalResult result;
+
+  result = skReadManifestStringMAN(pReader, &pString);
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+
+  // Note: NULL strings are valid (optional properties).
+  *pDestination = NULL;
+  if (pString) {
+    *pDestination = skDuplicateCString(pString, pAllocator);
+    if (!*pDestination) {
+      return SKI_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+
+  return SKI_SUCCESS;
+}
+
 #define SK_CHECK(proc) do {  result = proc; if (result != SKI_SUCCESS) { skDestroyManifestDriverIMPL(&reg, pAllocator); return result; } } while (0)
 static SkInternalResult SKAPI_CALL skProcessManifestDriverIMPL(
   SkManifestMAN                         manifest,
@@ -609,6 +732,144 @@ void SKAPI_CALL skGetManifestPropertiesMAN_1_0_0(
   pProperties->definedDriverCount = manifest->definedDriverCount;
 }
 
+#define SK_CHECK(proc) do { result = proc; if (result != SKI_SUCCESS) { return result; } } while (0)
+SkInternalResult SKAPI_CALL skSerializeManifestMAN_1_0_0(
+  SkManifestMAN                         manifest,
+  SkManifestWriterMAN*                  pWriter
+) {
+  uint32_t idx;
+  SkInternalResult result;
+  SkManifestDriverIMPL* pDriver;
+  SkManifestLayerIMPL* pLayer;
+
+  // Write the manifest header information
+  SK_CHECK(skWriteManifestDataMAN(pWriter, &manifest->definedDriverCount, sizeof(uint32_t)));
+  SK_CHECK(skWriteManifestDataMAN(pWriter, &manifest->validDriverCount, sizeof(uint32_t)));
+  SK_CHECK(skWriteManifestDataMAN(pWriter, &manifest->definedLayerCount, sizeof(uint32_t)));
+  SK_CHECK(skWriteManifestDataMAN(pWriter, &manifest->validLayerCount, sizeof(uint32_t)));
+  SK_CHECK(skWriteManifestStringMAN(pWriter, manifest->pFilepath));
+
+  // Write all of the valid drivers
+  // Note: Library handles are never serialized, they're loaded on demand.
+  for (idx = 0; idx < manifest->validDriverCount; ++idx) {
+    pDriver = &manifest->pDriver[idx];
+    SK_CHECK(skWriteManifestDataMAN(pWriter, &pDriver->properties, sizeof(SkDriverProperties)));
+    SK_CHECK(skWriteManifestStringMAN(pWriter, pDriver->pEnableEnvironment));
+    SK_CHECK(skWriteManifestStringMAN(pWriter, pDriver->pDisableEnvironment));
+    SK_CHECK(skWriteManifestStringMAN(pWriter, pDriver->pLibraryPath));
+    SK_CHECK(skSerializeFunctionMapIMPL(pWriter, pDriver->pFunctionMap, pDriver->functionMapCount));
+  }
+
+  // Write all of the valid layers
+  for (idx = 0; idx < manifest->validLayerCount; ++idx) {
+    pLayer = &manifest->pLayers[idx];
+    SK_CHECK(skWriteManifestDataMAN(pWriter, &pLayer->properties, sizeof(SkLayerProperties)));
+    SK_CHECK(skWriteManifestStringMAN(pWriter, pLayer->pEnableEnvironment));
+    SK_CHECK(skWriteManifestStringMAN(pWriter, pLayer->pDisableEnvironment));
+    SK_CHECK(skWriteManifestStringMAN(pWriter, pLayer->pLibraryPath));
+    SK_CHECK(skSerializeFunctionMapIMPL(pWriter, pLayer->pFunctionMap, pLayer->functionMapCount));
+  }
+
+  return SKI_SUCCESS;
+}
+#undef SK_CHECK
+
+#define SK_CHECK(proc, reg, destroy) do { result = proc; if (result != SKI_SUCCESS) { destroy(&reg, pAllocator); skDestroyManifestMAN_1_0_0(manifest, pAllocator); return result; } } while (0)
+SkInternalResult SKAPI_CALL skDeserializeManifestMAN_1_0_0(
+  SkManifestReaderMAN*                  pReader,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestMAN*                        pManifest
+) {
+  uint32_t idx;
+  uint32_t driverCount;
+  uint32_t validDriverCount;
+  uint32_t layerCount;
+  uint32_t validLayerCount;
+  char const* pFilepath;
+  SkManifestMAN manifest;
+  SkInternalResult result;
+  SkManifestDriverIMPL driver;
+  SkManifestLayerIMPL layer;
+
+  // Read the manifest header information
+  result = skReadManifestDataMAN(pReader, &driverCount, sizeof(uint32_t));
+  if (result == SKI_SUCCESS) {
+    result = skReadManifestDataMAN(pReader, &validDriverCount, sizeof(uint32_t));
+  }
+  if (result == SKI_SUCCESS) {
+    result = skReadManifestDataMAN(pReader, &layerCount, sizeof(uint32_t));
+  }
+  if (result == SKI_SUCCESS) {
+    result = skReadManifestDataMAN(pReader, &validLayerCount, sizeof(uint32_t));
+  }
+  if (result == SKI_SUCCESS) {
+    result = skReadManifestStringMAN(pReader, &pFilepath);
+  }
+  if (result != SKI_SUCCESS) {
+    return result;
+  }
+
+  // Make sure that the counts are sane before allocating anything.
+  if (!pFilepath
+  ||  validDriverCount > driverCount
+  ||  validLayerCount > layerCount
+  ||  (driverCount + layerCount) > (pReader->size - pReader->offset)
+  ) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+
+  // Allocate the manifest object (this mirrors skCreateManifestMAN_1_0_0).
+  manifest = skClearAllocate(
+    pAllocator,
+    sizeof(SkManifestMAN_T) +
+    sizeof(SkManifestDriverIMPL) * driverCount +
+    sizeof(SkManifestLayerIMPL) * layerCount +
+    strlen(pFilepath) + 1,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_LOADER
+  );
+  if (!manifest) {
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  // Initialize the manifest object
+  manifest->manifestVersion = SK_MAKE_VERSION(1, 0, 0);
+  manifest->definedDriverCount = driverCount;
+  manifest->definedLayerCount = layerCount;
+  manifest->pDriver = (SkManifestDriverIMPL*)&manifest[1];
+  manifest->pLayers = (SkManifestLayerIMPL*)&manifest->pDriver[driverCount];
+  manifest->pFilepath = (char*)&manifest->pLayers[layerCount];
+  strcpy(manifest->pFilepath, pFilepath);
+
+  // Read all of the valid drivers
+  for (idx = 0; idx < validDriverCount; ++idx) {
+    memset(&driver, 0, sizeof(SkManifestDriverIMPL));
+    SK_CHECK(skReadManifestDataMAN(pReader, &driver.properties, sizeof(SkDriverProperties)), driver, skDestroyManifestDriverIMPL);
+    SK_CHECK(skDeserializeStringIMPL(pReader, pAllocator, &driver.pEnableEnvironment), driver, skDestroyManifestDriverIMPL);
+    SK_CHECK(skDeserializeStringIMPL(pReader, pAllocator, &driver.pDisableEnvironment), driver, skDestroyManifestDriverIMPL);
+    SK_CHECK(skDeserializeStringIMPL(pReader, pAllocator, &driver.pLibraryPath), driver, skDestroyManifestDriverIMPL);
+    SK_CHECK(skDeserializeFunctionMapIMPL(pReader, pAllocator, &driver.pFunctionMap, &driver.functionMapCount), driver, skDestroyManifestDriverIMPL);
+    manifest->pDriver[manifest->validDriverCount] = driver;
+    ++manifest->validDriverCount;
+  }
+
+  // Read all of the valid layers
+  for (idx = 0; idx < validLayerCount; ++idx) {
+    memset(&layer, 0, sizeof(SkManifestLayerIMPL));
+    SK_CHECK(skReadManifestDataMAN(pReader, &layer.properties, sizeof(SkLayerProperties)), layer, skDestroyManifestLayerIMPL);
+    SK_CHECK(skDeserializeStringIMPL(pReader, pAllocator, &layer.pEnableEnvironment), layer, skDestroyManifestLayerIMPL);
+    SK_CHECK(skDeserializeStringIMPL(pReader, pAllocator, &layer.pDisableEnvironment), layer, skDestroyManifestLayerIMPL);
+    SK_CHECK(skDeserializeStringIMPL(pReader, pAllocator, &layer.pLibraryPath), layer, skDestroyManifestLayerIMPL);
+    SK_CHECK(skDeserializeFunctionMapIMPL(pReader, pAllocator, &layer.pFunctionMap, &layer.functionMapCount), layer, skDestroyManifestLayerIMPL);
+    manifest->pLayers[manifest->validLayerCount] = layer;
+    ++manifest->validLayerCount;
+  }
+
+  *pManifest = manifest;
+  return SKI_SUCCESS;
+}
+#undef SK_CHECK
+
 SkInternalResult SKAPI_CALL skEnumerateManifestDriverPropertiesMAN_1_0_0(
   SkManifestMAN                         manifest,
   SkManifestEnumerateFlagsMAN           enumerateFlags,
@@ -720,6 +981,7 @@ SkInternalResult SKAPI_CALL skInitializeManifestDriverCreateInfoMAN_1_0_0(
   SkDriverCreateInfo*                   pCreateInfo
 ) {
   uint32_t idx;
+  uint64_t traceTime;
   SkInternalResult result;
   SkManifestDriverIMPL* pDriver;
   PFN_skGetDriverProcAddr pfnGetProcAddr;
@@ -739,10 +1001,12 @@ SkInternalResult SKAPI_CALL skInitializeManifestDriverCreateInfoMAN_1_0_0(
 
   // Otherwise, we should attempt to initialize the driver.
   if (!pDriver->library) {
+    traceTime = skBeginStartupTraceEvent();
     result = skLoadLibraryPLT(
       pDriver->pLibraryPath,
       &pDriver->library
     );
+    skEndStartupTraceEvent(traceTime, "skLoadLibraryPLT", pDriver->pLibraryPath);
     if (result != SKI_SUCCESS) {
       return result;
     }
@@ -779,6 +1043,7 @@ SkInternalResult SKAPI_CALL skInitializeManifestLayerCreateInfoMAN_1_0_0(
   SkLayerCreateInfo*                    pCreateInfo
 ) {
   uint32_t idx;
+  uint64_t traceTime;
   SkInternalResult result;
   SkManifestLayerIMPL* pLayer;
 
@@ -797,10 +1062,12 @@ SkInternalResult SKAPI_CALL skInitializeManifestLayerCreateInfoMAN_1_0_0(
 
   // Otherwise, we should attempt to initialize the driver.
   if (!pLayer->library) {
+    traceTime = skBeginStartupTraceEvent();
     result = skLoadLibraryPLT(
       pLayer->pLibraryPath,
       &pLayer->library
     );
+    skEndStartupTraceEvent(traceTime, "skLoadLibraryPLT", pLayer->pLibraryPath);
     if (result != SKI_SUCCESS) {
       return result;
     }
@@ -77,4 +77,15 @@ extern SkInternalResult SKAPI_CALL skInitializeManifestLayerCreateInfoMAN_1_0_0(
   SkLayerCreateInfo*                    pCreateInfo
 );
 
+extern SkInternalResult SKAPI_CALL skSerializeManifestMAN_1_0_0(
+  SkManifestMAN                         manifest,
+  SkManifestWriterMAN*                  pWriter
+);
+
+extern SkInternalResult SKAPI_CALL skDeserializeManifestMAN_1_0_0(
+  SkManifestReaderMAN*                  pReader,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestMAN*                        pManifest
+);
+
 #endif // OPENSK_MAN_MANIFEST_1_0_0_H
@@ -0,0 +1,550 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * A binary cache of parsed manifests, validated by path, mtime and size.
+ ******************************************************************************/
+
+// OpenSK
+#include <OpenSK/dev/string.h>
+#include <OpenSK/dev/vector.h>
+#include <OpenSK/ext/sk_global.h>
+#include <OpenSK/man/manifest_cache.h>
+#include <OpenSK/plt/platform.h>
+
+// C99
+#include <stdio.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Cache Defines
+////////////////////////////////////////////////////////////////////////////////
+
+#define SK_MANIFEST_CACHE_MAGIC_IMPL "SKMC"
+#define SK_MANIFEST_CACHE_VERSION_IMPL 1
+
+// The header is validated before any entries are read. Any mismatch (format
+// version, structure sizes, or checksum) will cause the cache to be rebuilt.
+typedef struct SkManifestCacheHeaderIMPL {
+  char                                  magic[4];
+  uint32_t                              cacheVersion;
+  uint32_t                              driverPropertiesSize;
+  uint32_t                              layerPropertiesSize;
+  uint32_t                              entryCount;
+  uint32_t                              reserved;
+  uint64_t                              payloadSize;
+  uint64_t                              payloadChecksum;
+} SkManifestCacheHeaderIMPL;
+
+typedef struct SkManifestCacheEntryIMPL {
+  char*                                 pFilepath;
+  SkFileStatusPLT                       status;
+  uint8_t*                              pData;
+  size_t                                dataSize;
+  SkBool32                              isReferenced;
+} SkManifestCacheEntryIMPL;
+
+SK_DEFINE_VECTOR_IMPL(ManifestCacheEntryVector, SkManifestCacheEntryIMPL);
+
+typedef struct SkManifestCacheMAN_T {
+  SkAllocationCallbacks const*          pAllocator;
+  char*                                 pCachePath;
+  SkBool32                              isDirty;
+  SkManifestCacheEntryVectorIMPL_T      entries;
+} SkManifestCacheMAN_T;
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Cache Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static SK_DEFINE_VECTOR_PUSH_METHOD_IMPL(ManifestCacheEntryVector, SkManifestCacheEntryIMPL)
+
+static uint64_t skCalculateChecksumIMPL(
+  uint8_t const*                        pData,
+  size_t                                size
+) {
+  size_t idx;
+  uint64_t hash;
+
+  // FNV-1a (64-bit)
+  hash = 0xcbf29ce484222325ULL;
+  for (idx = 0; idx < size; ++idx) {
+    hash ^= pData[idx];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+static void skInitializeCacheHeaderIMPL(
+  SkManifestCacheHeaderIMPL*            pHeader
+) {
+  memset(pHeader, 0, sizeof(SkManifestCacheHeaderIMPL));
+  memcpy(pHeader->magic, SK_MANIFEST_CACHE_MAGIC_IMPL, 4);
+  pHeader->cacheVersion = SK_MANIFEST_CACHE_VERSION_IMPL;
+  pHeader->driverPropertiesSize = sizeof(SkDriverProperties);
+  pHeader->layerPropertiesSize = sizeof(SkLayerProperties);
+}
+
+static SkManifestCacheEntryIMPL* skFindCacheEntryIMPL(
+  SkManifestCacheMAN                    cache,
+  char const*                           pFilepath
+) {
+  uint32_t idx;
+  for (idx = 0; idx < cache->entries.count; ++idx) {
+    if (strcmp(cache->entries.pData[idx].pFilepath, pFilepath) == 0) {
+      return &cache->entries.pData[idx];
+    }
+  }
+  return NULL;
+}
+
+static SkInternalResult skAddCacheEntryIMPL(
+  SkManifestCacheMAN                    cache,
+  char const*                           pFilepath,
+  SkFileStatusPLT const*                pStatus,
+  uint8_t const*                        pData,
+  size_t                                dataSize,
+  SkManifestCacheEntryIMPL**            ppEntry
+) {
+  SkResult result;
+  SkManifestCacheEntryIMPL entry;
+
+  // Construct the cache entry
+  memset(&entry, 0, sizeof(SkManifestCacheEntryIMPL));
+  entry.status = *pStatus;
+  entry.pFilepath = skDuplicateCString(pFilepath, cache->pAllocator);
+  if (!entry.pFilepath) {
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  if (dataSize) {
+    entry.pData = skAllocate(
+      cache->pAllocator,
+      dataSize,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_LOADER
+    );
+    if (!entry.pData) {
+      skFree(cache->pAllocator, entry.pFilepath);
+      return SKI_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    memcpy(entry.pData, pData, dataSize);
+    entry.dataSize = dataSize;
+  }
+
+  // Add the entry to the cache
+  result = skPushManifestCacheEntryVectorIMPL(
+    cache->pAllocator,
+    &cache->entries,
+    &entry
+  );
+  if (result != SK_SUCCESS) {
+    skFree(cache->pAllocator, entry.pData);
+    skFree(cache->pAllocator, entry.pFilepath);
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  if (ppEntry) {
+    *ppEntry = &cache->entries.pData[cache->entries.count - 1];
+  }
+  return SKI_SUCCESS;
+}
+
+static SkInternalResult skReadCacheEntriesIMPL(
+  SkManifestCacheMAN                    cache,
+  uint8_t const*                        pFileData,
+  size_t                                fileSize
+) {
+  uint32_t idx;
+  uint64_t dataSize;
+  char const* pFilepath;
+  SkFileStatusPLT status;
+  SkInternalResult result;
+  SkManifestReaderMAN reader;
+  SkManifestCacheHeaderIMPL header;
+  SkManifestCacheHeaderIMPL expectedHeader;
+
+  // Validate the cache header, the entire payload must be present.
+  skInitializeCacheHeaderIMPL(&expectedHeader);
+  if (fileSize < sizeof(SkManifestCacheHeaderIMPL)) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+  memcpy(&header, pFileData, sizeof(SkManifestCacheHeaderIMPL));
+  if (memcmp(header.magic, expectedHeader.magic, 4) != 0
+  ||  header.cacheVersion != expectedHeader.cacheVersion
+  ||  header.driverPropertiesSize != expectedHeader.driverPropertiesSize
+  ||  header.layerPropertiesSize != expectedHeader.layerPropertiesSize
+  ||  header.payloadSize != fileSize - sizeof(SkManifestCacheHeaderIMPL)
+  ) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+  reader.pData = &pFileData[sizeof(SkManifestCacheHeaderIMPL)];
+  reader.size = (size_t)header.payloadSize;
+  reader.offset = 0;
+  if (skCalculateChecksumIMPL(reader.pData, reader.size) != header.payloadChecksum) {
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+
+  // Read each of the cache entries (path, status, and serialized manifest).
+  for (idx = 0; idx < header.entryCount; ++idx) {
+    result = skReadManifestStringMAN(&reader, &pFilepath);
+    if (result == SKI_SUCCESS) {
+      result = skReadManifestDataMAN(&reader, &status, sizeof(SkFileStatusPLT));
+    }
+    if (result == SKI_SUCCESS) {
+      result = skReadManifestDataMAN(&reader, &dataSize, sizeof(uint64_t));
+    }
+    if (result == SKI_SUCCESS && (!pFilepath || dataSize > reader.size - reader.offset)) {
+      result = SKI_ERROR_MANIFEST_INVALID;
+    }
+    if (result != SKI_SUCCESS) {
+      return result;
+    }
+    result = skAddCacheEntryIMPL(
+      cache,
+      pFilepath,
+      &status,
+      &reader.pData[reader.offset],
+      (size_t)dataSize,
+      NULL
+    );
+    if (result != SKI_SUCCESS) {
+      return result;
+    }
+    reader.offset += (size_t)dataSize;
+  }
+
+  return SKI_SUCCESS;
+}
+
+static void skClearCacheEntriesIMPL(
+  SkManifestCacheMAN                    cache
+) {
+  uint32_t idx;
+  for (idx = 0; idx < cache->entries.count; ++idx) {
+    skFree(cache->pAllocator, cache->entries.pData[idx].pData);
+    skFree(cache->pAllocator, cache->entries.pData[idx].pFilepath);
+  }
+  cache->entries.count = 0;
+}
+
+static SkInternalResult skLoadCacheFileIMPL(
+  SkManifestCacheMAN                    cache
+) {
+  long fileSize;
+  FILE* pFile;
+  uint8_t* pFileData;
+  SkInternalResult result;
+
+  // Attempt to open the cache file (it's fine if it doesn't exist).
+  pFile = fopen(cache->pCachePath, "rb");
+  if (!pFile) {
+    return SKI_ERROR_FILE_NOT_FOUND;
+  }
+
+  // Read the entire file into memory.
+  if (fseek(pFile, 0, SEEK_END) != 0 || (fileSize = ftell(pFile)) <= 0 || fseek(pFile, 0, SEEK_SET) != 0) {
+    fclose(pFile);
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+  pFileData = skAllocate(
+    cache->pAllocator,
+    (size_t)fileSize,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!pFileData) {
+    fclose(pFile);
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  if (fread(pFileData, 1, (size_t)fileSize, pFile) != (size_t)fileSize) {
+    skFree(cache->pAllocator, pFileData);
+    fclose(pFile);
+    return SKI_ERROR_MANIFEST_INVALID;
+  }
+  fclose(pFile);
+
+  // Process the cache entries, if anything fails - the cache is discarded.
+  result = skReadCacheEntriesIMPL(cache, pFileData, (size_t)fileSize);
+  if (result != SKI_SUCCESS) {
+    skClearCacheEntriesIMPL(cache);
+  }
+  skFree(cache->pAllocator, pFileData);
+
+  return result;
+}
+
+static SkInternalResult skWriteCacheFileIMPL(
+  SkManifestCacheMAN                    cache,
+  uint8_t const*                        pPayload,
+  size_t                                payloadSize,
+  uint32_t                              entryCount
+) {
+  FILE* pFile;
+  char* pTempPath;
+  char* pDirectory;
+  SkBool32 writeSucceeded;
+  SkManifestCacheHeaderIMPL header;
+
+  // Make sure the cache directory exists (this is only best-effort).
+  pDirectory = skRemovePathStemPLT(cache->pAllocator, cache->pCachePath);
+  if (pDirectory) {
+    (void)skCreateDirectoryPLT(pDirectory);
+    skFree(cache->pAllocator, pDirectory);
+  }
+
+  // Write to a temporary file first, so that readers never see a partial cache.
+  // Note: Every writer gets its own file, since other processes may be
+  //       rebuilding the cache at the same time (the last rename wins).
+  pFile = skCreateTemporaryFilePLT(cache->pAllocator, cache->pCachePath, &pTempPath);
+  if (!pFile) {
+    return SKI_ERROR_FILE_NOT_FOUND;
+  }
+
+  // Write the header, followed by the payload.
+  skInitializeCacheHeaderIMPL(&header);
+  header.entryCount = entryCount;
+  header.payloadSize = payloadSize;
+  header.payloadChecksum = skCalculateChecksumIMPL(pPayload, payloadSize);
+  writeSucceeded = (fwrite(&header, sizeof(SkManifestCacheHeaderIMPL), 1, pFile) == 1);
+  if (writeSucceeded && payloadSize) {
+    writeSucceeded = (fwrite(pPayload, payloadSize, 1, pFile) == 1);
+  }
+  if (fclose(pFile) != 0) {
+    writeSucceeded = SK_FALSE;
+  }
+
+  // Replace the old cache with the new cache.
+  if (writeSucceeded) {
+#ifdef    _WIN32
+    (void)remove(cache->pCachePath);
+#endif // _WIN32
+    writeSucceeded = (rename(pTempPath, cache->pCachePath) == 0);
+  }
+  if (!writeSucceeded) {
+    (void)remove(pTempPath);
+  }
+  skFree(cache->pAllocator, pTempPath);
+
+  return (writeSucceeded) ? SKI_SUCCESS : SKI_ERROR_SYSTEM_INTERNAL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Cache Functions
+////////////////////////////////////////////////////////////////////////////////
+
+SkInternalResult SKAPI_CALL skCreateManifestCacheMAN(
+  char const*                           pCachePath,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestCacheMAN*                   pCache
+) {
+  SkManifestCacheMAN cache;
+  SkInternalResult result;
+
+  // Allocate the manifest cache object
+  cache = skClearAllocate(
+    pAllocator,
+    sizeof(SkManifestCacheMAN_T),
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_LOADER
+  );
+  if (!cache) {
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  cache->pAllocator = pAllocator;
+  cache->entries.allocationScope = SK_SYSTEM_ALLOCATION_SCOPE_LOADER;
+  cache->pCachePath = skDuplicateCString(pCachePath, pAllocator);
+  if (!cache->pCachePath) {
+    skFree(pAllocator, cache);
+    return SKI_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  // Load the existing cache file (if one exists). If the cache is invalid, we
+  // should start with an empty cache and mark it dirty so that it's rewritten.
+  result = skLoadCacheFileIMPL(cache);
+  if (result == SKI_ERROR_OUT_OF_HOST_MEMORY) {
+    skDestroyManifestCacheMAN(cache, pAllocator);
+    return result;
+  }
+  if (result != SKI_SUCCESS) {
+    cache->isDirty = SK_TRUE;
+  }
+
+  *pCache = cache;
+  return SKI_SUCCESS;
+}
+
+void SKAPI_CALL skDestroyManifestCacheMAN(
+  SkManifestCacheMAN                    cache,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  skClearCacheEntriesIMPL(cache);
+  skFree(pAllocator, cache->entries.pData);
+  skFree(pAllocator, cache->pCachePath);
+  skFree(pAllocator, cache);
+}
+
+SkInternalResult SKAPI_CALL skGetCachedManifestMAN(
+  SkManifestCacheMAN                    cache,
+  char const*                           pFilepath,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestMAN*                        pManifest
+) {
+  SkFileStatusPLT status;
+  SkInternalResult result;
+  SkManifestReaderMAN reader;
+  SkManifestCacheEntryIMPL* pEntry;
+
+  // Grab the current status of the manifest file.
+  if (!skGetFileStatusPLT(pFilepath, &status)) {
+    return SKI_ERROR_FILE_NOT_FOUND;
+  }
+
+  // Check that the cache entry exists, and that it's still valid.
+  // Note: The observed status is recorded before the manifest is parsed, so
+  //       a manifest which changes while parsing will not be cached as valid.
+  pEntry = skFindCacheEntryIMPL(cache, pFilepath);
+  if (!pEntry) {
+    cache->isDirty = SK_TRUE;
+    result = skAddCacheEntryIMPL(cache, pFilepath, &status, NULL, 0, NULL);
+    return (result == SKI_SUCCESS) ? SKI_ERROR_MANIFEST_CACHE_MISS : result;
+  }
+  if (!pEntry->pData
+  ||  pEntry->status.modifiedTime != status.modifiedTime
+  ||  pEntry->status.fileSize != status.fileSize
+  ) {
+    cache->isDirty = SK_TRUE;
+    skFree(cache->pAllocator, pEntry->pData);
+    pEntry->pData = NULL;
+    pEntry->dataSize = 0;
+    pEntry->status = status;
+    pEntry->isReferenced = SK_FALSE;
+    return SKI_ERROR_MANIFEST_CACHE_MISS;
+  }
+
+  // Deserialize the manifest from the cache entry.
+  reader.pData = pEntry->pData;
+  reader.size = pEntry->dataSize;
+  reader.offset = 0;
+  result = skDeserializeManifestMAN(&reader, pAllocator, pManifest);
+  if (result != SKI_SUCCESS) {
+    cache->isDirty = SK_TRUE;
+    skFree(cache->pAllocator, pEntry->pData);
+    pEntry->pData = NULL;
+    pEntry->dataSize = 0;
+    pEntry->isReferenced = SK_FALSE;
+    return (result == SKI_ERROR_OUT_OF_HOST_MEMORY) ? result : SKI_ERROR_MANIFEST_CACHE_MISS;
+  }
+
+  pEntry->isReferenced = SK_TRUE;
+  return SKI_SUCCESS;
+}
+
+SkInternalResult SKAPI_CALL skUpdateManifestCacheMAN(
+  SkManifestCacheMAN                    cache,
+  char const*                           pFilepath,
+  SkManifestMAN                         manifest
+) {
+  SkFileStatusPLT status;
+  SkInternalResult result;
+  SkManifestWriterMAN writer;
+  SkManifestCacheEntryIMPL* pEntry;
+
+  // Find (or create) the entry which will hold the manifest data.
+  pEntry = skFindCacheEntryIMPL(cache, pFilepath);
+  if (!pEntry) {
+    if (!skGetFileStatusPLT(pFilepath, &status)) {
+      return SKI_ERROR_FILE_NOT_FOUND;
+    }
+    result = skAddCacheEntryIMPL(cache, pFilepath, &status, NULL, 0, &pEntry);
+    if (result != SKI_SUCCESS) {
+      return result;
+    }
+  }
+
+  // Serialize the manifest into the cache entry.
+  memset(&writer, 0, sizeof(SkManifestWriterMAN));
+  writer.pAllocator = cache->pAllocator;
+  writer.allocationScope = SK_SYSTEM_ALLOCATION_SCOPE_LOADER;
+  result = skSerializeManifestMAN(manifest, &writer);
+  if (result != SKI_SUCCESS) {
+    skFree(cache->pAllocator, writer.pData);
+    return result;
+  }
+  skFree(cache->pAllocator, pEntry->pData);
+  pEntry->pData = writer.pData;
+  pEntry->dataSize = writer.size;
+  pEntry->isReferenced = SK_TRUE;
+  cache->isDirty = SK_TRUE;
+
+  return SKI_SUCCESS;
+}
+
+SkInternalResult SKAPI_CALL skFlushManifestCacheMAN(
+  SkManifestCacheMAN                    cache
+) {
+  uint32_t idx;
+  uint32_t entryCount;
+  uint64_t dataSize;
+  SkInternalResult result;
+  SkManifestWriterMAN writer;
+  SkManifestCacheEntryIMPL* pEntry;
+
+  // If any entries were not referenced, they should be pruned.
+  for (idx = 0; idx < cache->entries.count; ++idx) {
+    if (!cache->entries.pData[idx].isReferenced) {
+      cache->isDirty = SK_TRUE;
+      break;
+    }
+  }
+  if (!cache->isDirty) {
+    return SKI_SUCCESS;
+  }
+
+  // Serialize all of the referenced entries.
+  result = SKI_SUCCESS;
+  entryCount = 0;
+  memset(&writer, 0, sizeof(SkManifestWriterMAN));
+  writer.pAllocator = cache->pAllocator;
+  writer.allocationScope = SK_SYSTEM_ALLOCATION_SCOPE_COMMAND;
+  for (idx = 0; idx < cache->entries.count && result == SKI_SUCCESS; ++idx) {
+    pEntry = &cache->entries.pData[idx];
+    if (!pEntry->isReferenced || !pEntry->pData) {
+      continue;
+    }
+    dataSize = pEntry->dataSize;
+    result = skWriteManifestStringMAN(&writer, pEntry->pFilepath);
+    if (result == SKI_SUCCESS) {
+      result = skWriteManifestDataMAN(&writer, &pEntry->status, sizeof(SkFileStatusPLT));
+    }
+    if (result == SKI_SUCCESS) {
+      result = skWriteManifestDataMAN(&writer, &dataSize, sizeof(uint64_t));
+    }
+    if (result == SKI_SUCCESS) {
+      result = skWriteManifestDataMAN(&writer, pEntry->pData, pEntry->dataSize);
+    }
+    ++entryCount;
+  }
+
+  // Write the cache to disk
+  if (result == SKI_SUCCESS) {
+    result = skWriteCacheFileIMPL(cache, writer.pData, writer.size, entryCount);
+  }
+  skFree(cache->pAllocator, writer.pData);
+  if (result == SKI_SUCCESS) {
+    cache->isDirty = SK_FALSE;
+  }
+
+  return result;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * A binary cache of parsed manifests, validated by path, mtime and size.
+ ******************************************************************************/
+#ifndef   OPENSK_MAN_MANIFEST_CACHE_H
+#define   OPENSK_MAN_MANIFEST_CACHE_H 1
+
+#include <OpenSK/dev/utils.h>
+#include <OpenSK/man/manifest.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Cache Types
+////////////////////////////////////////////////////////////////////////////////
+
+SK_DEFINE_HANDLE(SkManifestCacheMAN);
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest Cache Functions
+////////////////////////////////////////////////////////////////////////////////
+
+// Note: A missing or corrupt cache file is not an error, the cache will
+//       simply start out empty and be rebuilt on skFlushManifestCacheMAN.
+extern SkInternalResult SKAPI_CALL skCreateManifestCacheMAN(
+  char const*                           pCachePath,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestCacheMAN*                   pCache
+);
+
+extern void SKAPI_CALL skDestroyManifestCacheMAN(
+  SkManifestCacheMAN                    cache,
+  SkAllocationCallbacks const*          pAllocator
+);
+
+// Returns SKI_ERROR_MANIFEST_CACHE_MISS if the manifest is not in the cache,
+// or if the manifest file has changed since the cache entry was created.
+extern SkInternalResult SKAPI_CALL skGetCachedManifestMAN(
+  SkManifestCacheMAN                    cache,
+  char const*                           pFilepath,
+  SkAllocationCallbacks const*          pAllocator,
+  SkManifestMAN*                        pManifest
+);
+
+extern SkInternalResult SKAPI_CALL skUpdateManifestCacheMAN(
+  SkManifestCacheMAN                    cache,
+  char const*                           pFilepath,
+  SkManifestMAN                         manifest
+);
+
+// Writes the cache back to disk (only if something changed). Entries which
+// were not requested or updated since the cache was created are dropped.
+extern SkInternalResult SKAPI_CALL skFlushManifestCacheMAN(
+  SkManifestCacheMAN                    cache
+);
+
+#endif // OPENSK_MAN_MANIFEST_CACHE_H
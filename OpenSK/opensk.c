@@ -24,6 +24,7 @@
 #include <OpenSK/ext/sk_layer.h>
 #include <OpenSK/ext/sk_loader.h>
 #include <OpenSK/ext/sk_stream.h>
+#include <OpenSK/ext/sk_trace.h>
 
 // C99
 #include <stdlib.h>
@@ -43,6 +44,23 @@
 #define skMidiStream(s) ((SkMidiStreamFunctionTable const*)((SkInternalObjectBase*)s)->_vtable)
 #define skVideoStream(s) ((SkVideoStreamFunctionTable const*)((SkInternalObjectBase*)s)->_vtable)
 
+// Every array within a topology arena starts on its own cache line.
+#define SK_TOPOLOGY_ALIGNMENT_IMPL 64
+
+// The most paths the instance will remember, any further paths aren't cached.
+#define SK_MAX_RESOLVED_PATHS_IMPL 256
+
+// Note: An entry is only valid while the driver's topology version matches,
+//       entries without a driver resolved to objects which never change.
+typedef struct SkResolvedPathIMPL {
+  uint32_t                              hash;
+  SkObject                              base;
+  char*                                 pPath;
+  SkObject                              object;
+  SkDriver                              driver;
+  uint32_t                              topologyVersion;
+} SkResolvedPathIMPL;
+
 typedef struct SkInstance_T {
   SK_INTERNAL_OBJECT_BASE;
   SkAllocationCallbacks const*          pAllocator;
@@ -51,6 +69,11 @@ typedef struct SkInstance_T {
   SkLayerCreateInfo*                    layers;
   uint32_t                              driverCount;
   SkLayerCreateInfo*                    pLayerCreateInfo;
+  SkDriverCreateInfo*                   pendingDrivers;
+  uint32_t                              pendingDriverCount;
+  SkResolvedPathIMPL*                   pResolvedPaths;
+  uint32_t                              resolvedPathCount;
+  uint32_t                              resolvedPathMask;
 } SkInstance_T;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -195,6 +218,148 @@ static void skConnectToCreateInfoIMPL(
   pTargetCreateInfo->pNext = pCreateInfo;
 }
 
+static PFN_skCreateDriver skGetCreateDriverFunctionIMPL(
+  void const*                           pLayerCreateInfos
+) {
+  SkLayerCreateInfo const* pLayerCreateInfo;
+
+  // Grab the first layer's driver creation function.
+  // In this case, we expect that there is at least one layer which can
+  // create a driver. In the base case, this is the default layer.
+  for (pLayerCreateInfo = pLayerCreateInfos; pLayerCreateInfo; pLayerCreateInfo = pLayerCreateInfo->pNext) {
+    if (pLayerCreateInfo->sType != SK_STRUCTURE_TYPE_LAYER_CREATE_INFO) {
+      continue;
+    }
+    if (!pLayerCreateInfo->pfnGetDriverProcAddr) {
+      continue;
+    }
+    return (PFN_skCreateDriver)pLayerCreateInfo->pfnGetDriverProcAddr(NULL, "skCreateDriver");
+  }
+
+  return NULL;
+}
+
+static SkResult skCreateInstanceDriverIMPL(
+  SkInstance                            instance,
+  PFN_skCreateDriver                    pfnCreateDriver,
+  void const*                           pLayerCreateInfos,
+  SkDriverCreateInfo const*             pDriverCreateInfo,
+  SkDriver*                             pDriver
+) {
+  SkResult result;
+  SkDriver driver;
+  uint64_t traceTime;
+  SkDriverCreateInfo driverCreateInfo;
+
+  // Make a copy of the driver creation info, so we don't break pNext chain.
+  driverCreateInfo = *pDriverCreateInfo;
+  driverCreateInfo.pNext = pLayerCreateInfos;
+
+  // Attempt to create the driver (does not check driver contents)
+  traceTime = skBeginStartupTraceEvent();
+  result = pfnCreateDriver(
+    &driverCreateInfo,
+    instance->pAllocator,
+    &driver
+  );
+  skEndStartupTraceEvent(traceTime, "skCreateDriver", driverCreateInfo.properties.driverName);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  ((SkInternalObjectBase*)driver)->_pParent = (SkInternalObjectBase*)instance;
+
+  instance->drivers[instance->driverCount] = driver;
+  ++instance->driverCount;
+  if (pDriver) {
+    *pDriver = driver;
+  }
+  return SK_SUCCESS;
+}
+
+static SkResult skRealizePendingDriverIMPL(
+  SkInstance                            instance,
+  uint32_t                              pendingIndex,
+  SkDriver*                             pDriver
+) {
+  uint32_t idx;
+  SkResult result;
+  uint32_t createInfoCount;
+  PFN_skCreateDriver pfnCreateDriver;
+  SkDriverCreateInfo* pDriverCreateInfos;
+  SkDriverCreateInfo pendingCreateInfo;
+
+  // Remove the driver from the pending list, regardless of the outcome.
+  // Note: This preserves the order of pending drivers.
+  pendingCreateInfo = instance->pendingDrivers[pendingIndex];
+  --instance->pendingDriverCount;
+  for (idx = pendingIndex; idx < instance->pendingDriverCount; ++idx) {
+    instance->pendingDrivers[idx] = instance->pendingDrivers[idx + 1];
+  }
+
+  // Load the driver library now that it's actually being used.
+  result = skInitializeDriverCreateInfo(
+    pendingCreateInfo.properties.driverName,
+    &createInfoCount,
+    NULL
+  );
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  if (!createInfoCount) {
+    return SK_ERROR_INITIALIZATION_FAILED;
+  }
+  pDriverCreateInfos = skAllocate(
+    instance->pAllocator,
+    sizeof(SkDriverCreateInfo) * createInfoCount,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!pDriverCreateInfos) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  result = skInitializeDriverCreateInfo(
+    pendingCreateInfo.properties.driverName,
+    &createInfoCount,
+    pDriverCreateInfos
+  );
+  if (result != SK_SUCCESS) {
+    skFree(instance->pAllocator, pDriverCreateInfos);
+    return result;
+  }
+
+  // Construct the driver through the instance's layers, the first manifest
+  // which provides a working driver is the one which is used.
+  result = SK_ERROR_INITIALIZATION_FAILED;
+  pfnCreateDriver = skGetCreateDriverFunctionIMPL(instance->layers);
+  if (pfnCreateDriver) {
+    for (idx = 0; idx < createInfoCount; ++idx) {
+      result = skCreateInstanceDriverIMPL(
+        instance,
+        pfnCreateDriver,
+        instance->layers,
+        &pDriverCreateInfos[idx],
+        pDriver
+      );
+      if (result == SK_SUCCESS) {
+        break;
+      }
+    }
+  }
+  skFree(instance->pAllocator, pDriverCreateInfos);
+
+  return result;
+}
+
+static void skRealizePendingDriversIMPL(
+  SkInstance                            instance
+) {
+  // Unlike layering, in this case if we fail to create a driver we will
+  // simply skip the driver - the same as when drivers are created eagerly.
+  while (instance->pendingDriverCount) {
+    (void)skRealizePendingDriverIMPL(instance, 0, NULL);
+  }
+}
+
 static char const* skGetPathDevice(char const* pPath, uint32_t* pDeviceId) {
   uint32_t physicalCard;
   uint32_t numberOfCharacters;
@@ -260,6 +425,165 @@ SkObject skResolveObjectIMPL(
   char const*                           pPath
 );
 
+static SkDriver skGetObjectDriverIMPL(
+  SkObject                              object
+) {
+  while (object && skGetObjectType(object) != SK_OBJECT_TYPE_DRIVER) {
+    object = ((SkInternalObjectBase*)object)->_pParent;
+  }
+  return object;
+}
+
+static uint32_t skHashResolvedPathIMPL(
+  SkObject                              base,
+  char const*                           pPath
+) {
+  size_t idx;
+  uint32_t hash;
+  uint8_t const* pBytes;
+
+  // FNV-1a (32-bit) over the base object and then the path.
+  hash = 2166136261u;
+  pBytes = (uint8_t const*)&base;
+  for (idx = 0; idx < sizeof(SkObject); ++idx) {
+    hash ^= pBytes[idx];
+    hash *= 16777619u;
+  }
+  while (*pPath) {
+    hash ^= (uint8_t)*pPath++;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+static SkResolvedPathIMPL* skGetResolvedPathIMPL(
+  SkInstance                            instance,
+  SkObject                              base,
+  char const*                           pPath,
+  uint32_t                              hash
+) {
+  uint32_t slot;
+  SkResolvedPathIMPL* pEntry;
+
+  if (!instance->pResolvedPaths) {
+    return NULL;
+  }
+  slot = hash & instance->resolvedPathMask;
+  while (instance->pResolvedPaths[slot].pPath) {
+    pEntry = &instance->pResolvedPaths[slot];
+    if (pEntry->hash == hash && pEntry->base == base && strcmp(pEntry->pPath, pPath) == 0) {
+      return pEntry;
+    }
+    slot = (slot + 1) & instance->resolvedPathMask;
+  }
+
+  return NULL;
+}
+
+static SkResolvedPathIMPL* skInsertResolvedPathIMPL(
+  SkInstance                            instance,
+  SkObject                              base,
+  char const*                           pPath,
+  uint32_t                              hash
+) {
+  uint32_t idx;
+  uint32_t slot;
+  uint32_t slotCount;
+  SkResolvedPathIMPL* pEntry;
+  SkResolvedPathIMPL* pEntries;
+
+  // The cache is best-effort, if it's full the path is simply resolved again.
+  if (instance->resolvedPathCount >= SK_MAX_RESOLVED_PATHS_IMPL) {
+    return NULL;
+  }
+
+  // Keep the table at most half-full, so that probing stays short.
+  slotCount = (instance->pResolvedPaths) ? instance->resolvedPathMask + 1 : 0;
+  if (2 * (instance->resolvedPathCount + 1) > slotCount) {
+    slotCount = (slotCount) ? slotCount * 2 : 16;
+    pEntries = skClearAllocate(
+      instance->pAllocator,
+      sizeof(SkResolvedPathIMPL) * slotCount,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
+    );
+    if (!pEntries) {
+      return NULL;
+    }
+    if (instance->pResolvedPaths) {
+      for (idx = 0; idx <= instance->resolvedPathMask; ++idx) {
+        if (!instance->pResolvedPaths[idx].pPath) {
+          continue;
+        }
+        slot = instance->pResolvedPaths[idx].hash & (slotCount - 1);
+        while (pEntries[slot].pPath) {
+          slot = (slot + 1) & (slotCount - 1);
+        }
+        pEntries[slot] = instance->pResolvedPaths[idx];
+      }
+    }
+    skFree(instance->pAllocator, instance->pResolvedPaths);
+    instance->pResolvedPaths = pEntries;
+    instance->resolvedPathMask = slotCount - 1;
+  }
+
+  // Find an empty slot and claim it.
+  slot = hash & instance->resolvedPathMask;
+  while (instance->pResolvedPaths[slot].pPath) {
+    slot = (slot + 1) & instance->resolvedPathMask;
+  }
+  pEntry = &instance->pResolvedPaths[slot];
+  pEntry->pPath = skAllocate(
+    instance->pAllocator,
+    strlen(pPath) + 1,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
+  );
+  if (!pEntry->pPath) {
+    return NULL;
+  }
+  strcpy(pEntry->pPath, pPath);
+  pEntry->hash = hash;
+  pEntry->base = base;
+  ++instance->resolvedPathCount;
+
+  return pEntry;
+}
+
+static void skUpdateResolvedPathIMPL(
+  SkResolvedPathIMPL*                   pEntry,
+  SkObject                              object
+) {
+  SkDriver driver;
+
+  // Remember which driver's topology the result depends on (if any).
+  // Note: If the driver can't report changes, the result is never reused.
+  driver = skGetObjectDriverIMPL(object);
+  pEntry->object = object;
+  pEntry->driver = driver;
+  pEntry->topologyVersion = 0;
+  if (driver) {
+    if (!skDriver(driver)->pfnGetDriverTopologyVersion) {
+      pEntry->object = SK_NULL_HANDLE;
+      return;
+    }
+    pEntry->topologyVersion = skDriver(driver)->pfnGetDriverTopologyVersion(driver);
+  }
+}
+
+static SkBool32 skIsResolvedPathValidIMPL(
+  SkResolvedPathIMPL const*             pEntry
+) {
+  if (!pEntry->object) {
+    return SK_FALSE;
+  }
+  if (!pEntry->driver) {
+    return SK_TRUE;
+  }
+  return skDriver(pEntry->driver)->pfnGetDriverTopologyVersion(pEntry->driver) == pEntry->topologyVersion;
+}
+
 static SkObject skResolveStreamObjectIMPL(
   SkAllocationCallbacks const*          pAllocator,
   SkObject                              stream,
@@ -764,6 +1088,16 @@ static SkObject SKAPI_CALL skResolveInstanceObjectIMPL(
       break;
     }
   }
+
+  // If the driver hasn't been created yet, it may still be pending creation.
+  if (!driver) {
+    for (idx = 0; idx < instance->pendingDriverCount; ++idx) {
+      if (strncmp(pPath, instance->pendingDrivers[idx].properties.identifier, driverIdentifierLength) == 0) {
+        (void)skRealizePendingDriverIMPL(instance, idx, &driver);
+        break;
+      }
+    }
+  }
   if (!driver) {
     return SK_NULL_HANDLE;
   }
@@ -842,6 +1176,269 @@ SkObject skResolveObjectIMPL(
   return NULL;
 }
 
+static void* skCarveTopologyArenaIMPL(
+  uint8_t*                              pArena,
+  size_t*                               pOffset,
+  size_t                                size
+) {
+  void* pArray;
+
+  *pOffset = (*pOffset + SK_TOPOLOGY_ALIGNMENT_IMPL - 1) & ~(size_t)(SK_TOPOLOGY_ALIGNMENT_IMPL - 1);
+  pArray = (pArena) ? &pArena[*pOffset] : NULL;
+  *pOffset += size;
+
+  return pArray;
+}
+
+static size_t skLayoutTopologyArenaIMPL(
+  uint8_t*                              pArena,
+  uint32_t                              driverCount,
+  uint32_t                              deviceCount,
+  uint32_t                              endpointCount,
+  SkInstanceTopology*                   pTopology
+) {
+  size_t offset;
+
+  // Note: When pArena is NULL, this only calculates the size of the arena.
+  offset = 0;
+#define CARVE_ARRAY(member, count) \
+  pTopology->member = skCarveTopologyArenaIMPL(pArena, &offset, sizeof(*pTopology->member) * (count))
+  CARVE_ARRAY(pDrivers, driverCount);
+  CARVE_ARRAY(pDriverProperties, driverCount);
+  CARVE_ARRAY(pDriverFeatures, driverCount);
+  CARVE_ARRAY(pDriverFirstDevices, driverCount);
+  CARVE_ARRAY(pDriverDeviceCounts, driverCount);
+  CARVE_ARRAY(pDriverFirstEndpoints, driverCount);
+  CARVE_ARRAY(pDriverEndpointCounts, driverCount);
+  CARVE_ARRAY(pDevices, deviceCount);
+  CARVE_ARRAY(pDeviceProperties, deviceCount);
+  CARVE_ARRAY(pDeviceFeatures, deviceCount);
+  CARVE_ARRAY(pDeviceDriverIndices, deviceCount);
+  CARVE_ARRAY(pDeviceFirstEndpoints, deviceCount);
+  CARVE_ARRAY(pDeviceEndpointCounts, deviceCount);
+  CARVE_ARRAY(pEndpoints, endpointCount);
+  CARVE_ARRAY(pEndpointProperties, endpointCount);
+  CARVE_ARRAY(pEndpointFeatures, endpointCount);
+  CARVE_ARRAY(pEndpointDriverIndices, endpointCount);
+  CARVE_ARRAY(pEndpointDeviceIndices, endpointCount);
+#undef CARVE_ARRAY
+
+  return offset;
+}
+
+static SkResult skCountTopologyIMPL(
+  SkInstance                            instance,
+  uint32_t*                             pDriverCount,
+  uint32_t*                             pDeviceCount,
+  uint32_t*                             pEndpointCount
+) {
+  uint32_t idx;
+  uint32_t ddx;
+  uint32_t count;
+  SkResult result;
+  SkObject* pObjects;
+  SkObject* pNewObjects;
+  uint32_t objectCapacity;
+  uint32_t driverCount;
+  uint32_t deviceCount;
+
+  // Devices have to be enumerated to count their endpoints, so the drivers
+  // and the current driver's devices share a single scratch array.
+  *pDeviceCount = 0;
+  *pEndpointCount = 0;
+  result = skEnumerateInstanceDrivers(instance, &driverCount, NULL);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  objectCapacity = driverCount + 8;
+  pObjects = skAllocate(
+    instance->pAllocator,
+    sizeof(SkObject) * objectCapacity,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!pObjects) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  result = skEnumerateInstanceDrivers(instance, &driverCount, (SkDriver*)pObjects);
+  if (result < SK_SUCCESS) {
+    skFree(instance->pAllocator, pObjects);
+    return result;
+  }
+
+  // Note: If anything grows during the count, the fill will catch it.
+  for (idx = 0; idx < driverCount; ++idx) {
+    result = skEnumerateDriverEndpoints(pObjects[idx], &count, NULL);
+    if (result != SK_SUCCESS) {
+      break;
+    }
+    *pEndpointCount += count;
+    result = skEnumerateDriverDevices(pObjects[idx], &deviceCount, NULL);
+    if (result != SK_SUCCESS) {
+      break;
+    }
+    if (driverCount + deviceCount > objectCapacity) {
+      objectCapacity = driverCount + deviceCount;
+      pNewObjects = skReallocate(
+        instance->pAllocator,
+        pObjects,
+        sizeof(SkObject) * objectCapacity,
+        1,
+        SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+      );
+      if (!pNewObjects) {
+        result = SK_ERROR_OUT_OF_HOST_MEMORY;
+        break;
+      }
+      pObjects = pNewObjects;
+    }
+    result = skEnumerateDriverDevices(pObjects[idx], &deviceCount, (SkDevice*)&pObjects[driverCount]);
+    if (result < SK_SUCCESS) {
+      break;
+    }
+    *pDeviceCount += deviceCount;
+    for (ddx = 0; ddx < deviceCount; ++ddx) {
+      result = skEnumerateDeviceEndpoints(pObjects[driverCount + ddx], &count, NULL);
+      if (result != SK_SUCCESS) {
+        break;
+      }
+      *pEndpointCount += count;
+    }
+    if (result != SK_SUCCESS) {
+      break;
+    }
+  }
+
+  skFree(instance->pAllocator, pObjects);
+  *pDriverCount = driverCount;
+  return (result < SK_SUCCESS) ? result : SK_SUCCESS;
+}
+
+static SkResult skFillTopologyEndpointsIMPL(
+  SkObject                              parent,
+  uint32_t                              driverIndex,
+  uint32_t                              deviceIndex,
+  uint32_t                              endpointCapacity,
+  SkInstanceTopology*                   pTopology,
+  uint32_t*                             pFirstEndpoint,
+  uint32_t*                             pEndpointCount
+) {
+  uint32_t idx;
+  uint32_t count;
+  SkResult result;
+  SkEndpoint* pEndpoints;
+
+  // Enumerate straight into the arena, after the endpoints already filled.
+  pEndpoints = &pTopology->pEndpoints[pTopology->endpointCount];
+  count = endpointCapacity - pTopology->endpointCount;
+  if (skGetObjectType(parent) == SK_OBJECT_TYPE_DRIVER) {
+    result = skEnumerateDriverEndpoints(parent, &count, pEndpoints);
+  }
+  else {
+    result = skEnumerateDeviceEndpoints(parent, &count, pEndpoints);
+  }
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+
+  // Query the information for each of the new endpoints.
+  *pFirstEndpoint = pTopology->endpointCount;
+  *pEndpointCount = count;
+  for (idx = pTopology->endpointCount; idx < pTopology->endpointCount + count; ++idx) {
+    pTopology->pEndpointDriverIndices[idx] = driverIndex;
+    pTopology->pEndpointDeviceIndices[idx] = deviceIndex;
+    if (skQueryEndpointProperties(pTopology->pEndpoints[idx], &pTopology->pEndpointProperties[idx]) != SK_SUCCESS) {
+      memset(&pTopology->pEndpointProperties[idx], 0, sizeof(SkEndpointProperties));
+    }
+    if (skQueryEndpointFeatures(pTopology->pEndpoints[idx], &pTopology->pEndpointFeatures[idx]) != SK_SUCCESS) {
+      memset(&pTopology->pEndpointFeatures[idx], 0, sizeof(SkEndpointFeatures));
+    }
+  }
+  pTopology->endpointCount += count;
+
+  return SK_SUCCESS;
+}
+
+static SkResult skFillTopologyIMPL(
+  SkInstance                            instance,
+  uint32_t                              driverCapacity,
+  uint32_t                              deviceCapacity,
+  uint32_t                              endpointCapacity,
+  SkInstanceTopology*                   pTopology
+) {
+  uint32_t idx;
+  uint32_t ddx;
+  uint32_t count;
+  SkResult result;
+  SkDriver driver;
+  SkDevice device;
+
+  // Every enumeration is made straight into the arena, if any of them come
+  // back incomplete the topology has grown since it was counted.
+  count = driverCapacity;
+  result = skEnumerateInstanceDrivers(instance, &count, pTopology->pDrivers);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  pTopology->driverCount = count;
+  pTopology->deviceCount = 0;
+  pTopology->endpointCount = 0;
+
+  for (idx = 0; idx < pTopology->driverCount; ++idx) {
+    driver = pTopology->pDrivers[idx];
+    skGetDriverProperties(driver, &pTopology->pDriverProperties[idx]);
+    skGetDriverFeatures(driver, &pTopology->pDriverFeatures[idx]);
+
+    // Endpoints which belong to the driver itself.
+    result = skFillTopologyEndpointsIMPL(
+      driver,
+      idx,
+      SK_TOPOLOGY_INDEX_NONE,
+      endpointCapacity,
+      pTopology,
+      &pTopology->pDriverFirstEndpoints[idx],
+      &pTopology->pDriverEndpointCounts[idx]
+    );
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+
+    // Devices, and the endpoints which belong to them.
+    count = deviceCapacity - pTopology->deviceCount;
+    result = skEnumerateDriverDevices(driver, &count, &pTopology->pDevices[pTopology->deviceCount]);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+    pTopology->pDriverFirstDevices[idx] = pTopology->deviceCount;
+    pTopology->pDriverDeviceCounts[idx] = count;
+    for (ddx = pTopology->deviceCount; ddx < pTopology->deviceCount + count; ++ddx) {
+      device = pTopology->pDevices[ddx];
+      pTopology->pDeviceDriverIndices[ddx] = idx;
+      if (skQueryDeviceProperties(device, &pTopology->pDeviceProperties[ddx]) != SK_SUCCESS) {
+        memset(&pTopology->pDeviceProperties[ddx], 0, sizeof(SkDeviceProperties));
+      }
+      if (skQueryDeviceFeatures(device, &pTopology->pDeviceFeatures[ddx]) != SK_SUCCESS) {
+        memset(&pTopology->pDeviceFeatures[ddx], 0, sizeof(SkDeviceFeatures));
+      }
+      result = skFillTopologyEndpointsIMPL(
+        device,
+        idx,
+        ddx,
+        endpointCapacity,
+        pTopology,
+        &pTopology->pDeviceFirstEndpoints[ddx],
+        &pTopology->pDeviceEndpointCounts[ddx]
+      );
+      if (result != SK_SUCCESS) {
+        return result;
+      }
+    }
+    pTopology->deviceCount += count;
+  }
+
+  return SK_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Internal Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -858,14 +1455,11 @@ static SkResult SKAPI_CALL skCreateInstance_internal(
 ) {
   uint32_t idx;
   SkResult result;
-  SkDriver driver;
   SkInstance instance;
   uint32_t layerCount;
   SkResult finalResult;
   uint32_t driverCount;
   PFN_skCreateDriver pfnCreateDriver;
-  SkDriverCreateInfo driverCreateInfo;
-  SkLayerCreateInfo const* pLayerCreateInfo;
   SkDriverCreateInfo const* pDriverCreateInfo;
 
   // Find out the number of drivers to create
@@ -893,7 +1487,8 @@ static SkResult SKAPI_CALL skCreateInstance_internal(
     pAllocator,
     sizeof(SkInstance_T) +
     sizeof(SkDriver) * driverCount +
-    sizeof(SkLayerCreateInfo) * layerCount,
+    sizeof(SkLayerCreateInfo) * layerCount +
+    sizeof(SkDriverCreateInfo) * driverCount,
     1,
     SK_SYSTEM_ALLOCATION_SCOPE_INSTANCE
   );
@@ -908,6 +1503,7 @@ static SkResult SKAPI_CALL skCreateInstance_internal(
   instance->pAllocator = pAllocator;
   instance->drivers = (SkDriver*)&instance[1];
   instance->layers = (SkLayerCreateInfo*)&instance->drivers[driverCount];
+  instance->pendingDrivers = (SkDriverCreateInfo*)&instance->layers[layerCount];
 
   // Copy the layer create info, and re-connect all of the pNext pointers.
   // Note: The -1 on layerCount is okay because there is always at least one.
@@ -939,6 +1535,13 @@ static SkResult SKAPI_CALL skCreateInstance_internal(
   }
   instance->instanceLayer._vtable = instance->_vtable;
 
+  // Grab the first layer's driver creation function.
+  pfnCreateDriver = skGetCreateDriverFunctionIMPL(pCreateInfo->pNext);
+  if (!pfnCreateDriver && driverCount) {
+    skDestroyInstance(instance, pAllocator);
+    return SK_ERROR_INITIALIZATION_FAILED;
+  }
+
   // Create all of the requested drivers
   finalResult = SK_SUCCESS;
   for (pDriverCreateInfo = pCreateInfo->pNext; pDriverCreateInfo; pDriverCreateInfo = pDriverCreateInfo->pNext) {
@@ -946,47 +1549,30 @@ static SkResult SKAPI_CALL skCreateInstance_internal(
       continue;
     }
 
-    // Make a copy of the driver creation info, so we don't break pNext chain.
-    driverCreateInfo = *pDriverCreateInfo;
-    driverCreateInfo.pNext = pCreateInfo->pNext;
-
-    // Grab the first layer's driver creation function.
-    // In this case, we expect that there is at least one layer which can
-    // create a driver. In the base case, this is the default layer.
-    pfnCreateDriver = NULL;
-    pLayerCreateInfo = (SkLayerCreateInfo*)&driverCreateInfo;
-    while ((pLayerCreateInfo = pLayerCreateInfo->pNext)) {
-      if (pLayerCreateInfo->sType != SK_STRUCTURE_TYPE_LAYER_CREATE_INFO) {
-        continue;
-      }
-      if (!pLayerCreateInfo->pfnGetDriverProcAddr) {
-        continue;
-      }
-      pfnCreateDriver = (PFN_skCreateDriver)pLayerCreateInfo->pfnGetDriverProcAddr(NULL, "skCreateDriver");
-      break;
-    }
-    if (!pfnCreateDriver) {
-      skDestroyInstance(instance, pAllocator);
-      return SK_ERROR_INITIALIZATION_FAILED;
+    // Lazy drivers are only described by their properties, they will be
+    // loaded and created the first time the driver is actually requested.
+    if ((pCreateInfo->flags & SK_INSTANCE_CREATE_LAZY_DRIVERS_BIT) && !pDriverCreateInfo->pfnGetDriverProcAddr) {
+      instance->pendingDrivers[instance->pendingDriverCount] = *pDriverCreateInfo;
+      instance->pendingDrivers[instance->pendingDriverCount].pNext = NULL;
+      ++instance->pendingDriverCount;
+      continue;
     }
 
     // Attempt to create the driver (does not check driver contents)
     // Unlike layering, in this case if we fail to create a driver we will
     // simply skip the driver. This is because there is no precieved change in
     // functionality - the user can simply select a working driver.
-    result = pfnCreateDriver(
-      &driverCreateInfo,
-      pAllocator,
-      &driver
+    result = skCreateInstanceDriverIMPL(
+      instance,
+      pfnCreateDriver,
+      pCreateInfo->pNext,
+      pDriverCreateInfo,
+      NULL
     );
     if (result != SK_SUCCESS) {
       finalResult = SK_INCOMPLETE;
       continue;
     }
-    ((SkInternalObjectBase*)driver)->_pParent = (SkInternalObjectBase*)instance;
-
-    instance->drivers[instance->driverCount] = driver;
-    ++instance->driverCount;
   }
 
   *pInstance = instance;
@@ -1004,6 +1590,12 @@ static void SKAPI_CALL skDestroyInstance_internal(
       instance->drivers[idx]
     );
   }
+  if (instance->pResolvedPaths) {
+    for (idx = 0; idx <= instance->resolvedPathMask; ++idx) {
+      skFree(pAllocator, instance->pResolvedPaths[idx].pPath);
+    }
+    skFree(pAllocator, instance->pResolvedPaths);
+  }
   skFree(pAllocator, (void*)instance->instanceLayer._vtable);
   skFree(pAllocator, instance);
 }
@@ -1015,6 +1607,9 @@ static SkResult SKAPI_CALL skEnumerateInstanceDrivers_internal(
 ) {
   uint32_t idx;
 
+  // Enumerating drivers requires every driver to exist, create the rest now.
+  skRealizePendingDriversIMPL(instance);
+
   // Base-case, only provide the driver count.
   if (!pDriver) {
     *pDriverCount = instance->driverCount;
@@ -1125,6 +1720,7 @@ SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetInstanceProcAddr(
   HANDLE_JUMP(EnumerateInstanceDrivers);
 
   // Handle post-construct API functions (inefficient function mapping)
+  HANDLE_PROC(EnumerateInstanceTopology);
   HANDLE_PROC(GetDriverProcAddr);
   HANDLE_PROC(GetDriverProperties);
   HANDLE_PROC(GetDriverFeatures);
@@ -1133,9 +1729,12 @@ SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetInstanceProcAddr(
   HANDLE_PROC(QueryDeviceProperties);
   HANDLE_PROC(QueryDeviceFeatures);
   HANDLE_PROC(EnumerateDeviceEndpoints);
+  HANDLE_PROC(RegisterDeviceChangeCallback);
   HANDLE_PROC(QueryEndpointFeatures);
   HANDLE_PROC(QueryEndpointProperties);
+  HANDLE_PROC(EnumerateEndpointPcmFormats);
   HANDLE_PROC(RequestPcmStream);
+  HANDLE_PROC(ConfigurePcmStreamPool);
   HANDLE_PROC(GetPcmStreamProcAddr);
   HANDLE_PROC(ClosePcmStream);
   HANDLE_PROC(GetPcmStreamInfo);
@@ -1150,6 +1749,16 @@ SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetInstanceProcAddr(
   HANDLE_PROC(WritePcmStreamNoninterleaved);
   HANDLE_PROC(ReadPcmStreamInterleaved);
   HANDLE_PROC(ReadPcmStreamNoninterleaved);
+  HANDLE_PROC(ProcessPcmStreamInterleaved);
+  HANDLE_PROC(WritePcmStreamv);
+  HANDLE_PROC(ReadPcmStreamv);
+  HANDLE_PROC(WritePcmStreamSilence);
+  HANDLE_PROC(GetPcmStreamStatistics);
+  HANDLE_PROC(AvailPcmStreamSamplesCached);
+  HANDLE_PROC(QueryPcmStreamStatus);
+  HANDLE_PROC(FlushPcmStream);
+  HANDLE_PROC(RewindPcmStream);
+  HANDLE_PROC(ForwardPcmStream);
 
   // No function found
   return NULL;
@@ -1178,7 +1787,10 @@ SKAPI_ATTR SkObject SKAPI_CALL skResolveObject(
   SkObject                              object,
   char const*                           pPath
 ) {
+  uint32_t hash;
+  SkObject result;
   SkInstance instance;
+  SkResolvedPathIMPL* pEntry;
 
   // First, find the instance - it will be needed for later calculations.
   // We should always find an instance. But in case the driver is malformed,
@@ -1201,12 +1813,43 @@ SKAPI_ATTR SkObject SKAPI_CALL skResolveObject(
     ++pPath;
   }
 
+  // Streams come and go, so only paths from long-lived objects are cached.
+  switch (skGetObjectType(object)) {
+    case SK_OBJECT_TYPE_INSTANCE:
+    case SK_OBJECT_TYPE_DRIVER:
+    case SK_OBJECT_TYPE_DEVICE:
+    case SK_OBJECT_TYPE_ENDPOINT:
+      break;
+    default:
+      return skResolveObjectIMPL(instance->pAllocator, object, pPath);
+  }
+
+  // The same handful of paths are resolved over and over, check the cache.
+  hash = skHashResolvedPathIMPL(object, pPath);
+  pEntry = skGetResolvedPathIMPL(instance, object, pPath, hash);
+  if (pEntry && skIsResolvedPathValidIMPL(pEntry)) {
+    return pEntry->object;
+  }
+
   // Before we pass this off to the driver to handle, check if the user
   // is requesting a basic physical device or standard path.
-  return skResolveObjectIMPL(instance->pAllocator, object, pPath);
+  result = skResolveObjectIMPL(instance->pAllocator, object, pPath);
+  if (!result) {
+    return SK_NULL_HANDLE;
+  }
+
+  // Remember the result for the next time the path is resolved.
+  if (!pEntry) {
+    pEntry = skInsertResolvedPathIMPL(instance, object, pPath, hash);
+  }
+  if (pEntry) {
+    skUpdateResolvedPathIMPL(pEntry, result);
+  }
+
+  return result;
 }
 
-SKAPI_ATTR SkResult SKAPI_CALL skCreateInstance(
+static SkResult skCreateInstanceIMPL(
   SkInstanceCreateInfo const*           pCreateInfo,
   SkAllocationCallbacks const*          pAllocator,
   SkInstance*                           pInstance
@@ -1219,6 +1862,7 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreateInstance(
   // Drivers
   uint32_t totalDriverCount;
   uint32_t createDriverCount;
+  uint32_t implicitCreateInfoCount;
   uint32_t systemDriverCount;
   uint32_t staticDriverCount;
   uint32_t implicitDriverCount;
@@ -1238,6 +1882,7 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreateInstance(
   SkLayerCreateInfo* pLayerCreateInfo;
   SkLayerCreateInfo* pDistinctLayerCreateInfo;
   PFN_skCreateInstance pfnCreateInstance;
+  uint64_t traceTime;
 
   // Find the number of explicit-static objects which need to be constructed.
   // Note: This is useful if the user wishes to statically-compile a driver or
@@ -1400,18 +2045,26 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreateInstance(
     createDriverCount += staticDriverCount;
 
     // Handle Implicit-Enabled
+    // Note: Lazy drivers don't load their library here, the manifest
+    //       properties are enough to describe the driver until it's used.
     for (idx = 0; idx < implicitDriverCount; ++idx) {
-      implicitDriverCount = totalDriverCount - createDriverCount;
+      if (pCreateInfo->flags & SK_INSTANCE_CREATE_LAZY_DRIVERS_BIT) {
+        pDriverCreateInfo[createDriverCount].sType = SK_STRUCTURE_TYPE_DRIVER_CREATE_INFO;
+        pDriverCreateInfo[createDriverCount].properties = pDriverProperties[idx];
+        ++createDriverCount;
+        continue;
+      }
+      implicitCreateInfoCount = totalDriverCount - createDriverCount;
       result = skInitializeDriverCreateInfo(
         pDriverProperties[idx].driverName,
-        &implicitDriverCount,
+        &implicitCreateInfoCount,
         &pDriverCreateInfo[createDriverCount]
       );
       if (result != SK_SUCCESS) {
         skFree(pAllocator, pRawMemory);
         return result;
       }
-      createDriverCount += implicitDriverCount;
+      createDriverCount += implicitCreateInfoCount;
     }
   }
 
@@ -1441,33 +2094,72 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreateInstance(
 
   // Recurse through the layers until we find one with a valid instance layer.
   // This should _always_ succeed, and is considered an internal error otherwise.
-  pfnCreateInstance = (PFN_skCreateInstance)pDistinctLayerCreateInfo->pfnGetInstanceProcAddr(NULL, "skCreateInstance");
+  // Note: Layers may only implement parts (e.g. only PCM streams), skip those.
+  pfnCreateInstance = NULL;
+  if (pDistinctLayerCreateInfo->pfnGetInstanceProcAddr) {
+    pfnCreateInstance = (PFN_skCreateInstance)pDistinctLayerCreateInfo->pfnGetInstanceProcAddr(NULL, "skCreateInstance");
+  }
   while (!pfnCreateInstance) {
     pDistinctLayerCreateInfo = (SkLayerCreateInfo*)pDistinctLayerCreateInfo->pNext;
     if (!pDistinctLayerCreateInfo || pDistinctLayerCreateInfo->sType != SK_STRUCTURE_TYPE_LAYER_CREATE_INFO) {
       skFree(pAllocator, pRawMemory);
       return SK_ERROR_SYSTEM_INTERNAL;
     }
-    pfnCreateInstance = (PFN_skCreateInstance)pDistinctLayerCreateInfo->pfnGetInstanceProcAddr(NULL, "skCreateInstance");
+    if (pDistinctLayerCreateInfo->pfnGetInstanceProcAddr) {
+      pfnCreateInstance = (PFN_skCreateInstance)pDistinctLayerCreateInfo->pfnGetInstanceProcAddr(NULL, "skCreateInstance");
+    }
   }
 
   // Instantiate the call to actually construct instance/layers
   // This actually constructs the instance, which should call into each appropriate layer constructor.
   // Regardless of the results, we will destroy the driver and layer creation information.
+  traceTime = skBeginStartupTraceEvent();
   result = pfnCreateInstance(
     &createInfo,
     pAllocator,
     pInstance
   );
+  skEndStartupTraceEvent(traceTime, "pfnCreateInstance", pDistinctLayerCreateInfo->properties.layerName);
   skFree(pAllocator, pRawMemory);
 
   return result;
 }
 
+SKAPI_ATTR SkResult SKAPI_CALL skCreateInstance(
+  SkInstanceCreateInfo const*           pCreateInfo,
+  SkAllocationCallbacks const*          pAllocator,
+  SkInstance*                           pInstance
+) {
+  SkResult result;
+  uint64_t traceTime;
+  SkBool32 isTracing;
+
+  // Start tracing (if requested), the trace is owned by the new instance.
+  isTracing = skBeginStartupTrace(pCreateInfo, pAllocator);
+  traceTime = skBeginStartupTraceEvent();
+  result = skCreateInstanceIMPL(
+    pCreateInfo,
+    pAllocator,
+    pInstance
+  );
+  skEndStartupTraceEvent(traceTime, "skCreateInstance", NULL);
+  if (isTracing) {
+    if (result == SK_SUCCESS) {
+      skAttachStartupTrace(*pInstance);
+    }
+    else {
+      skEndStartupTrace(SK_NULL_HANDLE);
+    }
+  }
+
+  return result;
+}
+
 SKAPI_ATTR SkResult SKAPI_CALL skDestroyInstance(
   SkInstance                            instance,
   SkAllocationCallbacks const*          pAllocator
 ) {
+  skEndStartupTrace(instance);
   return skInstance(instance)->pfnDestroyInstance(
     instance,
     pAllocator
@@ -1486,6 +2178,46 @@ SKAPI_ATTR SkResult SKAPI_CALL skEnumerateInstanceDrivers(
   );
 }
 
+SKAPI_ATTR SkResult SKAPI_CALL skEnumerateInstanceTopology(
+  SkInstance                            instance,
+  size_t*                               pArenaSize,
+  void*                                 pArena,
+  SkInstanceTopology*                   pTopology
+) {
+  size_t arenaSize;
+  SkResult result;
+  uint32_t driverCount;
+  uint32_t deviceCount;
+  uint32_t endpointCount;
+  SkInstanceTopology layout;
+
+  // Count everything to find out how large the arena must be.
+  result = skCountTopologyIMPL(instance, &driverCount, &deviceCount, &endpointCount);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  arenaSize = skLayoutTopologyArenaIMPL(NULL, driverCount, deviceCount, endpointCount, &layout);
+  if (!pArena) {
+    *pArenaSize = arenaSize;
+    return SK_SUCCESS;
+  }
+  if (*pArenaSize < arenaSize) {
+    *pArenaSize = arenaSize;
+    return SK_INCOMPLETE;
+  }
+
+  // Fill the topology, nothing is returned unless all of it fits.
+  (void)skLayoutTopologyArenaIMPL(pArena, driverCount, deviceCount, endpointCount, &layout);
+  result = skFillTopologyIMPL(instance, driverCount, deviceCount, endpointCount, &layout);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+
+  *pArenaSize = arenaSize;
+  memcpy(pTopology, &layout, sizeof(SkInstanceTopology));
+  return SK_SUCCESS;
+}
+
 SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetDriverProcAddr(
   SkDriver                              driver,
   char const*                           pName
@@ -1578,6 +2310,22 @@ SKAPI_ATTR SkResult SKAPI_CALL skEnumerateDeviceEndpoints(
   );
 }
 
+SKAPI_ATTR SkResult SKAPI_CALL skRegisterDeviceChangeCallback(
+  SkDriver                              driver,
+  PFN_skDeviceChangeCallback            pfnCallback,
+  void*                                 pUserData
+) {
+  // Note: This is optional, not every driver is able to detect changes.
+  if (!skDriver(driver)->pfnRegisterDeviceChangeCallback) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skDriver(driver)->pfnRegisterDeviceChangeCallback(
+    driver,
+    pfnCallback,
+    pUserData
+  );
+}
+
 SKAPI_ATTR SkResult SKAPI_CALL skQueryEndpointFeatures(
   SkEndpoint                            endpoint,
   SkEndpointFeatures*                   pFeatures
@@ -1598,6 +2346,22 @@ SKAPI_ATTR SkResult SKAPI_CALL skQueryEndpointProperties(
   );
 }
 
+SKAPI_ATTR SkResult SKAPI_CALL skEnumerateEndpointPcmFormats(
+  SkEndpoint                            endpoint,
+  uint32_t*                             pFormatCount,
+  SkPcmFormatProperties*                pFormats
+) {
+  // Note: This is optional, not every driver is able to probe formats.
+  if (!skEndpoint(endpoint)->pfnEnumerateEndpointPcmFormats) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skEndpoint(endpoint)->pfnEnumerateEndpointPcmFormats(
+    endpoint,
+    pFormatCount,
+    pFormats
+  );
+}
+
 SKAPI_ATTR SkResult SKAPI_CALL skRequestPcmStream(
   SkEndpoint                            endpoint,
   SkPcmStreamRequest const*             pStreamRequest,
@@ -1610,6 +2374,22 @@ SKAPI_ATTR SkResult SKAPI_CALL skRequestPcmStream(
   );
 }
 
+SKAPI_ATTR SkResult SKAPI_CALL skConfigurePcmStreamPool(
+  SkEndpoint                            endpoint,
+  SkPcmStreamRequest const*             pStreamRequest,
+  uint32_t                              streamCount
+) {
+  // Note: This is optional, not every driver is able to open streams early.
+  if (!skEndpoint(endpoint)->pfnConfigurePcmStreamPool) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skEndpoint(endpoint)->pfnConfigurePcmStreamPool(
+    endpoint,
+    pStreamRequest,
+    streamCount
+  );
+}
+
 SKAPI_ATTR SkResult SKAPI_CALL skCreatePcmStream(
   SkEndpoint                            endpoint,
   SkPcmStreamCreateInfo const*          pCreateInfo,
@@ -1845,3 +2625,167 @@ SKAPI_ATTR int64_t SKAPI_CALL skReadPcmStreamNoninterleaved(
     samples
   );
 }
+
+SKAPI_ATTR int64_t SKAPI_CALL skProcessPcmStreamInterleaved(
+  SkPcmStream                           stream,
+  PFN_skPcmStreamProcessCallback        pfnCallback,
+  void*                                 pUserData
+) {
+  // Note: This is optional, not every driver is able to process duplex streams.
+  if (!skPcmStream(stream)->pfnProcessPcmStreamInterleaved) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skPcmStream(stream)->pfnProcessPcmStreamInterleaved(
+    stream,
+    pfnCallback,
+    pUserData
+  );
+}
+
+SKAPI_ATTR int64_t SKAPI_CALL skRewindPcmStream(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  // Note: This is optional, not every driver is able to rewind streams.
+  if (!skPcmStream(stream)->pfnRewindPcmStream) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skPcmStream(stream)->pfnRewindPcmStream(
+    stream,
+    streamType,
+    samples
+  );
+}
+
+SKAPI_ATTR int64_t SKAPI_CALL skForwardPcmStream(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  // Note: This is optional, not every driver is able to forward streams.
+  if (!skPcmStream(stream)->pfnForwardPcmStream) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skPcmStream(stream)->pfnForwardPcmStream(
+    stream,
+    streamType,
+    samples
+  );
+}
+
+SKAPI_ATTR int64_t SKAPI_CALL skWritePcmStreamv(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  // Note: This is optional, fall back to writing each span on its own.
+  if (skPcmStream(stream)->pfnWritePcmStreamv) {
+    return skPcmStream(stream)->pfnWritePcmStreamv(
+      stream,
+      pSpans,
+      spanCount
+    );
+  }
+  return skWritePcmStreamvBase(
+    stream,
+    skPcmStream(stream)->pfnWritePcmStreamInterleaved,
+    pSpans,
+    spanCount
+  );
+}
+
+SKAPI_ATTR int64_t SKAPI_CALL skReadPcmStreamv(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  // Note: This is optional, fall back to reading each span on its own.
+  if (skPcmStream(stream)->pfnReadPcmStreamv) {
+    return skPcmStream(stream)->pfnReadPcmStreamv(
+      stream,
+      pSpans,
+      spanCount
+    );
+  }
+  return skReadPcmStreamvBase(
+    stream,
+    skPcmStream(stream)->pfnReadPcmStreamInterleaved,
+    pSpans,
+    spanCount
+  );
+}
+
+SKAPI_ATTR int64_t SKAPI_CALL skWritePcmStreamSilence(
+  SkPcmStream                           stream,
+  uint32_t                              samples
+) {
+  // Note: This is optional, the application can always write silence itself.
+  if (!skPcmStream(stream)->pfnWritePcmStreamSilence) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skPcmStream(stream)->pfnWritePcmStreamSilence(
+    stream,
+    samples
+  );
+}
+
+SKAPI_ATTR SkResult SKAPI_CALL skGetPcmStreamStatistics(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatistics*                pStatistics
+) {
+  // Note: This is optional, not every driver keeps statistics.
+  if (!skPcmStream(stream)->pfnGetPcmStreamStatistics) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skPcmStream(stream)->pfnGetPcmStreamStatistics(
+    stream,
+    streamType,
+    pStatistics
+  );
+}
+
+SKAPI_ATTR SkResult SKAPI_CALL skAvailPcmStreamSamplesCached(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t*                             pSamples
+) {
+  // Note: This is optional, fall back to the synchronized query.
+  if (!skPcmStream(stream)->pfnAvailPcmStreamSamplesCached) {
+    return skAvailPcmStreamSamples(stream, streamType, pSamples);
+  }
+  return skPcmStream(stream)->pfnAvailPcmStreamSamplesCached(
+    stream,
+    streamType,
+    pSamples
+  );
+}
+
+SKAPI_ATTR SkResult SKAPI_CALL skQueryPcmStreamStatus(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatus*                    pStatus
+) {
+  // Note: This is optional, not every driver can report the state at once.
+  if (!skPcmStream(stream)->pfnQueryPcmStreamStatus) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return skPcmStream(stream)->pfnQueryPcmStreamStatus(
+    stream,
+    streamType,
+    pStatus
+  );
+}
+
+SKAPI_ATTR SkResult SKAPI_CALL skFlushPcmStream(
+  SkPcmStream                           stream
+) {
+  // Note: This is optional, if nothing implements it nothing is held back.
+  if (!skPcmStream(stream)->pfnFlushPcmStream) {
+    return SK_SUCCESS;
+  }
+  return skPcmStream(stream)->pfnFlushPcmStream(
+    stream
+  );
+}
@@ -60,6 +60,9 @@ SK_DEFINE_HANDLE(SkVideoStream);
 #define SK_MAX_NAME_SIZE 256
 #define SK_MAX_IDENTIFIER_SIZE 16
 #define SK_MAX_DESCRIPTION_SIZE 256
+#define SK_MAX_TRACE_NAME_SIZE 64
+#define SK_MAX_TRACE_DETAIL_SIZE 192
+#define SK_TOPOLOGY_INDEX_NONE (~0U)
 
 #define SK_OBJECT_PATH_PREFIX "sk:/"
 #define SK_OBJECT_PATH_SEPARATOR '/'
@@ -120,9 +123,10 @@ typedef enum SkStructureType {
   SK_STRUCTURE_TYPE_ICD_PCM_STREAM_REQUEST = 7,
   SK_STRUCTURE_TYPE_PCM_STREAM_INFO = 8,
   SK_STRUCTURE_TYPE_ICD_PCM_STREAM_INFO = 9,
+  SK_STRUCTURE_TYPE_STARTUP_TRACE_CREATE_INFO = 10,
   SK_STRUCTURE_TYPE_BEGIN_RANGE = SK_STRUCTURE_TYPE_INVALID,
-  SK_STRUCTURE_TYPE_END_RANGE = SK_STRUCTURE_TYPE_ICD_PCM_STREAM_INFO,
-  SK_STRUCTURE_TYPE_RANGE_SIZE = (SK_STRUCTURE_TYPE_ICD_PCM_STREAM_INFO - SK_STRUCTURE_TYPE_INVALID + 1),
+  SK_STRUCTURE_TYPE_END_RANGE = SK_STRUCTURE_TYPE_STARTUP_TRACE_CREATE_INFO,
+  SK_STRUCTURE_TYPE_RANGE_SIZE = (SK_STRUCTURE_TYPE_STARTUP_TRACE_CREATE_INFO - SK_STRUCTURE_TYPE_INVALID + 1),
   SK_STRUCTURE_TYPE_MAX_ENUM = 0x7FFFFFFF
 } SkStructureType;
 
@@ -200,10 +204,36 @@ typedef enum SkDeviceType {
   SK_DEVICE_TYPE_MAX_ENUM = 0x7FFFFFFF
 } SkDeviceType;
 
+typedef enum SkPcmStreamState {
+  SK_PCM_STREAM_STATE_UNKNOWN = 0,
+  SK_PCM_STREAM_STATE_PREPARED = 1,
+  SK_PCM_STREAM_STATE_RUNNING = 2,
+  SK_PCM_STREAM_STATE_XRUN = 3,
+  SK_PCM_STREAM_STATE_DRAINING = 4,
+  SK_PCM_STREAM_STATE_PAUSED = 5,
+  SK_PCM_STREAM_STATE_SUSPENDED = 6,
+  SK_PCM_STREAM_STATE_DISCONNECTED = 7,
+  SK_PCM_STREAM_STATE_BEGIN_RANGE = SK_PCM_STREAM_STATE_UNKNOWN,
+  SK_PCM_STREAM_STATE_END_RANGE = SK_PCM_STREAM_STATE_DISCONNECTED,
+  SK_PCM_STREAM_STATE_RANGE_SIZE = (SK_PCM_STREAM_STATE_DISCONNECTED - SK_PCM_STREAM_STATE_UNKNOWN + 1),
+  SK_PCM_STREAM_STATE_MAX_ENUM = 0x7FFFFFFF
+} SkPcmStreamState;
+
+typedef enum SkStartupTraceFormat {
+  SK_STARTUP_TRACE_FORMAT_REPORT = 0,
+  SK_STARTUP_TRACE_FORMAT_JSON = 1,
+  SK_STARTUP_TRACE_FORMAT_NONE = 2,
+  SK_STARTUP_TRACE_FORMAT_BEGIN_RANGE = SK_STARTUP_TRACE_FORMAT_REPORT,
+  SK_STARTUP_TRACE_FORMAT_END_RANGE = SK_STARTUP_TRACE_FORMAT_NONE,
+  SK_STARTUP_TRACE_FORMAT_RANGE_SIZE = (SK_STARTUP_TRACE_FORMAT_NONE - SK_STARTUP_TRACE_FORMAT_REPORT + 1),
+  SK_STARTUP_TRACE_FORMAT_MAX_ENUM = 0x7FFFFFFF
+} SkStartupTraceFormat;
+
 typedef enum SkInstanceCreateFlagBits {
   SK_INSTANCE_CREATE_NO_IMPLICIT_OBJECTS_BIT = 0x00000001,
   SK_INSTANCE_CREATE_NO_SYSTEM_OBJECTS_BIT = 0x00000002,
-  SK_INSTANCE_CREATE_FLAG_BITS_MASK = 0x00000003,
+  SK_INSTANCE_CREATE_LAZY_DRIVERS_BIT = 0x00000004,
+  SK_INSTANCE_CREATE_FLAG_BITS_MASK = 0x00000007,
   SK_INSTANCE_CREATE_FLAG_BITS_MAX_ENUM = 0x7FFFFFFF
 } SkInstanceCreateFlagBits;
 typedef SkFlags SkInstanceCreateFlags;
@@ -223,11 +253,35 @@ typedef enum SkStreamFlagBits {
 } SkStreamFlagBits;
 typedef SkFlags SkStreamFlags;
 
+// Note: SK_ACCESS_ADAPTIVE_BIT starts the stream at the smallest period the
+//       hardware allows, and keeps more samples buffered whenever an xrun is
+//       recovered. Once the stream is stable again, the depth decays back.
+//       Playback never queues more than the depth, so writes may be short.
+//       SK_ACCESS_TIMER_WAKEUP_BIT uses the largest buffer available without
+//       waking every period, skWaitPcmStream sleeps on a timer instead.
+//       This is meant for background streams, where latency is unimportant.
+//       It can't be combined with SK_ACCESS_BLOCKING_BIT.
+//       SK_ACCESS_AUTO_RECOVER_BIT recovers xruns and suspends inside of the
+//       read and write calls, which then retry instead of returning an error.
+//       Recoveries are counted in the stream's SkPcmStreamStatistics.
+//       SK_ACCESS_ASYNC_BIT queues interleaved playback, writes never block
+//       and the driver's service threads (one per processor, shared by every
+//       stream) feed the device. Samples which don't fit in the queue are
+//       dropped, and counted in the stream's SkPcmStreamStatistics.
+//       The queue has a single producer, so writes to the stream must not be
+//       made from more than one thread at a time. If the device can't be
+//       recovered by the service threads, writes return the error until
+//       skRecoverPcmStream is called (which drops whatever was queued).
 typedef enum SkAccessFlagBits {
   SK_ACCESS_BLOCKING_BIT = 0x00000001,
   SK_ACCESS_INTERLEAVED_BIT = 0x00000002,
   SK_ACCESS_MEMORY_MAPPED_BIT = 0x00000004,
-  SK_ACCESS_FLAG_BITS_MASK = 0x00000007,
+  SK_ACCESS_LINKED_BIT = 0x00000008,
+  SK_ACCESS_ADAPTIVE_BIT = 0x00000010,
+  SK_ACCESS_TIMER_WAKEUP_BIT = 0x00000020,
+  SK_ACCESS_AUTO_RECOVER_BIT = 0x00000040,
+  SK_ACCESS_ASYNC_BIT = 0x00000080,
+  SK_ACCESS_FLAG_BITS_MASK = 0x000000FF,
   SK_ACCESS_FLAG_BITS_MAX_ENUM = 0x7FFFFFFF
 } SkAccessFlagBits;
 typedef SkFlags SkAccessFlags;
@@ -250,6 +304,8 @@ typedef void (SKAPI_PTR *PFN_skFreeFunction)(void* pUserData, void* memory);
 typedef PFN_skVoidFunction (SKAPI_PTR *PFN_skGetInstanceProcAddr)(SkInstance instance, char const* pName);
 typedef PFN_skVoidFunction (SKAPI_PTR *PFN_skGetDriverProcAddr)(SkDriver driver, char const* pName);
 typedef PFN_skVoidFunction (SKAPI_PTR *PFN_skGetPcmStreamProcAddr)(SkPcmStream stream, char const* pName);
+typedef void (SKAPI_PTR *PFN_skDeviceChangeCallback)(void* pUserData, SkDriver driver);
+typedef void (SKAPI_PTR *PFN_skPcmStreamProcessCallback)(void* pUserData, void const* pReadBuffer, void* pWriteBuffer, uint32_t samples);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Standard Structures
@@ -276,6 +332,29 @@ typedef struct SkInstanceCreateInfo {
   char const* const*                    ppEnabledExtensionNames;
 } SkInstanceCreateInfo;
 
+typedef struct SkStartupTraceEvent {
+  char                                  name[SK_MAX_TRACE_NAME_SIZE];
+  char                                  detail[SK_MAX_TRACE_DETAIL_SIZE];
+  uint32_t                              threadIndex;
+  uint64_t                              startTime;
+  uint64_t                              duration;
+} SkStartupTraceEvent;
+
+typedef void (SKAPI_PTR *PFN_skStartupTraceCallback)(void* pUserData, uint32_t eventCount, SkStartupTraceEvent const* pEvents);
+
+// Attach to SkInstanceCreateInfo::pNext to trace instance startup.
+// Note: The trace ends when the instance is destroyed, so that any lazy
+//       driver creation and device enumeration is also captured. Times are
+//       in nanoseconds since skCreateInstance was called.
+typedef struct SkStartupTraceCreateInfo {
+  SkStructureType                       sType;
+  void const*                           pNext;
+  SkStartupTraceFormat                  format;
+  char const*                           pOutputPath;
+  PFN_skStartupTraceCallback            pfnCallback;
+  void*                                 pUserData;
+} SkStartupTraceCreateInfo;
+
 typedef struct SkAllocationCallbacks {
   void*                                 pUserData;
   PFN_skAllocationFunction              pfnAllocation;
@@ -348,6 +427,48 @@ typedef struct SkEndpointProperties {
   uint8_t                               endpointUuid[SK_UUID_SIZE];
 } SkEndpointProperties;
 
+typedef struct SkPcmFormatProperties {
+  SkStreamFlagBits                      streamType;
+  SkPcmFormat                           formatType;
+  SkAccessFlags                         supportedAccessModes;
+  uint32_t                              minSampleRate;
+  uint32_t                              maxSampleRate;
+  uint32_t                              minChannels;
+  uint32_t                              maxChannels;
+  uint32_t                              minPeriodSamples;
+  uint32_t                              maxPeriodSamples;
+  uint32_t                              minBufferSamples;
+  uint32_t                              maxBufferSamples;
+} SkPcmFormatProperties;
+
+// A snapshot of every driver, device and endpoint, stored as parallel arrays.
+// Note: Objects refer to their parents by index, endpoints which belong to
+//       the driver (and not to a device) have SK_TOPOLOGY_INDEX_NONE as their
+//       device index. Device endpoints are stored contiguously per-device.
+typedef struct SkInstanceTopology {
+  uint32_t                              driverCount;
+  uint32_t                              deviceCount;
+  uint32_t                              endpointCount;
+  SkDriver*                             pDrivers;
+  SkDriverProperties*                   pDriverProperties;
+  SkDriverFeatures*                     pDriverFeatures;
+  uint32_t*                             pDriverFirstDevices;
+  uint32_t*                             pDriverDeviceCounts;
+  uint32_t*                             pDriverFirstEndpoints;
+  uint32_t*                             pDriverEndpointCounts;
+  SkDevice*                             pDevices;
+  SkDeviceProperties*                   pDeviceProperties;
+  SkDeviceFeatures*                     pDeviceFeatures;
+  uint32_t*                             pDeviceDriverIndices;
+  uint32_t*                             pDeviceFirstEndpoints;
+  uint32_t*                             pDeviceEndpointCounts;
+  SkEndpoint*                           pEndpoints;
+  SkEndpointProperties*                 pEndpointProperties;
+  SkEndpointFeatures*                   pEndpointFeatures;
+  uint32_t*                             pEndpointDriverIndices;
+  uint32_t*                             pEndpointDeviceIndices;
+} SkInstanceTopology;
+
 typedef struct SkPcmStreamRequest {
   SkStructureType                       sType;
   void const*                           pNext;
@@ -377,6 +498,29 @@ typedef struct SkPcmStreamInfo {
   uint32_t                              bufferBits;
 } SkPcmStreamInfo;
 
+// Note: Spans are always interleaved, pBuffer holds samples frames of data.
+typedef struct SkPcmStreamSpan {
+  void*                                 pBuffer;
+  uint32_t                              samples;
+} SkPcmStreamSpan;
+
+typedef struct SkPcmStreamStatistics {
+  uint64_t                              xrunCount;
+  uint64_t                              suspendCount;
+  uint64_t                              interruptCount;
+  uint64_t                              autoRecoveryCount;
+  uint64_t                              queueHighWaterMark;
+  uint64_t                              droppedSamples;
+} SkPcmStreamStatistics;
+
+// Note: delaySamples is how long until a sample written now is played (or
+//       how long ago the oldest sample available to read was captured).
+typedef struct SkPcmStreamStatus {
+  SkPcmStreamState                      state;
+  uint32_t                              availableSamples;
+  int64_t                               delaySamples;
+} SkPcmStreamStatus;
+
 typedef struct SkMidiStreamInfo SkMidiStreamInfo;
 typedef struct SkMidiStreamInfo SkMidiStreamRequest;
 
@@ -394,6 +538,7 @@ typedef SkResult (SKAPI_PTR *PFN_skEnumerateLayerProperties)(uint32_t* pLayerCou
 typedef SkObject (SKAPI_PTR *PFN_skResolveParent)(SkObject object);
 typedef SkObject (SKAPI_PTR *PFN_skResolveObject)(SkObject object, char const* path);
 typedef SkResult (SKAPI_PTR *PFN_skEnumerateInstanceDrivers)(SkInstance instance, uint32_t* pDriverCount, SkDriver* pDriver);
+typedef SkResult (SKAPI_PTR *PFN_skEnumerateInstanceTopology)(SkInstance instance, size_t* pArenaSize, void* pArena, SkInstanceTopology* pTopology);
 
 // Drivers
 typedef void (SKAPI_PTR *PFN_skGetDriverProperties)(SkDriver driver, SkDriverProperties* pProperties);
@@ -403,9 +548,12 @@ typedef SkResult (SKAPI_PTR *PFN_skEnumerateDriverEndpoints)(SkDriver driver, ui
 typedef SkResult (SKAPI_PTR *PFN_skQueryDeviceFeatures)(SkDevice device, SkDeviceFeatures* pFeatures);
 typedef SkResult (SKAPI_PTR *PFN_skQueryDeviceProperties)(SkDevice device, SkDeviceProperties* pProperties);
 typedef SkResult (SKAPI_PTR *PFN_skEnumerateDeviceEndpoints)(SkDevice device, uint32_t* pEndpointCount, SkEndpoint* pEndpoints);
+typedef SkResult (SKAPI_PTR *PFN_skRegisterDeviceChangeCallback)(SkDriver driver, PFN_skDeviceChangeCallback pfnCallback, void* pUserData);
 typedef SkResult (SKAPI_PTR *PFN_skQueryEndpointFeatures)(SkEndpoint endpoint, SkEndpointFeatures *pFeatures);
 typedef SkResult (SKAPI_PTR *PFN_skQueryEndpointProperties)(SkEndpoint endpoint, SkEndpointProperties *pProperties);
+typedef SkResult (SKAPI_PTR *PFN_skEnumerateEndpointPcmFormats)(SkEndpoint endpoint, uint32_t* pFormatCount, SkPcmFormatProperties* pFormats);
 typedef SkResult (SKAPI_PTR *PFN_skRequestPcmStream)(SkEndpoint endpoint, SkPcmStreamRequest const* pRequest, SkPcmStream* pStream);
+typedef SkResult (SKAPI_PTR *PFN_skConfigurePcmStreamPool)(SkEndpoint endpoint, SkPcmStreamRequest const* pRequest, uint32_t streamCount);
 
 // PCM Streams
 typedef SkResult (SKAPI_PTR *PFN_skClosePcmStream)(SkPcmStream stream, SkBool32 drain);
@@ -422,6 +570,16 @@ typedef SkResult (SKAPI_PTR *PFN_skWritePcmStreamInterleaved)(SkPcmStream stream
 typedef SkResult (SKAPI_PTR *PFN_skWritePcmStreamNoninterleaved)(SkPcmStream stream, void** pBuffer, uint32_t samples);
 typedef SkResult (SKAPI_PTR *PFN_skReadPcmStreamInterleaved)(SkPcmStream stream, void* pBuffer, uint32_t samples);
 typedef SkResult (SKAPI_PTR *PFN_skReadPcmStreamNoninterleaved)(SkPcmStream stream, void** pBuffer, uint32_t samples);
+typedef int64_t (SKAPI_PTR *PFN_skProcessPcmStreamInterleaved)(SkPcmStream stream, PFN_skPcmStreamProcessCallback pfnCallback, void* pUserData);
+typedef int64_t (SKAPI_PTR *PFN_skWritePcmStreamv)(SkPcmStream stream, SkPcmStreamSpan const* pSpans, uint32_t spanCount);
+typedef int64_t (SKAPI_PTR *PFN_skReadPcmStreamv)(SkPcmStream stream, SkPcmStreamSpan const* pSpans, uint32_t spanCount);
+typedef int64_t (SKAPI_PTR *PFN_skWritePcmStreamSilence)(SkPcmStream stream, uint32_t samples);
+typedef SkResult (SKAPI_PTR *PFN_skGetPcmStreamStatistics)(SkPcmStream stream, SkStreamFlagBits streamType, SkPcmStreamStatistics* pStatistics);
+typedef SkResult (SKAPI_PTR *PFN_skAvailPcmStreamSamplesCached)(SkPcmStream stream, SkStreamFlagBits streamType, uint32_t* pSamples);
+typedef SkResult (SKAPI_PTR *PFN_skQueryPcmStreamStatus)(SkPcmStream stream, SkStreamFlagBits streamType, SkPcmStreamStatus* pStatus);
+typedef SkResult (SKAPI_PTR *PFN_skFlushPcmStream)(SkPcmStream stream);
+typedef int64_t (SKAPI_PTR *PFN_skRewindPcmStream)(SkPcmStream stream, SkStreamFlagBits streamType, uint32_t samples);
+typedef int64_t (SKAPI_PTR *PFN_skForwardPcmStream)(SkPcmStream stream, SkStreamFlagBits streamType, uint32_t samples);
 
 #ifndef   SK_NO_PROTOTYPES
 
@@ -463,6 +621,21 @@ SKAPI_ATTR SkResult SKAPI_CALL skEnumerateInstanceDrivers(
   SkDriver*                             pDriver
 );
 
+// Fills pArena with the whole driver/device/endpoint tree (including each
+// object's properties and features), and points pTopology into the arena.
+// If pArena is NULL, only the required arena size is returned. If the arena
+// is too small (the topology may have grown), the required size is written
+// back and SK_INCOMPLETE is returned - in which case nothing is filled.
+// SK_INCOMPLETE is also returned if the topology changes during the call.
+// Note: Arrays are cache-line aligned relative to the start of the arena.
+//       Objects whose properties or features couldn't be queried are zeroed.
+SKAPI_ATTR SkResult SKAPI_CALL skEnumerateInstanceTopology(
+  SkInstance                            instance,
+  size_t*                               pArenaSize,
+  void*                                 pArena,
+  SkInstanceTopology*                   pTopology
+);
+
 // Drivers
 
 SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetDriverProcAddr(
@@ -508,6 +681,19 @@ SKAPI_ATTR SkResult SKAPI_CALL skEnumerateDeviceEndpoints(
   SkEndpoint*                           pEndpoints
 );
 
+// Calls pfnCallback whenever the devices or endpoints of the driver may have
+// changed (e.g. hotplug), instead of the application having to poll them.
+// Note: The callback is invoked from an internal thread, and may be invoked
+//       more than once for a single change. It should only signal the
+//       application to enumerate again. Pass NULL to unregister.
+//       The callback must not register (or unregister) a callback itself,
+//       doing so returns SK_ERROR_INVALID and leaves the callback unchanged.
+SKAPI_ATTR SkResult SKAPI_CALL skRegisterDeviceChangeCallback(
+  SkDriver                              driver,
+  PFN_skDeviceChangeCallback            pfnCallback,
+  void*                                 pUserData
+);
+
 SKAPI_ATTR SkResult SKAPI_CALL skQueryEndpointFeatures(
   SkEndpoint                            endpoint,
   SkEndpointFeatures*                   pFeatures
@@ -518,12 +704,35 @@ SKAPI_ATTR SkResult SKAPI_CALL skQueryEndpointProperties(
   SkEndpointProperties*                 pProperties
 );
 
+// Enumerates every format the endpoint supports (one entry per stream type),
+// along with the range of configurations which are valid for that format.
+// Note: Results are cached by the driver until the devices change. If the
+//       endpoint is in-use and hasn't been probed, SK_ERROR_BUSY is returned.
+SKAPI_ATTR SkResult SKAPI_CALL skEnumerateEndpointPcmFormats(
+  SkEndpoint                            endpoint,
+  uint32_t*                             pFormatCount,
+  SkPcmFormatProperties*                pFormats
+);
+
 SKAPI_ATTR SkResult SKAPI_CALL skRequestPcmStream(
   SkEndpoint                            endpoint,
   SkPcmStreamRequest const*             pStreamRequest,
   SkPcmStream*                          pStream
 );
 
+// Keeps up to streamCount streams matching pStreamRequest opened and configured
+// ahead of time, so that a matching skRequestPcmStream returns immediately.
+// Streams are replaced in the background as they're handed out. Passing a
+// streamCount of 0 closes the streams which are being kept for the request.
+// Note: Only the first request in the chain is pooled (call this once per
+//       direction for duplex streams). Pooled streams hold the endpoint open,
+//       so other processes may see it as busy.
+SKAPI_ATTR SkResult SKAPI_CALL skConfigurePcmStreamPool(
+  SkEndpoint                            endpoint,
+  SkPcmStreamRequest const*             pStreamRequest,
+  uint32_t                              streamCount
+);
+
 // PCM Stream
 
 SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetPcmStreamProcAddr(
@@ -608,6 +817,104 @@ SKAPI_ATTR int64_t SKAPI_CALL skReadPcmStreamNoninterleaved(
   uint32_t                              samples
 );
 
+// Reads one period from a duplex stream, passes it to pfnCallback to fill one
+// period of output, and writes that back (returns the samples processed).
+// If the stream hasn't started yet, the output is primed with two periods of
+// silence and both directions are started together. This gives a fixed
+// round-trip latency of two periods.
+// Note: Both directions must be interleaved with the same period size. If
+//       SK_ACCESS_LINKED_BIT is missing from the stream info, the directions
+//       could not be linked, and are started one after the other instead.
+SKAPI_ATTR int64_t SKAPI_CALL skProcessPcmStreamInterleaved(
+  SkPcmStream                           stream,
+  PFN_skPcmStreamProcessCallback        pfnCallback,
+  void*                                 pUserData
+);
+
+// Writes the interleaved spans one after another, as if they were a single
+// contiguous buffer. Returns the number of samples written across all spans.
+// Note: This costs one call into the driver, rather than one per span. If the
+//       driver doesn't support it, the spans are written one at a time.
+SKAPI_ATTR int64_t SKAPI_CALL skWritePcmStreamv(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+);
+
+// Reads into the interleaved spans one after another, as if they were a
+// single contiguous buffer. Returns the number of samples read across all
+// spans.
+SKAPI_ATTR int64_t SKAPI_CALL skReadPcmStreamv(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+);
+
+// Writes samples of silence, without the application providing a buffer.
+// Returns the number of samples written.
+// Note: The driver generates the correct silence for the stream's format
+//       (e.g. unsigned formats are biased), directly in the device's buffer
+//       where possible, so this is cheaper than writing a buffer of zeroes.
+SKAPI_ATTR int64_t SKAPI_CALL skWritePcmStreamSilence(
+  SkPcmStream                           stream,
+  uint32_t                              samples
+);
+
+// Returns how many times the stream has been recovered (by skRecoverPcmStream,
+// or automatically for SK_ACCESS_AUTO_RECOVER_BIT streams), by cause.
+// For SK_ACCESS_ASYNC_BIT streams, this also reports the most samples that
+// were ever queued at once, and how many samples didn't fit in the queue.
+SKAPI_ATTR SkResult SKAPI_CALL skGetPcmStreamStatistics(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatistics*                pStatistics
+);
+
+// Like skAvailPcmStreamSamples, but without synchronizing with the hardware.
+// The result is only as current as the last read, write or wait, which is
+// what tight polling loops need - and it doesn't cost a trip to the kernel.
+SKAPI_ATTR SkResult SKAPI_CALL skAvailPcmStreamSamplesCached(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t*                             pSamples
+);
+
+// Returns the state, available samples and delay of the stream all at once.
+// Note: This is cheaper than querying each of these values on their own.
+SKAPI_ATTR SkResult SKAPI_CALL skQueryPcmStreamStatus(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatus*                    pStatus
+);
+
+// Submits any samples which a layer is holding back (e.g. to batch together
+// small writes) to the device. Returns SK_SUCCESS if nothing was held back.
+// Note: Held samples are only submitted from inside calls on the stream, so
+//       after the last write they stay held until the next call or a flush.
+SKAPI_ATTR SkResult SKAPI_CALL skFlushPcmStream(
+  SkPcmStream                           stream
+);
+
+// Moves the stream position back by up to samples, so that samples which
+// were written (or read) but not yet played (or overwritten) are handled
+// again. Returns the number of samples actually rewound, which may be fewer
+// than requested, since samples close to the hardware cannot be rewound.
+// Note: This lets a deeply-buffered playback stream replace queued samples
+//       (e.g. for a seek, or to mix in a sound effect) without waiting.
+SKAPI_ATTR int64_t SKAPI_CALL skRewindPcmStream(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+);
+
+// Moves the stream position forward by up to samples, without writing (or
+// reading) them. Returns the number of samples actually skipped.
+SKAPI_ATTR int64_t SKAPI_CALL skForwardPcmStream(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+);
+
 #endif // SK_NO_PROTOTYPES
 
 #ifdef    __cplusplus
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * Implementation of the cross-platform functionality which is built on top of
+ * the platform-specific primitives. This is always compiled in.
+ ******************************************************************************/
+
+// OpenSK
+#include <OpenSK/ext/sk_global.h>
+#include <OpenSK/plt/platform.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform Types
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct SkTaskDispatchIMPL {
+  PFN_skTaskFunctionPLT                 pfnTaskFunction;
+  void*                                 pUserData;
+  uint32_t                              taskCount;
+  uint32_t volatile                     nextTask;
+} SkTaskDispatchIMPL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Platform Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static void SKAPI_PTR skRunTasksIMPL(
+  void*                                 pUserData
+) {
+  uint32_t taskIndex;
+  SkTaskDispatchIMPL* pDispatch;
+
+  // Pull tasks until there are none left.
+  // Note: Pulling one task at a time means a slow task only occupies one of
+  //       the threads, the rest of the tasks are spread across the others.
+  pDispatch = pUserData;
+  for (;;) {
+    taskIndex = skAtomicIncrementPLT(&pDispatch->nextTask);
+    if (taskIndex >= pDispatch->taskCount) {
+      break;
+    }
+    pDispatch->pfnTaskFunction(pDispatch->pUserData, taskIndex);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Cross-Platform Functions
+////////////////////////////////////////////////////////////////////////////////
+
+void SKAPI_CALL skDispatchTasksPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  uint32_t                              taskCount,
+  uint32_t                              maxThreadCount,
+  PFN_skTaskFunctionPLT                 pfnTaskFunction,
+  void*                                 pUserData
+) {
+  uint32_t idx;
+  uint32_t threadCount;
+  SkThreadPLT* pThreads;
+  SkTaskDispatchIMPL dispatch;
+
+  // Initialize the dispatch information shared between threads.
+  dispatch.pfnTaskFunction = pfnTaskFunction;
+  dispatch.pUserData = pUserData;
+  dispatch.taskCount = taskCount;
+  dispatch.nextTask = 0;
+
+  // Never use more threads than there are processors or tasks to run.
+  threadCount = skGetProcessorCountPLT();
+  if (threadCount > maxThreadCount) {
+    threadCount = maxThreadCount;
+  }
+  if (threadCount > taskCount) {
+    threadCount = taskCount;
+  }
+
+  // The calling thread is always a worker, so only spawn the additional ones.
+  pThreads = NULL;
+  if (threadCount > 1) {
+    pThreads = skAllocate(
+      pAllocator,
+      sizeof(SkThreadPLT) * (threadCount - 1),
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+    );
+  }
+  if (!pThreads) {
+    threadCount = 1;
+  }
+  for (idx = 0; idx < threadCount - 1; ++idx) {
+    if (skCreateThreadPLT(pAllocator, &skRunTasksIMPL, &dispatch, &pThreads[idx]) != SK_SUCCESS) {
+      break;
+    }
+  }
+  threadCount = idx + 1;
+
+  // Work alongside the other threads, and then wait for them to finish.
+  skRunTasksIMPL(&dispatch);
+  for (idx = 0; idx < threadCount - 1; ++idx) {
+    skJoinThreadPLT(pAllocator, pThreads[idx]);
+  }
+  skFree(pAllocator, pThreads);
+}
@@ -23,12 +23,30 @@
 #include <OpenSK/opensk.h>
 #include <OpenSK/dev/utils.h>
 
+// C99
+#include <stdio.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 // Platform Defines
 ////////////////////////////////////////////////////////////////////////////////
 
 SK_DEFINE_HANDLE(SkLibraryPLT);
 SK_DEFINE_HANDLE(SkPlatformPLT);
+SK_DEFINE_HANDLE(SkThreadPLT);
+SK_DEFINE_HANDLE(SkMutexPLT);
+SK_DEFINE_HANDLE(SkConditionPLT);
+
+// The maximum number of threads the loader will use for platform discovery.
+#define SK_MAX_LOADER_THREADS_PLT 8
+
+typedef void (SKAPI_PTR *PFN_skThreadFunctionPLT)(
+  void*                                 pUserData
+);
+
+typedef void (SKAPI_PTR *PFN_skTaskFunctionPLT)(
+  void*                                 pUserData,
+  uint32_t                              taskIndex
+);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Platform Structures
@@ -48,6 +66,11 @@ typedef enum SkPlatformPropertyPLT {
   SK_PLATFORM_PROPERTY_MAX_ENUM = 0x7FFFFFFF
 } SkPlatformPropertyPLT;
 
+typedef struct SkFileStatusPLT {
+  int64_t                               modifiedTime;
+  uint64_t                              fileSize;
+} SkFileStatusPLT;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Platform Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -79,6 +102,11 @@ extern SkResult SKAPI_CALL skEnumeratePlatformManifestsPLT(
   char const**                          ppManifests
 );
 
+extern char* SKAPI_CALL skGetManifestCachePathPLT(
+  SkPlatformPLT                         platform,
+  SkAllocationCallbacks const*          pAllocator
+);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Non-Dispatchable Platform Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,6 +139,23 @@ extern SkBool32 SKAPI_CALL skFileExistsPLT(
   char const*                           pFile
 );
 
+extern SkBool32 SKAPI_CALL skGetFileStatusPLT(
+  char const*                           pFile,
+  SkFileStatusPLT*                      pStatus
+);
+
+extern SkBool32 SKAPI_CALL skCreateDirectoryPLT(
+  char const*                           pPath
+);
+
+// Creates (and opens for writing) a file next to pPath, with a name which
+// no other writer can be using. *ppTempPath must be freed with pAllocator.
+extern FILE* SKAPI_CALL skCreateTemporaryFilePLT(
+  SkAllocationCallbacks const*          pAllocator,
+  char const*                           pPath,
+  char**                                ppTempPath
+);
+
 extern SkResult SKAPI_CALL skLoadLibraryPLT(
   char const*                           pLibraryPath,
   SkLibraryPLT*                         pLibrary
@@ -125,4 +170,114 @@ extern PFN_skVoidFunction SKAPI_CALL skGetLibraryProcAddrPLT(
   char const*                           pName
 );
 
+extern SkResult SKAPI_CALL skCreateThreadPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  PFN_skThreadFunctionPLT               pfnThreadFunction,
+  void*                                 pUserData,
+  SkThreadPLT*                          pThread
+);
+
+extern void SKAPI_CALL skJoinThreadPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkThreadPLT                           thread
+);
+
+extern uint32_t SKAPI_CALL skGetProcessorCountPLT();
+
+// Pins the thread to one processor, and schedules it with real-time priority.
+// Note: Real-time scheduling usually requires privileges the process may not
+//       have, in which case SK_ERROR_NOT_SUPPORTED is returned.
+extern SkResult SKAPI_CALL skPromoteThreadPLT(
+  SkThreadPLT                           thread,
+  uint32_t                              processorIndex
+);
+
+// Returns a stable identifier for the calling thread.
+extern uint64_t SKAPI_CALL skGetCurrentThreadIdPLT();
+
+// Returns a monotonic timestamp in nanoseconds (with an unspecified epoch).
+extern uint64_t SKAPI_CALL skGetMonotonicTimePLT();
+
+// Atomically increments the value, and returns the value before incrementing.
+extern uint32_t SKAPI_CALL skAtomicIncrementPLT(
+  uint32_t volatile*                    pValue
+);
+
+// Reads the value, no reads or writes after this may be moved before it.
+extern uint32_t SKAPI_CALL skAtomicLoadPLT(
+  uint32_t volatile*                    pValue
+);
+
+// Writes the value, no reads or writes before this may be moved after it.
+extern void SKAPI_CALL skAtomicStorePLT(
+  uint32_t volatile*                    pValue,
+  uint32_t                              value
+);
+
+// No reads or writes may be moved across this, in either direction.
+extern void SKAPI_CALL skAtomicFencePLT();
+
+extern SkResult SKAPI_CALL skCreateMutexPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkSystemAllocationScope               allocationScope,
+  SkMutexPLT*                           pMutex
+);
+
+extern void SKAPI_CALL skDestroyMutexPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkMutexPLT                            mutex
+);
+
+extern void SKAPI_CALL skLockMutexPLT(
+  SkMutexPLT                            mutex
+);
+
+extern void SKAPI_CALL skUnlockMutexPLT(
+  SkMutexPLT                            mutex
+);
+
+extern SkResult SKAPI_CALL skCreateConditionPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkSystemAllocationScope               allocationScope,
+  SkConditionPLT*                       pCondition
+);
+
+extern void SKAPI_CALL skDestroyConditionPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkConditionPLT                        condition
+);
+
+// Atomically unlocks the mutex and waits for the condition to be signaled.
+// The mutex is locked again before returning.
+// Note: Like all condition variables, this may wake spuriously.
+extern void SKAPI_CALL skWaitConditionPLT(
+  SkConditionPLT                        condition,
+  SkMutexPLT                            mutex
+);
+
+extern void SKAPI_CALL skSignalConditionPLT(
+  SkConditionPLT                        condition
+);
+
+extern void SKAPI_CALL skBroadcastConditionPLT(
+  SkConditionPLT                        condition
+);
+
+////////////////////////////////////////////////////////////////////////////////
+// Cross-Platform Functions
+////////////////////////////////////////////////////////////////////////////////
+
+// Calls pfnTaskFunction once for each index in [0, taskCount) across at most
+// maxThreadCount threads (including the calling thread), and returns when all
+// of the tasks have completed. Tasks are not called in any particular order,
+// so each task should only write to results which are owned by its index.
+// Note: If threads cannot be created, the remaining tasks run serially.
+extern void SKAPI_CALL skDispatchTasksPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  uint32_t                              taskCount,
+  uint32_t                              maxThreadCount,
+  PFN_skTaskFunctionPLT                 pfnTaskFunction,
+  void*                                 pUserData
+);
+
 #endif // OPENSK_PLT_PLATFORM_H
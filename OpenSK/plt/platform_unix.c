@@ -17,6 +17,11 @@
  * This may or may not get compiled in, depending on the target platform.
  ******************************************************************************/
 
+// Note: Required for pthread_setaffinity_np, before anything is included.
+#ifndef   _GNU_SOURCE
+#define   _GNU_SOURCE
+#endif // _GNU_SOURCE
+
 // OpenSK
 #include <OpenSK/dev/string.h>
 #include <OpenSK/ext/sk_global.h>
@@ -30,7 +35,12 @@
 // Non-Standard
 #include <dlfcn.h>
 #include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
 #include <pwd.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 #include <uuid/uuid.h>
 #include <errno.h>
@@ -61,6 +71,9 @@ static char const *skDynamicSearchPathPostfixIMPL[] = {
   ".local/share/opensk/extensions.d/"
 };
 
+static char const *skManifestCachePostfixIMPL = "opensk/manifest.cache";
+static char const *skDefaultCachePathPostfixIMPL = ".cache/opensk/manifest.cache";
+
 static char const *skExecutableResolutionPathsIMPL[] = {
   "/proc/self/exe",
   "/proc/curproc/file",
@@ -98,6 +111,186 @@ typedef struct SkPlatformPLT_T {
   char                                  pUsername[LOGIN_NAME_MAX + 1];
 } SkPlatformPLT_T;
 
+typedef struct SkThreadPLT_T {
+  pthread_t                             thread;
+  PFN_skThreadFunctionPLT               pfnThreadFunction;
+  void*                                 pUserData;
+} SkThreadPLT_T;
+
+typedef struct SkMutexPLT_T {
+  pthread_mutex_t                       mutex;
+} SkMutexPLT_T;
+
+typedef struct SkConditionPLT_T {
+  pthread_cond_t                        condition;
+} SkConditionPLT_T;
+
+typedef struct SkDirectoryScanIMPL {
+  SkAllocationCallbacks const*          pAllocator;
+  SkStringVectorIMPL_T const*           pSearchPaths;
+  SkStringVectorIMPL_T*                 pManifestPaths;
+  SkResult*                             pResults;
+} SkDirectoryScanIMPL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Unix Platform Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static int skCompareManifestPathsIMPL(
+  void const*                           pLeft,
+  void const*                           pRight
+) {
+  return strcmp(*(char* const*)pLeft, *(char* const*)pRight);
+}
+
+static void SKAPI_PTR skScanManifestDirectoryIMPL(
+  void*                                 pUserData,
+  uint32_t                              taskIndex
+) {
+  char *pChar;
+  DIR *directory;
+  SkResult result;
+  struct dirent *entry;
+  SkDirectoryScanIMPL* pScan;
+  SkStringVectorIMPL_T* pManifestPaths;
+
+  // Attempt to open the provided directory.
+  pScan = pUserData;
+  pManifestPaths = &pScan->pManifestPaths[taskIndex];
+  pScan->pResults[taskIndex] = SK_SUCCESS;
+  directory = opendir(pScan->pSearchPaths->pData[taskIndex]);
+  if (!directory) {
+    return;
+  }
+
+  // Read all of the files in the directory.
+  while ((entry = readdir(directory))) {
+
+    // Skip all directory entries
+    if (entry->d_type == DT_DIR) {
+      continue;
+    }
+
+    // Skip all non-manifest files (files not ending in .json)
+    if (!skCStringEndsWith(entry->d_name, ".json")) {
+      continue;
+    }
+
+    // Add each file to a list of potential manifests
+    pChar = skCombinePathsPLT(
+      pScan->pAllocator,
+      pScan->pSearchPaths->pData[taskIndex],
+      entry->d_name
+    );
+    if (!pChar) {
+      pScan->pResults[taskIndex] = SK_ERROR_OUT_OF_HOST_MEMORY;
+      break;
+    }
+
+    // Add the string to the manifest path vector.
+    result = skPushStringVectorIMPL(
+      pScan->pAllocator,
+      pManifestPaths,
+      &pChar
+    );
+    if (result != SK_SUCCESS) {
+      skFree(pScan->pAllocator, pChar);
+      pScan->pResults[taskIndex] = result;
+      break;
+    }
+
+  }
+  closedir(directory);
+
+  // The order of readdir() is filesystem-dependent, so sort for determinism.
+  if (pManifestPaths->count > 1) {
+    qsort(
+      pManifestPaths->pData,
+      pManifestPaths->count,
+      sizeof(char*),
+      &skCompareManifestPathsIMPL
+    );
+  }
+}
+
+static SkResult skScanManifestDirectoriesIMPL(
+  SkAllocationCallbacks const*          pAllocator,
+  SkPlatformPLT                         platform
+) {
+  uint32_t idx;
+  uint32_t pathIdx;
+  SkResult result;
+  SkDirectoryScanIMPL scan;
+
+  // Nothing to scan, so nothing to do.
+  if (!platform->searchPaths.count) {
+    return SK_SUCCESS;
+  }
+
+  // Allocate the per-directory results, so that each directory can be scanned
+  // independently and then merged in search path order afterwards.
+  scan.pAllocator = pAllocator;
+  scan.pSearchPaths = &platform->searchPaths;
+  scan.pManifestPaths = skClearAllocate(
+    pAllocator,
+    (sizeof(SkStringVectorIMPL_T) + sizeof(SkResult)) * platform->searchPaths.count,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!scan.pManifestPaths) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  scan.pResults = (SkResult*)&scan.pManifestPaths[platform->searchPaths.count];
+  for (idx = 0; idx < platform->searchPaths.count; ++idx) {
+    scan.pManifestPaths[idx].allocationScope = SK_SYSTEM_ALLOCATION_SCOPE_LOADER;
+  }
+
+  // Scan all of the search paths (this is mostly waiting on the filesystem).
+  // Note: User allocators aren't required to be thread-safe, so with one of
+  //       those the search paths are scanned serially.
+  skDispatchTasksPLT(
+    pAllocator,
+    platform->searchPaths.count,
+    (pAllocator) ? 1 : SK_MAX_LOADER_THREADS_PLT,
+    &skScanManifestDirectoryIMPL,
+    &scan
+  );
+
+  // Merge the results in search path order.
+  result = SK_SUCCESS;
+  for (idx = 0; idx < platform->searchPaths.count; ++idx) {
+    if (scan.pResults[idx] != SK_SUCCESS) {
+      result = scan.pResults[idx];
+    }
+    for (pathIdx = 0; pathIdx < scan.pManifestPaths[idx].count; ++pathIdx) {
+      if (result == SK_SUCCESS) {
+        result = skPushStringVectorIMPL(
+          pAllocator,
+          &platform->manifestPaths,
+          &scan.pManifestPaths[idx].pData[pathIdx]
+        );
+        if (result == SK_SUCCESS) {
+          continue;
+        }
+      }
+      skFree(pAllocator, scan.pManifestPaths[idx].pData[pathIdx]);
+    }
+    skFree(pAllocator, scan.pManifestPaths[idx].pData);
+  }
+  skFree(pAllocator, scan.pManifestPaths);
+
+  return result;
+}
+
+static void* skRunThreadIMPL(
+  void*                                 pUserData
+) {
+  SkThreadPLT thread;
+  thread = pUserData;
+  thread->pfnThreadFunction(thread->pUserData);
+  return NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Unix Platform Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,13 +301,11 @@ SkResult SKAPI_CALL skCreatePlatformPLT(
 ) {
   char *pChar;
   uint32_t idx;
-  DIR *directory;
   SkResult result;
   size_t cwdLength;
   ssize_t exeLength;
   SkPlatformPLT platform;
   struct passwd *passwd;
-  struct dirent *entry;
 
   // Allocate the platform object
   platform = skClearAllocate(
@@ -279,7 +470,9 @@ SkResult SKAPI_CALL skCreatePlatformPLT(
     }
 
     // If the executable length is positive, we've resolved correctly.
+    // Note: readlink() does not null-terminate, but there is always room.
     if (exeLength > 0) {
+      platform->pExecutablePath[exeLength] = 0;
       pChar = strrchr(platform->pExecutablePath, '/');
       if (pChar) {
         pChar[0] = 0;
@@ -357,52 +550,10 @@ SkResult SKAPI_CALL skCreatePlatformPLT(
   }
 
   // Find all of the manifest files within the search paths provided.
-  for (idx = 0; idx < platform->searchPaths.count; ++idx) {
-
-    // Attempt to open the provided directory.
-    directory = opendir(platform->searchPaths.pData[idx]);
-    if (!directory) {
-      continue;
-    }
-
-    // Read all of the files in the directory.
-    while ((entry = readdir(directory))) {
-
-      // Skip all directory entries
-      if (entry->d_type == DT_DIR) {
-        continue;
-      }
-
-      // Skip all non-manifest files (files not ending in .json)
-      if (!skCStringEndsWith(entry->d_name, ".json")) {
-        continue;
-      }
-
-      // Add each file to a list of potential manifests
-      pChar = skCombinePathsPLT(
-        pAllocator,
-        platform->searchPaths.pData[idx],
-        entry->d_name
-      );
-      if (!pChar) {
-        skDestroyPlatformPLT(pAllocator, platform);
-        return SK_ERROR_OUT_OF_HOST_MEMORY;
-      }
-
-      // Add the string to the manifest path vector.
-      result = skPushStringVectorIMPL(
-        pAllocator,
-        &platform->manifestPaths,
-        &pChar
-      );
-      if (result != SK_SUCCESS) {
-        skFree(pAllocator, pChar);
-        skDestroyPlatformPLT(pAllocator, platform);
-        return result;
-      }
-
-    }
-    closedir(directory);
+  result = skScanManifestDirectoriesIMPL(pAllocator, platform);
+  if (result != SK_SUCCESS) {
+    skDestroyPlatformPLT(pAllocator, platform);
+    return result;
   }
 
   *pPlatform = platform;
@@ -512,6 +663,32 @@ SkResult SKAPI_CALL skEnumeratePlatformManifestsPLT(
   return SK_SUCCESS;
 }
 
+char* SKAPI_CALL skGetManifestCachePathPLT(
+  SkPlatformPLT                         platform,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  char const* pPath;
+
+  // The manifest cache can be disabled entirely, or redirected to a file.
+  if (getenv("SK_NO_MANIFEST_CACHE")) {
+    return NULL;
+  }
+  pPath = getenv("SK_MANIFEST_CACHE");
+  if (pPath && *pPath) {
+    return skDuplicateCString(pPath, pAllocator);
+  }
+
+  // Otherwise, follow the XDG base directory specification.
+  pPath = getenv("XDG_CACHE_HOME");
+  if (pPath && *pPath) {
+    return skCombinePathsPLT(pAllocator, pPath, skManifestCachePostfixIMPL);
+  }
+  if (platform->pHomeDirectory) {
+    return skCombinePathsPLT(pAllocator, platform->pHomeDirectory, skDefaultCachePathPostfixIMPL);
+  }
+  return NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Non-Dispatchable Platform Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -638,6 +815,89 @@ SkBool32 SKAPI_CALL skFileExistsPLT(
   return SK_FALSE;
 }
 
+SkBool32 SKAPI_CALL skGetFileStatusPLT(
+  char const*                           pFile,
+  SkFileStatusPLT*                      pStatus
+) {
+  struct stat fileStat;
+  if (stat(pFile, &fileStat) != 0) {
+    return SK_FALSE;
+  }
+  pStatus->modifiedTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+  pStatus->fileSize = (uint64_t)fileStat.st_size;
+  return SK_TRUE;
+}
+
+SkBool32 SKAPI_CALL skCreateDirectoryPLT(
+  char const*                           pPath
+) {
+  char* pChar;
+  size_t pathLength;
+  char pathBuffer[PATH_MAX];
+
+  // Copy the path so that we can terminate it at each separator.
+  pathLength = strlen(pPath);
+  if (pathLength == 0 || pathLength >= PATH_MAX) {
+    return SK_FALSE;
+  }
+  strcpy(pathBuffer, pPath);
+
+  // Create each of the parent directories (if they don't exist).
+  for (pChar = &pathBuffer[1]; *pChar; ++pChar) {
+    if (*pChar == '/') {
+      *pChar = 0;
+      if (mkdir(pathBuffer, 0755) != 0 && errno != EEXIST) {
+        return SK_FALSE;
+      }
+      *pChar = '/';
+    }
+  }
+
+  // Create the final directory.
+  if (mkdir(pathBuffer, 0755) != 0 && errno != EEXIST) {
+    return SK_FALSE;
+  }
+  return SK_TRUE;
+}
+
+FILE* SKAPI_CALL skCreateTemporaryFilePLT(
+  SkAllocationCallbacks const*          pAllocator,
+  char const*                           pPath,
+  char**                                ppTempPath
+) {
+  int fd;
+  FILE* pFile;
+  char* pTempPath;
+
+  // Note: mkstemp replaces the X's, and fails rather than reuse a file.
+  pTempPath = skAllocate(
+    pAllocator,
+    strlen(pPath) + sizeof(".XXXXXX"),
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!pTempPath) {
+    return NULL;
+  }
+  strcpy(pTempPath, pPath);
+  strcat(pTempPath, ".XXXXXX");
+  fd = mkstemp(pTempPath);
+  if (fd < 0) {
+    skFree(pAllocator, pTempPath);
+    return NULL;
+  }
+  pFile = fdopen(fd, "wb");
+  if (!pFile) {
+    (void)close(fd);
+    (void)unlink(pTempPath);
+    skFree(pAllocator, pTempPath);
+    return NULL;
+  }
+
+  *ppTempPath = pTempPath;
+  return pFile;
+}
+
 SkResult SKAPI_CALL skLoadLibraryPLT(
   char const*                           pLibraryPath,
   SkLibraryPLT*                         pLibrary
@@ -667,6 +927,203 @@ PFN_skVoidFunction SKAPI_CALL skGetLibraryProcAddrPLT(
   return (PFN_skVoidFunction)(intptr_t)dlsym((void*)library, pName);
 }
 
+SkResult SKAPI_CALL skCreateThreadPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  PFN_skThreadFunctionPLT               pfnThreadFunction,
+  void*                                 pUserData,
+  SkThreadPLT*                          pThread
+) {
+  SkThreadPLT thread;
+
+  // Allocate the thread object
+  thread = skAllocate(
+    pAllocator,
+    sizeof(SkThreadPLT_T),
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!thread) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  thread->pfnThreadFunction = pfnThreadFunction;
+  thread->pUserData = pUserData;
+
+  // Start the thread
+  if (pthread_create(&thread->thread, NULL, &skRunThreadIMPL, thread) != 0) {
+    skFree(pAllocator, thread);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  *pThread = thread;
+  return SK_SUCCESS;
+}
+
+void SKAPI_CALL skJoinThreadPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkThreadPLT                           thread
+) {
+  (void)pthread_join(thread->thread, NULL);
+  skFree(pAllocator, thread);
+}
+
+SkResult SKAPI_CALL skPromoteThreadPLT(
+  SkThreadPLT                           thread,
+  uint32_t                              processorIndex
+) {
+  cpu_set_t processors;
+  struct sched_param parameters;
+
+  CPU_ZERO(&processors);
+  CPU_SET(processorIndex, &processors);
+  if (pthread_setaffinity_np(thread->thread, sizeof(cpu_set_t), &processors) != 0) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Note: Stay below the maximum, which is left for the kernel's own threads.
+  memset(&parameters, 0, sizeof(parameters));
+  parameters.sched_priority = sched_get_priority_max(SCHED_FIFO) / 2;
+  if (pthread_setschedparam(thread->thread, SCHED_FIFO, &parameters) != 0) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+  return SK_SUCCESS;
+}
+
+uint32_t SKAPI_CALL skGetProcessorCountPLT() {
+  long processorCount;
+  processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+  return (processorCount > 0) ? (uint32_t)processorCount : 1;
+}
+
+uint64_t SKAPI_CALL skGetCurrentThreadIdPLT() {
+  return (uint64_t)(uintptr_t)pthread_self();
+}
+
+uint64_t SKAPI_CALL skGetMonotonicTimePLT() {
+  struct timespec time;
+  (void)clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+uint32_t SKAPI_CALL skAtomicIncrementPLT(
+  uint32_t volatile*                    pValue
+) {
+  return __sync_fetch_and_add(pValue, 1);
+}
+
+uint32_t SKAPI_CALL skAtomicLoadPLT(
+  uint32_t volatile*                    pValue
+) {
+  return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+}
+
+void SKAPI_CALL skAtomicStorePLT(
+  uint32_t volatile*                    pValue,
+  uint32_t                              value
+) {
+  __atomic_store_n(pValue, value, __ATOMIC_RELEASE);
+}
+
+void SKAPI_CALL skAtomicFencePLT() {
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+SkResult SKAPI_CALL skCreateMutexPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkSystemAllocationScope               allocationScope,
+  SkMutexPLT*                           pMutex
+) {
+  SkMutexPLT mutex;
+
+  mutex = skAllocate(
+    pAllocator,
+    sizeof(SkMutexPLT_T),
+    1,
+    allocationScope
+  );
+  if (!mutex) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  if (pthread_mutex_init(&mutex->mutex, NULL) != 0) {
+    skFree(pAllocator, mutex);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  *pMutex = mutex;
+  return SK_SUCCESS;
+}
+
+void SKAPI_CALL skDestroyMutexPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkMutexPLT                            mutex
+) {
+  (void)pthread_mutex_destroy(&mutex->mutex);
+  skFree(pAllocator, mutex);
+}
+
+void SKAPI_CALL skLockMutexPLT(
+  SkMutexPLT                            mutex
+) {
+  (void)pthread_mutex_lock(&mutex->mutex);
+}
+
+void SKAPI_CALL skUnlockMutexPLT(
+  SkMutexPLT                            mutex
+) {
+  (void)pthread_mutex_unlock(&mutex->mutex);
+}
+
+SkResult SKAPI_CALL skCreateConditionPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkSystemAllocationScope               allocationScope,
+  SkConditionPLT*                       pCondition
+) {
+  SkConditionPLT condition;
+
+  condition = skAllocate(
+    pAllocator,
+    sizeof(SkConditionPLT_T),
+    1,
+    allocationScope
+  );
+  if (!condition) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  if (pthread_cond_init(&condition->condition, NULL) != 0) {
+    skFree(pAllocator, condition);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  *pCondition = condition;
+  return SK_SUCCESS;
+}
+
+void SKAPI_CALL skDestroyConditionPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkConditionPLT                        condition
+) {
+  (void)pthread_cond_destroy(&condition->condition);
+  skFree(pAllocator, condition);
+}
+
+void SKAPI_CALL skWaitConditionPLT(
+  SkConditionPLT                        condition,
+  SkMutexPLT                            mutex
+) {
+  (void)pthread_cond_wait(&condition->condition, &mutex->mutex);
+}
+
+void SKAPI_CALL skSignalConditionPLT(
+  SkConditionPLT                        condition
+) {
+  (void)pthread_cond_signal(&condition->condition);
+}
+
+void SKAPI_CALL skBroadcastConditionPLT(
+  SkConditionPLT                        condition
+) {
+  (void)pthread_cond_broadcast(&condition->condition);
+}
+
 void SKAPI_CALL skGenerateUuid(
   uint8_t                               pUuid[SK_UUID_SIZE]
 ) {
@@ -76,6 +76,20 @@ typedef struct SkPlatformPLT_T {
   char                                  pUsername[UNLEN + 1];
 } SkPlatformPLT_T;
 
+typedef struct SkThreadPLT_T {
+  HANDLE                                hThread;
+  PFN_skThreadFunctionPLT               pfnThreadFunction;
+  void*                                 pUserData;
+} SkThreadPLT_T;
+
+typedef struct SkMutexPLT_T {
+  CRITICAL_SECTION                      criticalSection;
+} SkMutexPLT_T;
+
+typedef struct SkConditionPLT_T {
+  CONDITION_VARIABLE                    conditionVariable;
+} SkConditionPLT_T;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Windows Platform Helper Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -573,6 +587,30 @@ SkResult SKAPI_CALL skEnumeratePlatformManifestsPLT(
   return SK_SUCCESS;
 }
 
+char* SKAPI_CALL skGetManifestCachePathPLT(
+  SkPlatformPLT                         platform,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  char const* pPath;
+  (void)platform;
+
+  // The manifest cache can be disabled entirely, or redirected to a file.
+  if (getenv("SK_NO_MANIFEST_CACHE")) {
+    return NULL;
+  }
+  pPath = getenv("SK_MANIFEST_CACHE");
+  if (pPath && *pPath) {
+    return skDuplicateCString(pPath, pAllocator);
+  }
+
+  // Otherwise, store the cache in the user's local application data.
+  pPath = getenv("LOCALAPPDATA");
+  if (pPath && *pPath) {
+    return skCombinePathsPLT(pAllocator, pPath, "OpenSK\\manifest.cache");
+  }
+  return NULL;
+}
+
 void* SKAPI_CALL skAllocatePLT(
   size_t                                size,
   size_t                                alignment
@@ -694,6 +732,90 @@ SkBool32 SKAPI_CALL skFileExistsPLT(
   return (dwAttrib != INVALID_FILE_ATTRIBUTES && !(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
 }
 
+SkBool32 SKAPI_CALL skGetFileStatusPLT(
+  char const*                           pFile,
+  SkFileStatusPLT*                      pStatus
+) {
+  WIN32_FILE_ATTRIBUTE_DATA fileData;
+  if (!GetFileAttributesExA(pFile, GetFileExInfoStandard, &fileData)) {
+    return SK_FALSE;
+  }
+  pStatus->modifiedTime = ((int64_t)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+  pStatus->fileSize = ((uint64_t)fileData.nFileSizeHigh << 32) | fileData.nFileSizeLow;
+  return SK_TRUE;
+}
+
+SkBool32 SKAPI_CALL skCreateDirectoryPLT(
+  char const*                           pPath
+) {
+  char* pChar;
+  size_t pathLength;
+  char pathBuffer[MAX_PATH];
+
+  // Copy the path so that we can terminate it at each separator.
+  pathLength = strlen(pPath);
+  if (pathLength == 0 || pathLength >= MAX_PATH) {
+    return SK_FALSE;
+  }
+  strcpy(pathBuffer, pPath);
+
+  // Create each of the parent directories (if they don't exist).
+  for (pChar = &pathBuffer[1]; *pChar; ++pChar) {
+    if (*pChar == '\\' && pChar[-1] != ':') {
+      *pChar = 0;
+      if (!CreateDirectoryA(pathBuffer, NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
+        return SK_FALSE;
+      }
+      *pChar = '\\';
+    }
+  }
+
+  // Create the final directory.
+  if (!CreateDirectoryA(pathBuffer, NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
+    return SK_FALSE;
+  }
+  return SK_TRUE;
+}
+
+FILE* SKAPI_CALL skCreateTemporaryFilePLT(
+  SkAllocationCallbacks const*          pAllocator,
+  char const*                           pPath,
+  char**                                ppTempPath
+) {
+  FILE* pFile;
+  char* pTempPath;
+  size_t tempPathLength;
+
+  // Note: The process and thread ids are unique among the current writers, so
+  //       only a file left behind by an earlier (dead) writer is overwritten.
+  tempPathLength = strlen(pPath) + sizeof(".ffffffff.ffffffff.tmp");
+  pTempPath = skAllocate(
+    pAllocator,
+    tempPathLength,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!pTempPath) {
+    return NULL;
+  }
+  (void)snprintf(
+    pTempPath,
+    tempPathLength,
+    "%s.%lx.%lx.tmp",
+    pPath,
+    (unsigned long)GetCurrentProcessId(),
+    (unsigned long)GetCurrentThreadId()
+  );
+  pFile = fopen(pTempPath, "wb");
+  if (!pFile) {
+    skFree(pAllocator, pTempPath);
+    return NULL;
+  }
+
+  *ppTempPath = pTempPath;
+  return pFile;
+}
+
 SkInternalResult SKAPI_CALL skLoadLibraryPLT(
   char const*                           pLibraryPath,
   SkLibraryPLT*                         pLibrary
@@ -715,6 +837,208 @@ PFN_skVoidFunction SKAPI_CALL skGetLibraryProcAddrPLT(
   return (PFN_skVoidFunction)GetProcAddress((HMODULE)library, pName);
 }
 
+static DWORD WINAPI skRunThreadIMPL(
+  LPVOID                                pUserData
+) {
+  SkThreadPLT thread;
+  thread = pUserData;
+  thread->pfnThreadFunction(thread->pUserData);
+  return 0;
+}
+
+SkResult SKAPI_CALL skCreateThreadPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  PFN_skThreadFunctionPLT               pfnThreadFunction,
+  void*                                 pUserData,
+  SkThreadPLT*                          pThread
+) {
+  SkThreadPLT thread;
+
+  // Allocate the thread object
+  thread = skAllocate(
+    pAllocator,
+    sizeof(SkThreadPLT_T),
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND
+  );
+  if (!thread) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  thread->pfnThreadFunction = pfnThreadFunction;
+  thread->pUserData = pUserData;
+
+  // Start the thread
+  thread->hThread = CreateThread(NULL, 0, &skRunThreadIMPL, thread, 0, NULL);
+  if (!thread->hThread) {
+    skFree(pAllocator, thread);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  *pThread = thread;
+  return SK_SUCCESS;
+}
+
+void SKAPI_CALL skJoinThreadPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkThreadPLT                           thread
+) {
+  (void)WaitForSingleObject(thread->hThread, INFINITE);
+  CloseHandle(thread->hThread);
+  skFree(pAllocator, thread);
+}
+
+SkResult SKAPI_CALL skPromoteThreadPLT(
+  SkThreadPLT                           thread,
+  uint32_t                              processorIndex
+) {
+  if (!SetThreadAffinityMask(thread->hThread, (DWORD_PTR)1 << processorIndex)) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+  if (!SetThreadPriority(thread->hThread, THREAD_PRIORITY_TIME_CRITICAL)) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+  return SK_SUCCESS;
+}
+
+uint32_t SKAPI_CALL skGetProcessorCountPLT() {
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return (systemInfo.dwNumberOfProcessors > 0) ? systemInfo.dwNumberOfProcessors : 1;
+}
+
+uint64_t SKAPI_CALL skGetCurrentThreadIdPLT() {
+  return GetCurrentThreadId();
+}
+
+uint64_t SKAPI_CALL skGetMonotonicTimePLT() {
+  LARGE_INTEGER counter;
+  static LARGE_INTEGER frequency;
+  if (!frequency.QuadPart) {
+    (void)QueryPerformanceFrequency(&frequency);
+  }
+  (void)QueryPerformanceCounter(&counter);
+  return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000 +
+         (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+}
+
+uint32_t SKAPI_CALL skAtomicIncrementPLT(
+  uint32_t volatile*                    pValue
+) {
+  return (uint32_t)InterlockedIncrement((LONG volatile*)pValue) - 1;
+}
+
+uint32_t SKAPI_CALL skAtomicLoadPLT(
+  uint32_t volatile*                    pValue
+) {
+  uint32_t value;
+  value = *pValue;
+  MemoryBarrier();
+  return value;
+}
+
+void SKAPI_CALL skAtomicStorePLT(
+  uint32_t volatile*                    pValue,
+  uint32_t                              value
+) {
+  MemoryBarrier();
+  *pValue = value;
+}
+
+void SKAPI_CALL skAtomicFencePLT() {
+  MemoryBarrier();
+}
+
+SkResult SKAPI_CALL skCreateMutexPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkSystemAllocationScope               allocationScope,
+  SkMutexPLT*                           pMutex
+) {
+  SkMutexPLT mutex;
+
+  mutex = skAllocate(
+    pAllocator,
+    sizeof(SkMutexPLT_T),
+    1,
+    allocationScope
+  );
+  if (!mutex) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  InitializeCriticalSection(&mutex->criticalSection);
+
+  *pMutex = mutex;
+  return SK_SUCCESS;
+}
+
+void SKAPI_CALL skDestroyMutexPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkMutexPLT                            mutex
+) {
+  DeleteCriticalSection(&mutex->criticalSection);
+  skFree(pAllocator, mutex);
+}
+
+void SKAPI_CALL skLockMutexPLT(
+  SkMutexPLT                            mutex
+) {
+  EnterCriticalSection(&mutex->criticalSection);
+}
+
+void SKAPI_CALL skUnlockMutexPLT(
+  SkMutexPLT                            mutex
+) {
+  LeaveCriticalSection(&mutex->criticalSection);
+}
+
+SkResult SKAPI_CALL skCreateConditionPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkSystemAllocationScope               allocationScope,
+  SkConditionPLT*                       pCondition
+) {
+  SkConditionPLT condition;
+
+  condition = skAllocate(
+    pAllocator,
+    sizeof(SkConditionPLT_T),
+    1,
+    allocationScope
+  );
+  if (!condition) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  InitializeConditionVariable(&condition->conditionVariable);
+
+  *pCondition = condition;
+  return SK_SUCCESS;
+}
+
+void SKAPI_CALL skDestroyConditionPLT(
+  SkAllocationCallbacks const*          pAllocator,
+  SkConditionPLT                        condition
+) {
+  // Note: Windows condition variables don't need to be deleted.
+  skFree(pAllocator, condition);
+}
+
+void SKAPI_CALL skWaitConditionPLT(
+  SkConditionPLT                        condition,
+  SkMutexPLT                            mutex
+) {
+  (void)SleepConditionVariableCS(&condition->conditionVariable, &mutex->criticalSection, INFINITE);
+}
+
+void SKAPI_CALL skSignalConditionPLT(
+  SkConditionPLT                        condition
+) {
+  WakeConditionVariable(&condition->conditionVariable);
+}
+
+void SKAPI_CALL skBroadcastConditionPLT(
+  SkConditionPLT                        condition
+) {
+  WakeAllConditionVariable(&condition->conditionVariable);
+}
+
 void SKAPI_CALL skGenerateUuid(
   uint8_t                               pUuid[SK_UUID_SIZE]
 ) {
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * Platform-independent portions of the OpenSK utility allocators.
+ ******************************************************************************/
+
+// OpenSK
+#include <OpenSK/ext/sk_global.h>
+#include <OpenSK/utl/allocators.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// PCM Buffer Allocator
+////////////////////////////////////////////////////////////////////////////////
+
+SKAPI_ATTR void* SKAPI_CALL skAllocatePcmBufferUTL(
+  SkPcmStreamInfo const*                pStreamInfo,
+  uint32_t                              periodCount,
+  SkLockedBufferFlagsUTL                flags
+) {
+  size_t frameBytes;
+  uint32_t periodSamples;
+
+  // Determine the size of a single period (in bytes).
+  // Note: Some drivers cannot report the period size, fall back on the buffer.
+  periodSamples = pStreamInfo->periodSamples;
+  if (!periodSamples) {
+    periodSamples = pStreamInfo->bufferSamples;
+  }
+  frameBytes = (pStreamInfo->frameBits + 7) / 8;
+  if (!periodSamples || !frameBytes || !periodCount) {
+    return NULL;
+  }
+
+  return skAllocateLockedBufferUTL(
+    (size_t)periodSamples * periodCount * frameBytes,
+    flags
+  );
+}
+
+SKAPI_ATTR void SKAPI_CALL skFreePcmBufferUTL(
+  void*                                 pBuffer
+) {
+  skFreeLockedBufferUTL(pBuffer);
+}
@@ -54,6 +54,53 @@ void SKAPI_CALL skPrintDebugAllocatorStatisticsUTL(
   SkDebugAllocatorUTL                   debugAllocator
 );
 
+////////////////////////////////////////////////////////////////////////////////
+// Locked Buffer Allocator
+//------------------------------------------------------------------------------
+// Buffers which are handed to real-time PCM streams should never page fault.
+// This allocator returns memory which adheres to the following rules:
+// 1. The returned pointer is aligned to SK_CACHE_LINE_SIZE_UTL.
+// 2. Every page backing the allocation has been touched (prefaulted).
+// 3. The pages are locked into physical memory (if the system allows it).
+// 4. Optionally, the allocation is backed by huge pages (with fallback).
+// Note: Locking is best-effort unless SK_LOCKED_BUFFER_REQUIRE_LOCK_BIT_UTL
+//       is provided, as most systems limit unprivileged locked memory.
+////////////////////////////////////////////////////////////////////////////////
+#define SK_CACHE_LINE_SIZE_UTL 64
+
+typedef enum SkLockedBufferFlagBitsUTL {
+  SK_LOCKED_BUFFER_HUGE_PAGES_BIT_UTL = 0x00000001,
+  SK_LOCKED_BUFFER_REQUIRE_LOCK_BIT_UTL = 0x00000002,
+  SK_LOCKED_BUFFER_FLAG_BITS_MASK_UTL = 0x00000003
+} SkLockedBufferFlagBitsUTL;
+typedef SkFlags SkLockedBufferFlagsUTL;
+
+void* SKAPI_CALL skAllocateLockedBufferUTL(
+  size_t                                size,
+  SkLockedBufferFlagsUTL                flags
+);
+
+void SKAPI_CALL skFreeLockedBufferUTL(
+  void*                                 pBuffer
+);
+
+////////////////////////////////////////////////////////////////////////////////
+// PCM Buffer Allocator
+//------------------------------------------------------------------------------
+// Allocates a locked buffer large enough to hold periodCount periods of the
+// provided stream (periodSamples * frameBits). If periodSamples is not known
+// for the stream, bufferSamples will be used as the size of a period.
+////////////////////////////////////////////////////////////////////////////////
+void* SKAPI_CALL skAllocatePcmBufferUTL(
+  SkPcmStreamInfo const*                pStreamInfo,
+  uint32_t                              periodCount,
+  SkLockedBufferFlagsUTL                flags
+);
+
+void SKAPI_CALL skFreePcmBufferUTL(
+  void*                                 pBuffer
+);
+
 #ifdef    __cplusplus
 }
 #endif // __cplusplus
@@ -30,6 +30,7 @@
 #include <unistd.h>
 #include <execinfo.h>
 #include <signal.h>
+#include <sys/mman.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Debug Allocator
@@ -522,3 +523,116 @@ SKAPI_ATTR void SKAPI_CALL skPrintDebugAllocatorStatisticsUTL(
   skPrintDebugAllocatorStatisticsIMPL("Command", &pUserData->statistics[SK_SYSTEM_ALLOCATION_SCOPE_COMMAND]);
   skPrintDebugAllocatorStatisticsIMPL("Overall", &pUserData->overallStatistics);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Locked Buffer Allocator
+////////////////////////////////////////////////////////////////////////////////
+
+#define SK_HUGE_PAGE_SIZE_IMPL (2 * 1024 * 1024)
+
+// The header is placed in front of the user memory and padded to a full cache
+// line, so that the user memory starts on a cache line boundary as well.
+typedef union SkLockedBufferHeaderIMPL {
+  struct {
+    size_t                              mappingSize;
+    SkBool32                            isLocked;
+  } info;
+  unsigned char                         padding[SK_CACHE_LINE_SIZE_UTL];
+} SkLockedBufferHeaderIMPL;
+
+static size_t skAlignSizeIMPL(
+  size_t                                size,
+  size_t                                alignment
+) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+SKAPI_ATTR void* SKAPI_CALL skAllocateLockedBufferUTL(
+  size_t                                size,
+  SkLockedBufferFlagsUTL                flags
+) {
+  long pageSize;
+  size_t offset;
+  size_t mappingSize;
+  unsigned char* pMemory;
+  SkLockedBufferHeaderIMPL* pHeader;
+
+  // Determine the system page size (used for prefaulting).
+  pageSize = sysconf(_SC_PAGESIZE);
+  if (pageSize <= 0) {
+    pageSize = 4096;
+  }
+
+  // Attempt to map the memory with huge pages first, if requested.
+  // Note: MAP_HUGETLB requires pre-reserved huge pages, so fall back to THP.
+  pMemory = MAP_FAILED;
+  size += sizeof(SkLockedBufferHeaderIMPL);
+#ifdef    MAP_HUGETLB
+  if (flags & SK_LOCKED_BUFFER_HUGE_PAGES_BIT_UTL) {
+    mappingSize = skAlignSizeIMPL(size, SK_HUGE_PAGE_SIZE_IMPL);
+    pMemory = mmap(
+      NULL,
+      mappingSize,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+      -1,
+      0
+    );
+  }
+#endif // MAP_HUGETLB
+
+  // Otherwise, map the memory with the default page size.
+  if (pMemory == MAP_FAILED) {
+    mappingSize = skAlignSizeIMPL(size, (size_t)pageSize);
+    pMemory = mmap(
+      NULL,
+      mappingSize,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0
+    );
+    if (pMemory == MAP_FAILED) {
+      return NULL;
+    }
+#ifdef    MADV_HUGEPAGE
+    if (flags & SK_LOCKED_BUFFER_HUGE_PAGES_BIT_UTL) {
+      (void)madvise(pMemory, mappingSize, MADV_HUGEPAGE);
+    }
+#endif // MADV_HUGEPAGE
+  }
+
+  // Prefault every page by writing to it, so that the first access from a
+  // real-time thread doesn't have to go through the page fault handler.
+  for (offset = 0; offset < mappingSize; offset += (size_t)pageSize) {
+    pMemory[offset] = 0;
+  }
+
+  // Lock the pages so that they will not be swapped out later on.
+  pHeader = (SkLockedBufferHeaderIMPL*)pMemory;
+  pHeader->info.mappingSize = mappingSize;
+  pHeader->info.isLocked = (mlock(pMemory, mappingSize) == 0);
+  if (!pHeader->info.isLocked && (flags & SK_LOCKED_BUFFER_REQUIRE_LOCK_BIT_UTL)) {
+    munmap(pMemory, mappingSize);
+    return NULL;
+  }
+
+  return &pHeader[1];
+}
+
+SKAPI_ATTR void SKAPI_CALL skFreeLockedBufferUTL(
+  void*                                 pBuffer
+) {
+  SkLockedBufferHeaderIMPL* pHeader;
+
+  // Passing in NULL is valid, we should check for this case.
+  if (!pBuffer) {
+    return;
+  }
+
+  pHeader = &((SkLockedBufferHeaderIMPL*)pBuffer)[-1];
+  if (pHeader->info.isLocked) {
+    munlock(pHeader, pHeader->info.mappingSize);
+  }
+  munmap(pHeader, pHeader->info.mappingSize);
+}
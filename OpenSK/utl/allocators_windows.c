@@ -512,3 +512,111 @@ SKAPI_ATTR void SKAPI_CALL skPrintDebugAllocatorStatisticsUTL(
   skPrintDebugAllocatorStatisticsIMPL("Command", &pUserData->statistics[SK_SYSTEM_ALLOCATION_SCOPE_COMMAND]);
   skPrintDebugAllocatorStatisticsIMPL("Overall", &pUserData->overallStatistics);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Locked Buffer Allocator
+////////////////////////////////////////////////////////////////////////////////
+
+// The header is placed in front of the user memory and padded to a full cache
+// line, so that the user memory starts on a cache line boundary as well.
+typedef union SkLockedBufferHeaderIMPL {
+  struct {
+    SIZE_T                              mappingSize;
+    SkBool32                            isLocked;
+  } info;
+  unsigned char                         padding[SK_CACHE_LINE_SIZE_UTL];
+} SkLockedBufferHeaderIMPL;
+
+static SIZE_T skAlignSizeIMPL(
+  SIZE_T                                size,
+  SIZE_T                                alignment
+) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+SKAPI_ATTR void* SKAPI_CALL skAllocateLockedBufferUTL(
+  size_t                                size,
+  SkLockedBufferFlagsUTL                flags
+) {
+  SIZE_T offset;
+  SIZE_T mappingSize;
+  SIZE_T largePageSize;
+  SkBool32 isLargePage;
+  SYSTEM_INFO systemInfo;
+  unsigned char* pMemory;
+  SkLockedBufferHeaderIMPL* pHeader;
+
+  // Determine the system page size (used for prefaulting).
+  GetSystemInfo(&systemInfo);
+
+  // Attempt to allocate the memory with large pages first, if requested.
+  // Note: This requires SeLockMemoryPrivilege, and is implicitly locked.
+  pMemory = NULL;
+  isLargePage = SK_FALSE;
+  size += sizeof(SkLockedBufferHeaderIMPL);
+  if (flags & SK_LOCKED_BUFFER_HUGE_PAGES_BIT_UTL) {
+    largePageSize = GetLargePageMinimum();
+    if (largePageSize) {
+      mappingSize = skAlignSizeIMPL(size, largePageSize);
+      pMemory = VirtualAlloc(
+        NULL,
+        mappingSize,
+        MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+        PAGE_READWRITE
+      );
+      isLargePage = (pMemory != NULL);
+    }
+  }
+
+  // Otherwise, allocate the memory with the default page size.
+  if (!pMemory) {
+    mappingSize = skAlignSizeIMPL(size, systemInfo.dwPageSize);
+    pMemory = VirtualAlloc(
+      NULL,
+      mappingSize,
+      MEM_RESERVE | MEM_COMMIT,
+      PAGE_READWRITE
+    );
+    if (!pMemory) {
+      return NULL;
+    }
+  }
+
+  // Prefault every page by writing to it, so that the first access from a
+  // real-time thread doesn't have to go through the page fault handler.
+  for (offset = 0; offset < mappingSize; offset += systemInfo.dwPageSize) {
+    pMemory[offset] = 0;
+  }
+
+  // Lock the pages so that they will not be paged out later on.
+  // Note: Large pages are never paged out, so they needn't be locked.
+  pHeader = (SkLockedBufferHeaderIMPL*)pMemory;
+  pHeader->info.mappingSize = mappingSize;
+  pHeader->info.isLocked = SK_FALSE;
+  if (!isLargePage) {
+    pHeader->info.isLocked = (VirtualLock(pMemory, mappingSize) != 0);
+  }
+  if (!isLargePage && !pHeader->info.isLocked && (flags & SK_LOCKED_BUFFER_REQUIRE_LOCK_BIT_UTL)) {
+    VirtualFree(pMemory, 0, MEM_RELEASE);
+    return NULL;
+  }
+
+  return &pHeader[1];
+}
+
+SKAPI_ATTR void SKAPI_CALL skFreeLockedBufferUTL(
+  void*                                 pBuffer
+) {
+  SkLockedBufferHeaderIMPL* pHeader;
+
+  // Passing in NULL is valid, we should check for this case.
+  if (!pBuffer) {
+    return;
+  }
+
+  pHeader = &((SkLockedBufferHeaderIMPL*)pBuffer)[-1];
+  if (pHeader->info.isLocked) {
+    VirtualUnlock(pHeader, pHeader->info.mappingSize);
+  }
+  VirtualFree(pHeader, 0, MEM_RELEASE);
+}
@@ -18,6 +18,7 @@
 
 // OpenSK
 #include <OpenSK/ext/sk_global.h>
+#include <OpenSK/utl/allocators.h>
 #include <OpenSK/utl/ring_buffer.h>
 
 // C99
@@ -29,6 +30,7 @@
 
 typedef struct SkRingBufferUTL_T {
   SkAllocationCallbacks const*          pAllocator;
+  SkRingBufferCreateFlagsUTL            flags;
   SkBool32                              dataWrap;
   size_t                                capacity;
   char*                                 capacityBegin;
@@ -57,26 +59,48 @@ typedef struct SkRingBufferUTL_T {
 
 SkResult SKAPI_CALL skCreateRingBufferUTL(
   size_t                                bufferSize,
+  SkRingBufferCreateFlagsUTL            flags,
   SkAllocationCallbacks const*          pAllocator,
   SkSystemAllocationScope               allocationScope,
   SkRingBufferUTL*                      pRingBuffer
 ) {
+  char* pData;
   SkRingBufferUTL ringBuffer;
+  SkLockedBufferFlagsUTL lockedFlags;
 
   // Allocate the ring buffer object, along with it's data.
+  // Note: Locked data cannot come from the allocator, so it's kept separate.
   ringBuffer = skAllocate(
     pAllocator,
-    sizeof(SkRingBufferUTL_T) + bufferSize,
+    sizeof(SkRingBufferUTL_T) + ((flags & SK_RING_BUFFER_CREATE_LOCKED_BIT_UTL) ? 0 : bufferSize),
     1,
     allocationScope
   );
   if (!ringBuffer) {
     return SK_ERROR_OUT_OF_HOST_MEMORY;
   }
+
+  // Allocate the locked data, if requested.
+  if (flags & SK_RING_BUFFER_CREATE_LOCKED_BIT_UTL) {
+    lockedFlags = 0;
+    if (flags & SK_RING_BUFFER_CREATE_HUGE_PAGES_BIT_UTL) {
+      lockedFlags |= SK_LOCKED_BUFFER_HUGE_PAGES_BIT_UTL;
+    }
+    pData = skAllocateLockedBufferUTL(bufferSize, lockedFlags);
+    if (!pData) {
+      skFree(pAllocator, ringBuffer);
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+  else {
+    pData = (char*)&ringBuffer[1];
+  }
+
   ringBuffer->pAllocator = pAllocator;
+  ringBuffer->flags = flags;
   ringBuffer->dataWrap = SK_FALSE;
   ringBuffer->capacity = bufferSize;
-  ringBuffer->capacityBegin = ringBuffer->dataBegin = ringBuffer->dataEnd = (char*)&ringBuffer[1];
+  ringBuffer->capacityBegin = ringBuffer->dataBegin = ringBuffer->dataEnd = pData;
   ringBuffer->capacityEnd = ringBuffer->capacityBegin + bufferSize;
   (*pRingBuffer) = ringBuffer;
 
@@ -86,6 +110,9 @@ SkResult SKAPI_CALL skCreateRingBufferUTL(
 void SKAPI_CALL skDestroyRingBufferUTL(
   SkRingBufferUTL                       ringBuffer
 ) {
+  if (ringBuffer->flags & SK_RING_BUFFER_CREATE_LOCKED_BIT_UTL) {
+    skFreeLockedBufferUTL(ringBuffer->capacityBegin);
+  }
   skFree(ringBuffer->pAllocator, ringBuffer);
 }
 
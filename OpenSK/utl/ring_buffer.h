@@ -21,7 +21,7 @@
 #include <OpenSK/opensk.h>
 
 #ifdef    __cplusplus
-UTLern "C" {
+extern "C" {
 #endif // __cplusplus
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,13 @@ UTLern "C" {
 
 SK_DEFINE_HANDLE(SkRingBufferUTL);
 
+typedef enum SkRingBufferCreateFlagBitsUTL {
+  SK_RING_BUFFER_CREATE_LOCKED_BIT_UTL = 0x00000001,
+  SK_RING_BUFFER_CREATE_HUGE_PAGES_BIT_UTL = 0x00000002,
+  SK_RING_BUFFER_CREATE_FLAG_BITS_MASK_UTL = 0x00000003
+} SkRingBufferCreateFlagBitsUTL;
+typedef SkFlags SkRingBufferCreateFlagsUTL;
+
 typedef struct SkRingBufferDebugInfoUTL {
   SkBool32                              dataIsWrapping;
   void const*                           pCapacityBegin;
@@ -42,8 +49,11 @@ typedef struct SkRingBufferDebugInfoUTL {
 // Ring Buffer Functions
 ////////////////////////////////////////////////////////////////////////////////
 
+// Note: SK_RING_BUFFER_CREATE_LOCKED_BIT_UTL allocates the ring buffer's data
+//       through skAllocateLockedBufferUTL (prefaulted, locked, aligned).
 SkResult SKAPI_CALL skCreateRingBufferUTL(
   size_t                                bufferSize,
+  SkRingBufferCreateFlagsUTL            flags,
   SkAllocationCallbacks const*          pAllocator,
   SkSystemAllocationScope               allocationScope,
   SkRingBufferUTL*                      pRingBuffer
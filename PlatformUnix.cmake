@@ -17,9 +17,10 @@ set_property(DIRECTORY ${CMAKE_SOURCE_DIR} APPEND PROPERTY COMPILE_DEFINITIONS O
 # Platform Dependencies
 ################################################################################
 find_package(libuuid REQUIRED)
+find_package(Threads REQUIRED)
 find_library(MATH_LIBS m REQUIRED)
 set(OPENSK_INCLUDE_DIRECTORIES ${LIBUUID_INCLUDE_DIRS})
-set(OPENSK_LINK_LIBRARIES ${CMAKE_DL_LIBS} ${MATH_LIBS} ${LIBUUID_LIBRARIES})
+set(OPENSK_LINK_LIBRARIES ${CMAKE_DL_LIBS} ${MATH_LIBS} ${LIBUUID_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
 
 ################################################################################
 # Platform Sources
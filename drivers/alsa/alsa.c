@@ -20,7 +20,9 @@
 #include <OpenSK/dev/vector.h>
 #include <OpenSK/ext/sk_driver.h>
 #include <OpenSK/ext/sk_stream.h>
+#include <OpenSK/ext/sk_trace.h>
 #include <OpenSK/plt/platform.h>
+#include <OpenSK/utl/macros.h>
 
 // C99
 #include <ctype.h>
@@ -32,6 +34,11 @@
 
 // Non-Standard
 #include <dlfcn.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
 // Internal
 #include <OpenSK/icd/alsa.h>
@@ -63,6 +70,68 @@ typedef struct SkPcmStreamUserDataIMPL {
   SkAlsaPcmStreamInfo*                  pIcdStreamInfo;
 } SkPcmStreamUserDataIMPL;
 
+// How long an adaptive stream must go without an xrun before its depth is
+// lowered by a period, and the most that this wait is allowed to back off to.
+#define SK_ADAPTIVE_DECAY_TIME_IMPL (2000000000ull)
+#define SK_ADAPTIVE_MAX_DECAY_TIME_IMPL (64000000000ull)
+
+typedef struct SkPcmAdaptiveStateIMPL {
+  SkBool32                              isEnabled;
+  SkBool32                              isDecayed;
+  snd_pcm_uframes_t                     depth;
+  uint64_t                              changeTime;
+  uint64_t                              decayTime;
+} SkPcmAdaptiveStateIMPL;
+
+// How often the clock rate of a timer-scheduled stream is measured.
+#define SK_TIMER_RATE_WINDOW_IMPL (1000000000ull)
+
+// Note: Without period wakeups, the hardware position is only known when it's
+//       asked for. The rate is measured, so that drift between the system
+//       clock and the sample clock does not accumulate in the sleep times.
+typedef struct SkPcmTimerStateIMPL {
+  int                                   timerFd;
+  uint64_t                              transferredFrames;
+  uint64_t                              rateTime;
+  uint64_t                              ratePosition;
+  double                                measuredRate;
+} SkPcmTimerStateIMPL;
+
+// How many hardware buffers an asynchronous stream's queue can hold.
+#define SK_ASYNC_QUEUE_BUFFERS_IMPL 4
+
+typedef enum SkPcmQueueStopModeIMPL {
+  SK_PCM_QUEUE_RUNNING_IMPL = 0,
+  SK_PCM_QUEUE_DRAIN_IMPL = 1,
+  SK_PCM_QUEUE_DROP_IMPL = 2
+} SkPcmQueueStopModeIMPL;
+
+// Note: The queue has a single producer (the application) and consumer (one
+//       of the driver's service threads, at a time). Each side only writes
+//       its own index, and publishes it to the other side. The indices are
+//       free-running, and are masked by the capacity (a power of two) when
+//       the frames are accessed. isStopped is guarded by the queue mutex.
+//       While the queue runs, the service threads also update the stream's
+//       lastError, statistics and timer, which are guarded by the same mutex.
+typedef struct SkPcmQueueStateIMPL {
+  SkBool32                              isEnabled;
+  SkBool32                              isRunning;
+  SkBool32                              isStopped;
+  SkBool32                              isDeviceArmed;
+  int                                   pollFd;
+  int                                   eventFd;
+  struct pollfd*                        pDeviceFds;
+  uint32_t                              deviceFdCount;
+  char*                                 pFrames;
+  size_t                                frameBytes;
+  uint32_t                              capacity;
+  uint32_t volatile                     readIndex;
+  uint32_t volatile                     writeIndex;
+  uint32_t volatile                     isIdle;
+  uint32_t volatile                     stopMode;
+  uint32_t volatile                     failedError;
+} SkPcmQueueStateIMPL;
+
 typedef struct SkPcmStreamDataIMPL {
   int                                   lastError;
   SkBool32                              isClosed;
@@ -71,13 +140,94 @@ typedef struct SkPcmStreamDataIMPL {
   SkAlsaPcmStreamInfo                   icdStreamInfo;
   SkBool32                              supportsPausing;
   SkChannel*                            pChannelMap;
+  SkPcmAdaptiveStateIMPL                adaptive;
+  SkPcmTimerStateIMPL                   timer;
+  void*                                 pSpanBuffer;
+  SkBool32                              autoRecover;
+  SkPcmStreamStatistics                 statistics;
+  SkPcmQueueStateIMPL                   queue;
 } SkPcmStreamDataIMPL;
 
 typedef struct SkPcmStream_T {
   SK_INTERNAL_OBJECT_BASE;
   SkPcmStreamDataIMPL                   data[SK_PCM_STREAM_INDEX_SIZE];
+  SkBool32                              isLinked;
+  void*                                 pProcessBuffer;
 } SkPcmStream_T;
 
+// Note: Enumeration is served from these caches, they are invalidated whenever
+//       udev reports a hotplug event (or always, if udev can't be monitored).
+typedef struct SkObjectCacheIMPL {
+  SkBool32                              isValid;
+  uint32_t                              objectCount;
+  uint32_t                              objectCapacity;
+  SkObject*                             pObjects;
+} SkObjectCacheIMPL;
+
+// Note: Objects are never removed from an index (they live until the driver is
+//       destroyed), and several objects may share a key. Lookups return the
+//       first object inserted with a matching key, like a linear search would.
+typedef struct SkObjectIndexSlotIMPL {
+  uint32_t                              hash;
+  SkObject                              object;
+} SkObjectIndexSlotIMPL;
+
+typedef struct SkObjectIndexIMPL {
+  uint32_t                              objectCount;
+  uint32_t                              slotMask;
+  SkObjectIndexSlotIMPL*                pSlots;
+} SkObjectIndexIMPL;
+
+// The most formats an endpoint can have (every format, in both directions).
+#define SK_MAX_PCM_FORMAT_PROPERTIES_IMPL (2 * SK_PCM_FORMAT_END_RANGE)
+
+// Note: Probing an endpoint means opening it, which is slow and fails when
+//       the endpoint is busy. So results are kept until the next hotplug.
+typedef struct SkEndpointCapabilitiesIMPL {
+  uint32_t                              topologyVersion;
+  SkBool32                              hasFeatures;
+  SkEndpointFeatures                    features;
+  SkStreamFlags                         probedStreams;
+  uint32_t                              formatCount;
+  SkPcmFormatProperties*                pFormats;
+} SkEndpointCapabilitiesIMPL;
+
+// The most streams which can be kept open ahead of time for a single request.
+#define SK_MAX_POOLED_PCM_STREAMS_IMPL 8
+
+// A configured PCM handle which hasn't been turned into an SkPcmStream yet.
+// Note: Opening a handle never calls the application's allocator, so this is
+//       what the refill thread produces (see skCreateOpenedPcmStreamIMPL).
+typedef struct SkPcmOpenedStreamIMPL {
+  snd_pcm_t*                            pcmHandle;
+  SkBool32                              isCached;
+  SkAlsaPcmStreamRequest                originalRequest;
+  SkPcmStreamInfo                       streamInfo;
+  SkAlsaPcmStreamInfo                   icdStreamInfo;
+} SkPcmOpenedStreamIMPL;
+
+// Note: Pools are never freed before the driver is destroyed, so that the
+//       refill thread can keep a pointer to one while the lock is released.
+typedef struct SkPcmStreamPoolIMPL {
+  struct SkPcmStreamPoolIMPL*           pNext;
+  SkEndpoint                            endpoint;
+  SkAlsaPcmStreamRequest                request;
+  uint32_t                              targetCount;
+  uint32_t                              streamCount;
+  SkBool32                              isFailing;
+  SkPcmOpenedStreamIMPL                 streams[SK_MAX_POOLED_PCM_STREAMS_IMPL];
+} SkPcmStreamPoolIMPL;
+
+// The most negotiated configurations remembered for a single endpoint.
+#define SK_MAX_PCM_CONFIGURATIONS_IMPL 8
+
+// Note: Keyed on the request before negotiation, since that is what the user
+//       will issue again. The result is re-applied without any searching.
+typedef struct SkPcmConfigurationIMPL {
+  SkAlsaPcmStreamRequest                request;
+  SkAlsaHardwareParameters              hw;
+} SkPcmConfigurationIMPL;
+
 typedef struct SkEndpoint_T {
   SK_INTERNAL_OBJECT_BASE;
   SkStreamFlags                         supportedStreams;
@@ -86,6 +236,10 @@ typedef struct SkEndpoint_T {
   SkObject*                             streams;
   uint32_t                              streamCount;
   uint32_t                              streamCapacity;
+  SkEndpointCapabilitiesIMPL            capabilities;
+  uint32_t                              configurationCount;
+  uint32_t                              nextConfiguration;
+  SkPcmConfigurationIMPL*               pConfigurations;
   char*                                 endpointIdentifier;
   char                                  endpointPath[1];
 } SkEndpoint_T;
@@ -97,6 +251,8 @@ typedef struct SkDevice_T {
   SkEndpoint*                           endpoints;
   uint32_t                              endpointCount;
   uint32_t                              endpointCapacity;
+  SkObjectCacheIMPL                     endpointCache;
+  SkObjectIndexIMPL                     endpointNameIndex;
   char*                                 deviceIdentifier;
   char                                  devicePath[1];
 } SkDevice_T;
@@ -107,8 +263,25 @@ typedef struct SkDriver_T {
   SkDevice*                             devices;
   uint32_t                              deviceCount;
   uint32_t                              deviceCapacity;
+  SkObjectCacheIMPL                     deviceCache;
+  SkObjectIndexIMPL                     deviceNumberIndex;
+  SkObjectIndexIMPL                     deviceUuidIndex;
+  uint32_t                              topologyVersion;
   SkDevice_T                            dummyDevice;
   SkUDevIMPL                            udev;
+  PFN_skDeviceChangeCallback            pfnDeviceChangeCallback;
+  void*                                 pDeviceChangeUserData;
+  SkPcmStreamPoolIMPL*                  pStreamPools;
+  SkMutexPLT                            poolMutex;
+  SkConditionPLT                        poolCondition;
+  SkThreadPLT                           poolThread;
+  SkBool32                              isPoolStopping;
+  int                                   queueEpollFd;
+  int                                   queueStopFd;
+  SkThreadPLT*                          pQueueThreads;
+  uint32_t                              queueThreadCount;
+  SkMutexPLT                            queueMutex;
+  SkConditionPLT                        queueCondition;
   char                                  driverPath[sizeof(SK_DRIVER_OPENSK_ALSA_ID) + 1];
 } SkDriver_T;
 
@@ -123,6 +296,62 @@ static SkResult SKAPI_CALL skEnumerateDeviceEndpoints_alsa(
   SkEndpoint*                           pEndpoints
 );
 
+static void skDestroyPcmStreamPoolsIMPL(
+  SkDriver                              driver
+);
+
+static SkResult skEnableAdaptiveBufferingIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+);
+
+static void skConfigureAutoRecoveryIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkBool32                              autoRecover
+);
+
+static int64_t skTransferPcmStreamSpansIMPL(
+  SkPcmStream                           stream,
+  SkPcmStreamIndexIMPL                  streamIndex,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint32_t                              silenceFrames
+);
+
+static SkResult skStartPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData
+);
+
+static void skStopPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkBool32                              drain
+);
+
+static SkResult skRecoverPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData
+);
+
+static void skStopPcmQueueThreadsIMPL(
+  SkDriver                              driver
+);
+
+static void skWakePcmStreamQueueIMPL(
+  SkPcmQueueStateIMPL*                  pQueue
+);
+
+static uint32_t skGetPcmStreamQueueSpaceIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+);
+
+static int64_t skEnqueuePcmStreamSpansIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint32_t                              silenceFrames
+);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Helper Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -145,14 +374,112 @@ static SkDevice skGetCardDeviceIMPL(
   return object;
 }
 
+static uint32_t skHashBytesIMPL(
+  void const*                           pData,
+  size_t                                dataSize
+) {
+  uint32_t hash;
+  uint8_t const* pBytes;
+
+  // FNV-1a (32-bit)
+  hash = 2166136261u;
+  pBytes = pData;
+  while (dataSize--) {
+    hash ^= *pBytes++;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+static SkResult skReserveObjectIndexIMPL(
+  SkAllocationCallbacks const*          pAllocator,
+  SkObjectIndexIMPL*                    pIndex
+) {
+  uint32_t idx;
+  uint32_t slot;
+  uint32_t first;
+  uint32_t count;
+  uint32_t slotCount;
+  SkObjectIndexSlotIMPL* pSlots;
+
+  // Keep the index at most half-full after the next insertion.
+  // Note: Reserving before the object is created means inserting can't fail.
+  slotCount = (pIndex->pSlots) ? pIndex->slotMask + 1 : 0;
+  if (2 * (pIndex->objectCount + 1) <= slotCount) {
+    return SK_SUCCESS;
+  }
+  slotCount = (slotCount) ? slotCount * 2 : 8;
+  pSlots = skClearAllocate(
+    pAllocator,
+    sizeof(SkObjectIndexSlotIMPL) * slotCount,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
+  );
+  if (!pSlots) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  // Re-insert the objects in probe order, so shared keys keep their order.
+  // Note: Probing wraps around the end of the table, so start just after an
+  //       empty slot (there always is one), which begins a probe sequence.
+  if (pIndex->pSlots) {
+    first = 0;
+    while (pIndex->pSlots[first].object) {
+      ++first;
+    }
+    for (count = 1; count <= pIndex->slotMask + 1; ++count) {
+      idx = (first + count) & pIndex->slotMask;
+      if (!pIndex->pSlots[idx].object) {
+        continue;
+      }
+      slot = pIndex->pSlots[idx].hash & (slotCount - 1);
+      while (pSlots[slot].object) {
+        slot = (slot + 1) & (slotCount - 1);
+      }
+      pSlots[slot] = pIndex->pSlots[idx];
+    }
+  }
+
+  skFree(pAllocator, pIndex->pSlots);
+  pIndex->pSlots = pSlots;
+  pIndex->slotMask = slotCount - 1;
+  return SK_SUCCESS;
+}
+
+static void skInsertObjectIndexIMPL(
+  SkObjectIndexIMPL*                    pIndex,
+  uint32_t                              hash,
+  SkObject                              object
+) {
+  uint32_t slot;
+  slot = hash & pIndex->slotMask;
+  while (pIndex->pSlots[slot].object) {
+    slot = (slot + 1) & pIndex->slotMask;
+  }
+  pIndex->pSlots[slot].hash = hash;
+  pIndex->pSlots[slot].object = object;
+  ++pIndex->objectCount;
+}
+
 static SkDevice skGetDeviceByNumberIMPL(
   SkDriver                              driver,
   uint32_t                              number
 ) {
-  uint32_t idx;
-  for (idx = 0; idx < driver->deviceCount; ++idx) {
-    if (driver->devices[idx]->deviceNumber == number) {
-      return driver->devices[idx];
+  uint32_t slot;
+  uint32_t hash;
+  SkDevice device;
+  SkObjectIndexIMPL const* pIndex;
+
+  pIndex = &driver->deviceNumberIndex;
+  if (!pIndex->pSlots) {
+    return NULL;
+  }
+  hash = skHashBytesIMPL(&number, sizeof(number));
+  for (slot = hash & pIndex->slotMask; pIndex->pSlots[slot].object; slot = (slot + 1) & pIndex->slotMask) {
+    device = pIndex->pSlots[slot].object;
+    if (pIndex->pSlots[slot].hash == hash && device->deviceNumber == number) {
+      return device;
     }
   }
   return NULL;
@@ -162,10 +489,20 @@ static SkDevice skGetDeviceByUuidIMPL(
   SkDriver                              driver,
   uint8_t                               deviceUuid[SK_UUID_SIZE]
 ) {
-  uint32_t idx;
-  for (idx = 0; idx < driver->deviceCount; ++idx) {
-    if (memcmp(driver->devices[idx]->_iUuid, deviceUuid, SK_UUID_SIZE) == 0) {
-      return driver->devices[idx];
+  uint32_t slot;
+  uint32_t hash;
+  SkDevice device;
+  SkObjectIndexIMPL const* pIndex;
+
+  pIndex = &driver->deviceUuidIndex;
+  if (!pIndex->pSlots) {
+    return NULL;
+  }
+  hash = skHashBytesIMPL(deviceUuid, SK_UUID_SIZE);
+  for (slot = hash & pIndex->slotMask; pIndex->pSlots[slot].object; slot = (slot + 1) & pIndex->slotMask) {
+    device = pIndex->pSlots[slot].object;
+    if (pIndex->pSlots[slot].hash == hash && memcmp(device->_iUuid, deviceUuid, SK_UUID_SIZE) == 0) {
+      return device;
     }
   }
   return NULL;
@@ -175,8 +512,11 @@ static SkEndpoint skGetEndpointByNameIMPL(
   SkObject                              parent,
   char const*                           pName
 ) {
-  uint32_t idx;
+  uint32_t slot;
+  uint32_t hash;
   SkDevice device;
+  SkEndpoint endpoint;
+  SkObjectIndexIMPL const* pIndex;
 
   // Handle the case where the parent is the driver
   switch (skGetObjectType(parent)) {
@@ -191,14 +531,98 @@ static SkEndpoint skGetEndpointByNameIMPL(
   }
 
   // Search for the endpoint by name
-  for (idx = 0; idx < device->endpointCount; ++idx) {
-    if (strcmp(device->endpoints[idx]->endpointIdentifier, pName) == 0) {
-      return device->endpoints[idx];
+  pIndex = &device->endpointNameIndex;
+  if (!pIndex->pSlots) {
+    return NULL;
+  }
+  hash = skHashBytesIMPL(pName, strlen(pName));
+  for (slot = hash & pIndex->slotMask; pIndex->pSlots[slot].object; slot = (slot + 1) & pIndex->slotMask) {
+    endpoint = pIndex->pSlots[slot].object;
+    if (pIndex->pSlots[slot].hash == hash && strcmp(endpoint->endpointIdentifier, pName) == 0) {
+      return endpoint;
     }
   }
   return NULL;
 }
 
+static SkResult skPushObjectCacheIMPL(
+  SkAllocationCallbacks const*          pAllocator,
+  SkObjectCacheIMPL*                    pCache,
+  SkObject                              object
+) {
+  uint32_t capacity;
+  SkObject* pObjects;
+
+  // If needed, grow the object array
+  if (pCache->objectCapacity == pCache->objectCount) {
+    capacity = (pCache->objectCapacity) ? pCache->objectCapacity * 2 : 2;
+    pObjects = skReallocate(
+      pAllocator,
+      pCache->pObjects,
+      sizeof(SkObject) * capacity,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
+    );
+    if (!pObjects) {
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    pCache->pObjects = pObjects;
+    pCache->objectCapacity = capacity;
+  }
+
+  pCache->pObjects[pCache->objectCount] = object;
+  ++pCache->objectCount;
+  return SK_SUCCESS;
+}
+
+static SkResult skReadObjectCacheIMPL(
+  SkObjectCacheIMPL const*              pCache,
+  uint32_t*                             pObjectCount,
+  SkObject*                             pObjects
+) {
+  uint32_t count;
+
+  // Return the object count if it's requested.
+  if (!pObjects) {
+    *pObjectCount = pCache->objectCount;
+    return SK_SUCCESS;
+  }
+
+  // Otherwise populate the enumeration.
+  for (count = 0; count < pCache->objectCount; ++count) {
+    if (*pObjectCount <= count) {
+      return SK_INCOMPLETE;
+    }
+    pObjects[count] = pCache->pObjects[count];
+  }
+
+  *pObjectCount = count;
+  return SK_SUCCESS;
+}
+
+static void skUpdateTopologyIMPL(
+  SkDriver                              driver
+) {
+  uint32_t idx;
+  SkBool32 isChanged;
+  uint64_t traceTime;
+
+  traceTime = skBeginStartupTraceEvent();
+  isChanged = skUpdateUDevDevicesIMPL(driver->udev);
+  skEndStartupTraceEvent(traceTime, "skUpdateUDevDevicesIMPL", NULL);
+
+  // If udev has seen any changes, everything has to be discovered again.
+  // Note: Hotplug events are rare, so there's no sense in being precise.
+  if (isChanged) {
+    ++driver->topologyVersion;
+    driver->deviceCache.isValid = SK_FALSE;
+    driver->dummyDevice.endpointCache.isValid = SK_FALSE;
+    for (idx = 0; idx < driver->deviceCount; ++idx) {
+      driver->devices[idx]->endpointCache.isValid = SK_FALSE;
+    }
+  }
+}
+
 static SkDevice skAllocateDeviceIMPL(
   SkDriver                              driver,
   SkUDeviceInfoIMPL*                    pHardwareInfo,
@@ -238,6 +662,14 @@ static SkDevice skAllocateDeviceIMPL(
     driver->devices = pDevices;
   }
 
+  // Make sure the device can be indexed once it's constructed.
+  if (skReserveObjectIndexIMPL(driver->pAllocator, &driver->deviceNumberIndex) != SK_SUCCESS) {
+    return NULL;
+  }
+  if (skReserveObjectIndexIMPL(driver->pAllocator, &driver->deviceUuidIndex) != SK_SUCCESS) {
+    return NULL;
+  }
+
   // Generate the device identifier for storage
   identifierLength = sprintf(deviceIdentifier, "hw:%u", number);
   if (identifierLength <= 0) {
@@ -285,12 +717,24 @@ static SkDevice skAllocateDeviceIMPL(
   device->endpoints = NULL;
   device->endpointCount = 0;
   device->endpointCapacity = 0;
+  memset(&device->endpointCache, 0, sizeof(SkObjectCacheIMPL));
+  memset(&device->endpointNameIndex, 0, sizeof(SkObjectIndexIMPL));
   device->deviceActive = SK_FALSE;
   device->deviceNumber = number;
 
   // "Claim" the subdevice by incrementing the count
   driver->devices[driver->deviceCount] = device;
   ++driver->deviceCount;
+  skInsertObjectIndexIMPL(
+    &driver->deviceNumberIndex,
+    skHashBytesIMPL(&number, sizeof(number)),
+    device
+  );
+  skInsertObjectIndexIMPL(
+    &driver->deviceUuidIndex,
+    skHashBytesIMPL(device->_iUuid, SK_UUID_SIZE),
+    device
+  );
 
   return device;
 }
@@ -355,6 +799,11 @@ static SkEndpoint skAllocateEndpointIMPL(
     device->endpoints = pEndpoints;
   }
 
+  // Make sure the endpoint can be indexed once it's constructed.
+  if (skReserveObjectIndexIMPL(driver->pAllocator, &device->endpointNameIndex) != SK_SUCCESS) {
+    return NULL;
+  }
+
   // Construct the endpoint implementation object.
   endpointPrefixLength = strlen(device->devicePath);
   endpointPathLength = endpointPrefixLength + strlen(pName) + 1;
@@ -400,10 +849,19 @@ static SkEndpoint skAllocateEndpointIMPL(
   endpoint->streamCapacity = 0;
   endpoint->streamCount = 0;
   endpoint->streams = NULL;
+  memset(&endpoint->capabilities, 0, sizeof(SkEndpointCapabilitiesIMPL));
+  endpoint->configurationCount = 0;
+  endpoint->nextConfiguration = 0;
+  endpoint->pConfigurations = NULL;
 
   // "Claim" the endpoint by incrementing the count
   device->endpoints[device->endpointCount] = endpoint;
   ++device->endpointCount;
+  skInsertObjectIndexIMPL(
+    &device->endpointNameIndex,
+    skHashBytesIMPL(pName, strlen(pName)),
+    endpoint
+  );
 
   return endpoint;
 }
@@ -429,6 +887,8 @@ static void skDestroyEndpointIMPL(
     skCloseStreamIMPL(endpoint->streams[idx]);
   }
   skDeinitializeEndpointBase(endpoint, pAllocator);
+  skFree(pAllocator, endpoint->capabilities.pFormats);
+  skFree(pAllocator, endpoint->pConfigurations);
   skFree(pAllocator, endpoint->streams);
   skFree(pAllocator, endpoint);
 }
@@ -442,6 +902,8 @@ static void skDestroyDeviceIMPL(
     skDestroyEndpointIMPL(device->endpoints[idx], pAllocator);
   }
   skDeinitializeDeviceBase(device, pAllocator);
+  skFree(pAllocator, device->endpointCache.pObjects);
+  skFree(pAllocator, device->endpointNameIndex.pSlots);
   skFree(pAllocator, device->endpoints);
   skFree(pAllocator, device);
 }
@@ -580,7 +1042,7 @@ static SkResult skQueryDeviceFeaturesOrPropertiesIMPL(
       if (!device->endpoints[idx]->endpointActive) {
         continue;
       }
-      result = skQueryControlEndpointFeaturesOrPropertiesIMPL(ctlHandle, device->endpoints[idx], &endpointFeatures, NULL);
+      result = skQueryEndpointFeatures_alsa(device->endpoints[idx], &endpointFeatures);
       if (result == SK_SUCCESS) {
         pFeatures->supportedStreams |= endpointFeatures.supportedStreams;
       }
@@ -610,6 +1072,7 @@ static SkResult SKAPI_CALL skCreateDriver_alsa(
 ) {
   SkDriver driver;
   SkResult result;
+  uint64_t traceTime;
   snd_lib_error_set_handler(&skErrorHandler_alsa);
 
   // Allocate the driver instance
@@ -624,7 +1087,9 @@ static SkResult SKAPI_CALL skCreateDriver_alsa(
   }
 
   // Initialize the different constructs for acquiring device info.
+  traceTime = skBeginStartupTraceEvent();
   result = skCreateUDevIMPL(pAllocator, &driver->udev);
+  skEndStartupTraceEvent(traceTime, "skCreateUDevIMPL", NULL);
   if (result != SK_SUCCESS) {
     skFree(pAllocator, driver);
     return result;
@@ -657,18 +1122,28 @@ static void SKAPI_CALL skDestroyDriver_alsa(
 ) {
   uint32_t idx;
 
+  // Stop monitoring first, so that no callbacks occur during destruction.
+  // Pooled streams must also be closed while their endpoints still exist.
+  skDestroyUDevIMPL(driver->udev, pAllocator);
+  skDestroyPcmStreamPoolsIMPL(driver);
+  skStopPcmQueueThreadsIMPL(driver);
+
   // Note: Because the root device is not dynamically-allocated,
   //       we must iterate over subdevices/endpoints manually here.
   for (idx = 0; idx < driver->deviceCount; ++idx) {
     skDestroyDeviceIMPL(driver->devices[idx], pAllocator);
   }
   skFree(pAllocator, driver->devices);
+  skFree(pAllocator, driver->deviceCache.pObjects);
+  skFree(pAllocator, driver->deviceNumberIndex.pSlots);
+  skFree(pAllocator, driver->deviceUuidIndex.pSlots);
 
   for (idx = 0; idx < driver->dummyDevice.endpointCount; ++idx) {
     skDestroyEndpointIMPL(driver->dummyDevice.endpoints[idx], pAllocator);
   }
   skFree(pAllocator, driver->dummyDevice.endpoints);
-  skDestroyUDevIMPL(driver->udev, pAllocator);
+  skFree(pAllocator, driver->dummyDevice.endpointCache.pObjects);
+  skFree(pAllocator, driver->dummyDevice.endpointNameIndex.pSlots);
 
   // The deinitialize must happen in this order at the very end.
   skDeinitializeDriverBase(driver, pAllocator);
@@ -684,7 +1159,12 @@ static void SKAPI_CALL skGetDriverFeatures_alsa(
   pFeatures->supportedAccessModes =
     SK_ACCESS_BLOCKING_BIT |
     SK_ACCESS_INTERLEAVED_BIT |
-    SK_ACCESS_MEMORY_MAPPED_BIT;
+    SK_ACCESS_MEMORY_MAPPED_BIT |
+    SK_ACCESS_LINKED_BIT |
+    SK_ACCESS_ADAPTIVE_BIT |
+    SK_ACCESS_TIMER_WAKEUP_BIT |
+    SK_ACCESS_AUTO_RECOVER_BIT |
+    SK_ACCESS_ASYNC_BIT;
   pFeatures->supportedStreams =
     SK_STREAM_PCM_READ_BIT | SK_STREAM_PCM_WRITE_BIT |
     SK_STREAM_MIDI_READ_BIT | SK_STREAM_MIDI_WRITE_BIT;
@@ -704,23 +1184,23 @@ static SkUDeviceInfoIMPL* skGetUDeviceByCardInfoFromArrayIMPL(
   return NULL;
 }
 
-static SkResult SKAPI_CALL skEnumerateDriverDevices_alsa(
-  SkDriver                              driver,
-  uint32_t*                             pDeviceCount,
-  SkDevice*                             pDevices
+static SkResult skScanDriverDevicesIMPL(
+  SkDriver                              driver
 ) {
   int card;
-  uint32_t count;
+  uint32_t idx;
   SkResult result;
   SkDevice device;
+  uint64_t traceTime;
   uint32_t hardwareDevices;
   SkUDeviceInfoIMPL* pDeviceInfo;
   SkUDeviceInfoIMPL* pDeviceInfoArray;
 
   // Set all devices to inactive (in case anything was disconnected)
-  for (count = 0; count < driver->deviceCount; ++count) {
-    driver->devices[count]->deviceActive = SK_FALSE;
+  for (idx = 0; idx < driver->deviceCount; ++idx) {
+    driver->devices[idx]->deviceActive = SK_FALSE;
   }
+  driver->deviceCache.objectCount = 0;
 
   // Count and pre-allocate hardware device information
   result = skEnumerateUDevDevicesIMPL(driver->udev, &hardwareDevices, NULL);
@@ -733,6 +1213,7 @@ static SkResult SKAPI_CALL skEnumerateDriverDevices_alsa(
   //       initialize the device UUID. If found, this will be the primary key
   //       for the device. If not found, one will be generated and we will set
   //       a flag that the formal device UUID has not been found.
+  pDeviceInfoArray = NULL;
   if (hardwareDevices) {
     pDeviceInfoArray = skAllocate(
       driver->pAllocator,
@@ -750,8 +1231,8 @@ static SkResult SKAPI_CALL skEnumerateDriverDevices_alsa(
     }
   }
 
-  count = 0;
   card = -1;
+  traceTime = skBeginStartupTraceEvent();
   for(;;) {
 
     // Attempt to open the next card
@@ -790,23 +1271,39 @@ static SkResult SKAPI_CALL skEnumerateDriverDevices_alsa(
     }
     device->deviceActive = SK_TRUE;
 
-    // Populate the enumeration.
-    // Note: This is the only time we can query and build SkDeviceProperties.
-    if (pDevices) {
-      if (*pDeviceCount <= count) {
-        skFree(driver->pAllocator, pDeviceInfoArray);
-        return SK_INCOMPLETE;
-      }
-      pDevices[count] = device;
+    // Add the device to the enumeration cache.
+    result = skPushObjectCacheIMPL(driver->pAllocator, &driver->deviceCache, device);
+    if (result != SK_SUCCESS) {
+      skFree(driver->pAllocator, pDeviceInfoArray);
+      return result;
     }
-    ++count;
   }
+  skEndStartupTraceEvent(traceTime, "snd_card_next", NULL);
 
-  *pDeviceCount = count;
+  driver->deviceCache.isValid = SK_TRUE;
   skFree(driver->pAllocator, pDeviceInfoArray);
   return SK_SUCCESS;
 }
 
+static SkResult SKAPI_CALL skEnumerateDriverDevices_alsa(
+  SkDriver                              driver,
+  uint32_t*                             pDeviceCount,
+  SkDevice*                             pDevices
+) {
+  SkResult result;
+
+  // Only discover the devices again if something has changed.
+  skUpdateTopologyIMPL(driver);
+  if (!driver->deviceCache.isValid) {
+    result = skScanDriverDevicesIMPL(driver);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+
+  return skReadObjectCacheIMPL(&driver->deviceCache, pDeviceCount, (SkObject*)pDevices);
+}
+
 static SkResult skGetUDeviceInfo(
   SkDevice                              device,
   SkUDeviceInfoIMPL*                    pDeviceInfo
@@ -821,6 +1318,7 @@ static SkResult skGetUDeviceInfo(
   if (!driver) {
     return SK_ERROR_SYSTEM_INTERNAL;
   }
+  skUpdateTopologyIMPL(driver);
 
   result = skEnumerateUDevDevicesIMPL(driver->udev, &deviceCount, NULL);
   if (result != SK_SUCCESS) {
@@ -925,131 +1423,138 @@ static SkResult SKAPI_CALL skQueryDeviceProperties_alsa(
   return SK_SUCCESS;
 }
 
-static SkResult SKAPI_CALL skEnumerateDriverEndpoints_alsa(
-  SkDriver                             driver,
-  uint32_t*                             pEndpointCount,
-  SkEndpoint*                           pEndpoints
+static SkResult skScanDriverEndpointHintsIMPL(
+  SkDriver                              driver,
+  char const*                           pInterface,
+  SkStreamFlags                         writeStream,
+  SkStreamFlags                         readStream
 ) {
   void** hint;
   void** hints;
-  uint32_t count;
-  char const* pName;
-  char const* pIoid;
+  char* pName;
+  char* pIoid;
+  SkResult result;
   SkEndpoint endpoint;
+  uint64_t traceTime;
 
-  // Set all of the endpoints to inactive
-  for (count = 0; count < driver->dummyDevice.endpointCount; ++count) {
-    driver->dummyDevice.endpoints[count]->supportedStreams = 0;
-    driver->dummyDevice.endpoints[count]->endpointActive = SK_FALSE;
+  traceTime = skBeginStartupTraceEvent();
+  if (snd_device_name_hint(-1, pInterface, &hints) != 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
   }
-  count = 0;
+  skEndStartupTraceEvent(traceTime, "snd_device_name_hint", pInterface);
 
-  // Find all of the PCM endpoints
-  {
-    if (snd_device_name_hint(-1, "pcm", &hints) != 0) {
-      return SK_ERROR_SYSTEM_INTERNAL;
+  // Note: The strings returned from snd_device_name_get_hint must be freed.
+  result = SK_SUCCESS;
+  for (hint = hints; *hint; ++hint) {
+    pName = snd_device_name_get_hint(*hint, "NAME");
+    if (!pName) {
+      continue;
     }
-    hint = hints;
-
-    while (*hint) {
-      pName = snd_device_name_get_hint(*hint, "NAME");
-      if (!pName) {
-        ++hint;
-        continue;
-      }
 
-      // Get the proper endpoint, if it exists.
-      endpoint = skGetEndpointByNameIMPL(driver, pName);
+    // Get the proper endpoint, if it exists.
+    endpoint = skGetEndpointByNameIMPL(driver, pName);
+    if (!endpoint) {
+      endpoint = skAllocateEndpointIMPL(driver, pName);
       if (!endpoint) {
-        endpoint = skAllocateEndpointIMPL(driver, pName);
-        if (!endpoint) {
-          return SK_ERROR_OUT_OF_HOST_MEMORY;
-        }
+        free(pName);
+        result = SK_ERROR_OUT_OF_HOST_MEMORY;
+        break;
       }
+    }
+    free(pName);
 
-      // Find stream support type
-      pIoid = snd_device_name_get_hint(*hint, "IOID");
-      if (!pIoid || strcmp(pIoid, "Output") == 0) endpoint->supportedStreams |= SK_STREAM_PCM_WRITE_BIT;
-      if (!pIoid || strcmp(pIoid, "Input") == 0) endpoint->supportedStreams |= SK_STREAM_PCM_READ_BIT;
+    // Find stream support type
+    pIoid = snd_device_name_get_hint(*hint, "IOID");
+    if (!pIoid || strcmp(pIoid, "Output") == 0) endpoint->supportedStreams |= writeStream;
+    if (!pIoid || strcmp(pIoid, "Input") == 0) endpoint->supportedStreams |= readStream;
+    free(pIoid);
 
-      // Populate the enumeration
-      if (pEndpoints) {
-        if (*pEndpointCount <= count) {
-          return SK_INCOMPLETE;
-        }
-        pEndpoints[count] = endpoint;
+    // Add the endpoint to the enumeration cache (only once).
+    if (!endpoint->endpointActive) {
+      endpoint->endpointActive = SK_TRUE;
+      result = skPushObjectCacheIMPL(driver->pAllocator, &driver->dummyDevice.endpointCache, endpoint);
+      if (result != SK_SUCCESS) {
+        break;
       }
-      ++count;
-      ++hint;
     }
   }
 
-  // Find all of the MIDI endpoints
-  {
-    if (snd_device_name_hint(-1, "rawmidi", &hints) != 0) {
-      return SK_ERROR_SYSTEM_INTERNAL;
-    }
-    hint = hints;
-
-    while (*hint) {
-      pName = snd_device_name_get_hint(*hint, "NAME");
-      if (!pName) {
-        ++hint;
-        continue;
-      }
+  snd_device_name_free_hint(hints);
+  return result;
+}
 
-      // Get the proper endpoint, if it exists.
-      endpoint = skGetEndpointByNameIMPL(driver, pName);
-      if (!endpoint) {
-        endpoint = skAllocateEndpointIMPL(driver, pName);
-        if (!endpoint) {
-          return SK_ERROR_OUT_OF_HOST_MEMORY;
-        }
-      }
-      endpoint->endpointActive = SK_TRUE;
+static SkResult SKAPI_CALL skEnumerateDriverEndpoints_alsa(
+  SkDriver                             driver,
+  uint32_t*                             pEndpointCount,
+  SkEndpoint*                           pEndpoints
+) {
+  uint32_t idx;
+  SkResult result;
 
-      // Find stream support type
-      pIoid = snd_device_name_get_hint(*hint, "IOID");
-      if (!pIoid || strcmp(pIoid, "Output") == 0) endpoint->supportedStreams |= SK_STREAM_MIDI_WRITE_BIT;
-      if (!pIoid || strcmp(pIoid, "Input") == 0) endpoint->supportedStreams |= SK_STREAM_MIDI_READ_BIT;
+  // Only discover the endpoints again if something has changed.
+  // Note: snd_device_name_hint() has to parse the ALSA configuration, so it
+  //       is by far the most expensive part of enumerating ALSA.
+  skUpdateTopologyIMPL(driver);
+  if (!driver->dummyDevice.endpointCache.isValid) {
 
-      // Populate the enumeration.
-      if (pEndpoints) {
-        if (*pEndpointCount <= count) {
-          return SK_INCOMPLETE;
-        }
-        pEndpoints[count] = endpoint;
-      }
-      ++count;
-      ++hint;
+    // Set all of the endpoints to inactive
+    for (idx = 0; idx < driver->dummyDevice.endpointCount; ++idx) {
+      driver->dummyDevice.endpoints[idx]->supportedStreams = 0;
+      driver->dummyDevice.endpoints[idx]->endpointActive = SK_FALSE;
+    }
+    driver->dummyDevice.endpointCache.objectCount = 0;
+
+    // Find all of the PCM and MIDI endpoints
+    result = skScanDriverEndpointHintsIMPL(
+      driver,
+      "pcm",
+      SK_STREAM_PCM_WRITE_BIT,
+      SK_STREAM_PCM_READ_BIT
+    );
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+    result = skScanDriverEndpointHintsIMPL(
+      driver,
+      "rawmidi",
+      SK_STREAM_MIDI_WRITE_BIT,
+      SK_STREAM_MIDI_READ_BIT
+    );
+    if (result != SK_SUCCESS) {
+      return result;
     }
+    driver->dummyDevice.endpointCache.isValid = SK_TRUE;
   }
 
-  *pEndpointCount = count;
-  return SK_SUCCESS;
+  return skReadObjectCacheIMPL(&driver->dummyDevice.endpointCache, pEndpointCount, (SkObject*)pEndpoints);
 }
 
-static SkResult skEnumerateDeviceEndpointsIMPL_endpoint(
+static SkResult skScanDeviceEndpointsIMPL(
   snd_ctl_t*                            ctlHandle,
-  SkDevice                              device,
-  uint32_t*                             pEndpointCount,
-  SkEndpoint*                           pEndpoints
+  SkDevice                              device
 ) {
   int err;
   int curr;
-  uint32_t count;
+  uint32_t idx;
+  SkResult result;
+  SkDriver driver;
   SkEndpoint endpoint;
   char endpointIdentifier[SND_MAX_IDENTIFIER_SIZE];
 
+  // Set all of the endpoints to inactive
+  driver = skGetDriverIMPL(device);
+  for (idx = 0; idx < device->endpointCount; ++idx) {
+    device->endpoints[idx]->endpointActive = SK_FALSE;
+  }
+  device->endpointCache.objectCount = 0;
+
   // Enumerate the endpoints
   curr = -1;
-  count = 0;
   for (;;) {
 
     // Attempt to get the next endpoint.
     err = snd_ctl_pcm_next_device(ctlHandle, &curr);
     if (err < 0) {
-      snd_ctl_close(ctlHandle);
       return skHandleCtlErrorIMPL(err);
     }
 
@@ -1072,17 +1577,14 @@ static SkResult skEnumerateDeviceEndpointsIMPL_endpoint(
     endpoint->endpointNumber = (uint32_t)curr;
     endpoint->endpointActive = SK_TRUE;
 
-    // Populate the enumeration.
-    if (pEndpoints) {
-      if (*pEndpointCount <= count) {
-        return SK_INCOMPLETE;
-      }
-      pEndpoints[count] = endpoint;
+    // Add the endpoint to the enumeration cache.
+    result = skPushObjectCacheIMPL(driver->pAllocator, &device->endpointCache, endpoint);
+    if (result != SK_SUCCESS) {
+      return result;
     }
-    ++count;
   }
 
-  *pEndpointCount = count;
+  device->endpointCache.isValid = SK_TRUE;
   return SK_SUCCESS;
 }
 
@@ -1093,27 +1595,240 @@ static SkResult SKAPI_CALL skEnumerateDeviceEndpoints_alsa(
 ) {
   int err;
   SkResult result;
+  uint64_t traceTime;
   snd_ctl_t* ctlHandle;
 
-  // Open a handle to the device.
-  err = snd_ctl_open(&ctlHandle, device->deviceIdentifier, SND_CTL_READONLY);
-  if (err < 0) {
-    return skHandleCtlErrorIMPL(err);
-  }
+  // Only discover the endpoints again if something has changed.
+  skUpdateTopologyIMPL(skGetDriverIMPL(device));
+  if (!device->endpointCache.isValid) {
 
-  // Call the proper method for enumerating endpoints.
-  result = skEnumerateDeviceEndpointsIMPL_endpoint(
-    ctlHandle,
-    device,
-    pEndpointCount,
-    pEndpoints
-  );
+    // Open a handle to the device.
+    traceTime = skBeginStartupTraceEvent();
+    err = snd_ctl_open(&ctlHandle, device->deviceIdentifier, SND_CTL_READONLY);
+    if (err < 0) {
+      return skHandleCtlErrorIMPL(err);
+    }
 
-  snd_ctl_close(ctlHandle);
-  return result;
+    // Find all of the endpoints on the device.
+    result = skScanDeviceEndpointsIMPL(ctlHandle, device);
+    snd_ctl_close(ctlHandle);
+    skEndStartupTraceEvent(traceTime, "skEnumerateDeviceEndpoints_alsa", device->deviceIdentifier);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+
+  return skReadObjectCacheIMPL(&device->endpointCache, pEndpointCount, (SkObject*)pEndpoints);
 }
 
-static SkResult SKAPI_CALL skQueryEndpointFeatures_alsa(
+static void SKAPI_PTR skHandleUDevChangeIMPL(
+  void*                                 pUserData
+) {
+  SkDriver driver;
+  driver = pUserData;
+  driver->pfnDeviceChangeCallback(driver->pDeviceChangeUserData, driver);
+}
+
+static SkResult SKAPI_CALL skRegisterDeviceChangeCallback_alsa(
+  SkDriver                              driver,
+  PFN_skDeviceChangeCallback            pfnCallback,
+  void*                                 pUserData
+) {
+  SkResult result;
+
+  // Stop the monitor thread (if any) before changing the callback.
+  // Note: This fails when called from the callback, nothing is changed then.
+  result = skSetUDevChangeCallbackIMPL(driver->udev, NULL, NULL);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  driver->pfnDeviceChangeCallback = pfnCallback;
+  driver->pDeviceChangeUserData = pUserData;
+  if (!pfnCallback) {
+    return SK_SUCCESS;
+  }
+
+  return skSetUDevChangeCallbackIMPL(driver->udev, &skHandleUDevChangeIMPL, driver);
+}
+
+static uint32_t SKAPI_CALL skGetDriverTopologyVersion_alsa(
+  SkDriver                              driver
+) {
+  skUpdateTopologyIMPL(driver);
+  return driver->topologyVersion;
+}
+
+static SkEndpointCapabilitiesIMPL* skGetEndpointCapabilitiesIMPL(
+  SkEndpoint                            endpoint
+) {
+  SkDriver driver;
+  SkEndpointCapabilitiesIMPL* pCapabilities;
+
+  // Anything probed before the last hotplug event may be out-of-date.
+  driver = skGetDriverIMPL(endpoint);
+  skUpdateTopologyIMPL(driver);
+  pCapabilities = &endpoint->capabilities;
+  if (pCapabilities->topologyVersion != driver->topologyVersion) {
+    pCapabilities->topologyVersion = driver->topologyVersion;
+    pCapabilities->hasFeatures = SK_FALSE;
+    pCapabilities->probedStreams = 0;
+    pCapabilities->formatCount = 0;
+  }
+
+  return pCapabilities;
+}
+
+static void skProbePcmFormatIMPL(
+  snd_pcm_t*                            pcmHandle,
+  snd_pcm_hw_params_t*                  hwParams,
+  SkPcmFormatProperties*                pProperties
+) {
+  int dir;
+  uint32_t idx;
+  unsigned int value;
+  snd_pcm_uframes_t frames;
+  static snd_pcm_access_t const accessTypes[] = {
+    SND_PCM_ACCESS_RW_INTERLEAVED,
+    SND_PCM_ACCESS_RW_NONINTERLEAVED,
+    SND_PCM_ACCESS_MMAP_INTERLEAVED,
+    SND_PCM_ACCESS_MMAP_NONINTERLEAVED
+  };
+
+  // Note: The hardware parameters are already restricted to the format.
+  for (idx = 0; idx < sizeof(accessTypes) / sizeof(accessTypes[0]); ++idx) {
+    if (snd_pcm_hw_params_test_access(pcmHandle, hwParams, accessTypes[idx]) == 0) {
+      pProperties->supportedAccessModes |= skConvertFromLocalAccessTypeIMPL(accessTypes[idx], 0);
+    }
+  }
+
+  // Find the configuration space for this format.
+  dir = 0;
+  if (snd_pcm_hw_params_get_rate_min(hwParams, &value, &dir) == 0) {
+    pProperties->minSampleRate = value;
+  }
+  dir = 0;
+  if (snd_pcm_hw_params_get_rate_max(hwParams, &value, &dir) == 0) {
+    pProperties->maxSampleRate = value;
+  }
+  if (snd_pcm_hw_params_get_channels_min(hwParams, &value) == 0) {
+    pProperties->minChannels = value;
+  }
+  if (snd_pcm_hw_params_get_channels_max(hwParams, &value) == 0) {
+    pProperties->maxChannels = value;
+  }
+  dir = 0;
+  if (snd_pcm_hw_params_get_period_size_min(hwParams, &frames, &dir) == 0) {
+    pProperties->minPeriodSamples = (uint32_t)frames;
+  }
+  dir = 0;
+  if (snd_pcm_hw_params_get_period_size_max(hwParams, &frames, &dir) == 0) {
+    pProperties->maxPeriodSamples = (uint32_t)SKMIN(frames, UINT32_MAX);
+  }
+  if (snd_pcm_hw_params_get_buffer_size_min(hwParams, &frames) == 0) {
+    pProperties->minBufferSamples = (uint32_t)frames;
+  }
+  if (snd_pcm_hw_params_get_buffer_size_max(hwParams, &frames) == 0) {
+    pProperties->maxBufferSamples = (uint32_t)SKMIN(frames, UINT32_MAX);
+  }
+}
+
+static SkResult skProbeEndpointPcmStreamIMPL(
+  SkEndpoint                            endpoint,
+  snd_pcm_stream_t                      pcmType
+) {
+  int err;
+  uint32_t idx;
+  uint32_t count;
+  SkDriver driver;
+  SkPcmFormat formatType;
+  snd_pcm_t* pcmHandle;
+  SkStreamFlagBits streamType;
+  snd_pcm_hw_params_t* anyParams;
+  snd_pcm_hw_params_t* hwParams;
+  SkPcmFormatProperties* pProperties;
+  SkEndpointCapabilitiesIMPL* pCapabilities;
+
+  driver = skGetDriverIMPL(endpoint);
+  pCapabilities = &endpoint->capabilities;
+  streamType = skConvertFromLocalPcmStreamTypeIMPL(pcmType);
+
+  // Open the stream without blocking, a busy stream can't be probed right now.
+  err = snd_pcm_open(&pcmHandle, endpoint->endpointIdentifier, pcmType, SND_PCM_NONBLOCK);
+  if (err < 0) {
+    switch (err) {
+      case -EBUSY:
+        // The stream is supported, but it is in-use.
+        return SK_ERROR_BUSY;
+      case -ENOENT:
+      case -ENXIO:
+        // The stream type is not supported, there's nothing to probe.
+        pCapabilities->probedStreams |= streamType;
+        return SK_ERROR_NOT_SUPPORTED;
+      case -EINVAL:
+        // The stream is invalid, and cannot be used.
+        return SK_ERROR_INVALID;
+      default:
+        // Unknown error code!
+        return SK_ERROR_SYSTEM_INTERNAL;
+    }
+  }
+
+  // Allocate the space for every possible format up-front.
+  if (!pCapabilities->pFormats) {
+    pCapabilities->pFormats = skAllocate(
+      driver->pAllocator,
+      sizeof(SkPcmFormatProperties) * SK_MAX_PCM_FORMAT_PROPERTIES_IMPL,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
+    );
+    if (!pCapabilities->pFormats) {
+      snd_pcm_close(pcmHandle);
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+
+  // Forget anything probed for this direction before (e.g. the other direction
+  // failed, so the features are queried again), otherwise it'd be duplicated.
+  count = 0;
+  for (idx = 0; idx < pCapabilities->formatCount; ++idx) {
+    if (pCapabilities->pFormats[idx].streamType != streamType) {
+      pCapabilities->pFormats[count++] = pCapabilities->pFormats[idx];
+    }
+  }
+  pCapabilities->formatCount = count;
+
+  // Get the full configuration space for the stream.
+  snd_pcm_hw_params_alloca(&anyParams);
+  snd_pcm_hw_params_alloca(&hwParams);
+  err = snd_pcm_hw_params_any(pcmHandle, anyParams);
+  if (err < 0) {
+    snd_pcm_close(pcmHandle);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  // Narrow the configuration space down for each of the supported formats.
+  for (formatType = SK_PCM_FORMAT_S8; formatType <= SK_PCM_FORMAT_END_RANGE; ++formatType) {
+    if (pCapabilities->formatCount >= SK_MAX_PCM_FORMAT_PROPERTIES_IMPL) {
+      break;
+    }
+    snd_pcm_hw_params_copy(hwParams, anyParams);
+    if (snd_pcm_hw_params_set_format(pcmHandle, hwParams, skConvertToLocalPcmFormatIMPL(formatType)) < 0) {
+      continue;
+    }
+    pProperties = &pCapabilities->pFormats[pCapabilities->formatCount];
+    memset(pProperties, 0, sizeof(SkPcmFormatProperties));
+    pProperties->streamType = streamType;
+    pProperties->formatType = formatType;
+    skProbePcmFormatIMPL(pcmHandle, hwParams, pProperties);
+    ++pCapabilities->formatCount;
+  }
+
+  snd_pcm_close(pcmHandle);
+  pCapabilities->probedStreams |= streamType;
+  return SK_SUCCESS;
+}
+
+static SkResult skQueryEndpointFeaturesIMPL(
   SkEndpoint                            endpoint,
   SkEndpointFeatures*                   pFeatures
 ) {
@@ -1121,7 +1836,6 @@ static SkResult SKAPI_CALL skQueryEndpointFeatures_alsa(
   SkResult result;
   SkDevice device;
   snd_ctl_t* ctlHandle;
-  snd_pcm_t* pcmHandle;
   snd_pcm_stream_t pcmType;
 
   memset(pFeatures, 0, sizeof(SkEndpointFeatures));
@@ -1147,33 +1861,108 @@ static SkResult SKAPI_CALL skQueryEndpointFeatures_alsa(
     return result;
   }
 
+  // Driver endpoints have no control interface, so they must be opened.
+  // Note: This also probes the formats, since the stream is already open.
   pFeatures->supportedStreams = 0;
   for (pcmType = (snd_pcm_stream_t)0; pcmType <= SND_PCM_STREAM_LAST; ++pcmType) {
-    err = snd_pcm_open(&pcmHandle, endpoint->endpointIdentifier, pcmType, 0);
-    if (err < 0) {
-      switch (err) {
-        case -EBUSY:
-          // The stream is supported, but it is in-use.
-          pFeatures->supportedStreams |= skConvertFromLocalPcmStreamTypeIMPL(pcmType);
-          continue;
-        case -ENOENT:
-          // The stream type is not supported, continue.
-          continue;
-        case -EINVAL:
-          // The stream is invalid, and cannot be used.
-          return SK_ERROR_INVALID;
-        default:
-          // Unknown error code!
-          return SK_ERROR_SYSTEM_INTERNAL;
-      }
+    result = skProbeEndpointPcmStreamIMPL(endpoint, pcmType);
+    switch (result) {
+      case SK_SUCCESS:
+      case SK_ERROR_BUSY:
+        pFeatures->supportedStreams |= skConvertFromLocalPcmStreamTypeIMPL(pcmType);
+        break;
+      case SK_ERROR_NOT_SUPPORTED:
+        break;
+      default:
+        return result;
     }
-    pFeatures->supportedStreams |= skConvertFromLocalPcmStreamTypeIMPL(pcmType);
-    snd_pcm_close(pcmHandle);
   }
 
   return SK_SUCCESS;
 }
 
+static SkResult SKAPI_CALL skQueryEndpointFeatures_alsa(
+  SkEndpoint                            endpoint,
+  SkEndpointFeatures*                   pFeatures
+) {
+  SkResult result;
+  SkEndpointCapabilitiesIMPL* pCapabilities;
+
+  // Only query the features again if something has changed.
+  pCapabilities = skGetEndpointCapabilitiesIMPL(endpoint);
+  if (!pCapabilities->hasFeatures) {
+    result = skQueryEndpointFeaturesIMPL(endpoint, &pCapabilities->features);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+    pCapabilities->hasFeatures = SK_TRUE;
+  }
+
+  memcpy(pFeatures, &pCapabilities->features, sizeof(SkEndpointFeatures));
+  return SK_SUCCESS;
+}
+
+static SkResult SKAPI_CALL skEnumerateEndpointPcmFormats_alsa(
+  SkEndpoint                            endpoint,
+  uint32_t*                             pFormatCount,
+  SkPcmFormatProperties*                pFormats
+) {
+  uint32_t count;
+  SkResult result;
+  SkBool32 isBusy;
+  snd_pcm_stream_t pcmType;
+  SkStreamFlagBits streamType;
+  SkEndpointFeatures features;
+  SkEndpointCapabilitiesIMPL* pCapabilities;
+
+  // Find which directions the endpoint supports (this is also cached).
+  result = skQueryEndpointFeatures_alsa(endpoint, &features);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  pCapabilities = &endpoint->capabilities;
+
+  // Probe any directions which haven't been probed since the last hotplug.
+  isBusy = SK_FALSE;
+  for (pcmType = (snd_pcm_stream_t)0; pcmType <= SND_PCM_STREAM_LAST; ++pcmType) {
+    streamType = skConvertFromLocalPcmStreamTypeIMPL(pcmType);
+    if (!(features.supportedStreams & streamType) || (pCapabilities->probedStreams & streamType)) {
+      continue;
+    }
+    result = skProbeEndpointPcmStreamIMPL(endpoint, pcmType);
+    switch (result) {
+      case SK_SUCCESS:
+      case SK_ERROR_NOT_SUPPORTED:
+        break;
+      case SK_ERROR_BUSY:
+        isBusy = SK_TRUE;
+        break;
+      default:
+        return result;
+    }
+  }
+  if (isBusy) {
+    return SK_ERROR_BUSY;
+  }
+
+  // Return the format count if it's requested.
+  if (!pFormats) {
+    *pFormatCount = pCapabilities->formatCount;
+    return SK_SUCCESS;
+  }
+
+  // Otherwise populate the enumeration.
+  for (count = 0; count < pCapabilities->formatCount; ++count) {
+    if (*pFormatCount <= count) {
+      return SK_INCOMPLETE;
+    }
+    memcpy(&pFormats[count], &pCapabilities->pFormats[count], sizeof(SkPcmFormatProperties));
+  }
+
+  *pFormatCount = count;
+  return SK_SUCCESS;
+}
+
 static SkResult SKAPI_CALL skQueryEndpointProperties_alsa(
   SkEndpoint                            endpoint,
   SkEndpointProperties*                 pProperties
@@ -1240,24 +2029,250 @@ static SkResult SKAPI_CALL skQueryEndpointProperties_alsa(
   return result;
 }
 
+static SkBool32 skIsSamePcmStreamRequestIMPL(
+  SkAlsaPcmStreamRequest const*         pLhs,
+  SkAlsaPcmStreamRequest const*         pRhs
+) {
+  // Note: Compared member-wise, the structures may contain padding.
+  return pLhs->hw.blockingMode == pRhs->hw.blockingMode
+      && pLhs->hw.streamType == pRhs->hw.streamType
+      && pLhs->hw.accessMode == pRhs->hw.accessMode
+      && pLhs->hw.formatType == pRhs->hw.formatType
+      && pLhs->hw.subformatType == pRhs->hw.subformatType
+      && pLhs->hw.channels == pRhs->hw.channels
+      && pLhs->hw.rate == pRhs->hw.rate
+      && pLhs->hw.rateDir == pRhs->hw.rateDir
+      && pLhs->hw.periods == pRhs->hw.periods
+      && pLhs->hw.periodsDir == pRhs->hw.periodsDir
+      && pLhs->hw.periodSize == pRhs->hw.periodSize
+      && pLhs->hw.periodSizeDir == pRhs->hw.periodSizeDir
+      && pLhs->hw.periodTime == pRhs->hw.periodTime
+      && pLhs->hw.periodTimeDir == pRhs->hw.periodTimeDir
+      && pLhs->hw.bufferSize == pRhs->hw.bufferSize
+      && pLhs->hw.bufferTime == pRhs->hw.bufferTime
+      && pLhs->hw.bufferTimeDir == pRhs->hw.bufferTimeDir
+      && pLhs->hw.noPeriodWakeup == pRhs->hw.noPeriodWakeup
+      && pLhs->sw.availMin == pRhs->sw.availMin
+      && pLhs->sw.silenceSize == pRhs->sw.silenceSize
+      && pLhs->sw.silenceThreshold == pRhs->sw.silenceThreshold
+      && pLhs->sw.startThreshold == pRhs->sw.startThreshold
+      && pLhs->sw.stopThreshold == pRhs->sw.stopThreshold;
+}
+
+static SkBool32 skGetPcmConfigurationIMPL(
+  SkEndpoint                            endpoint,
+  SkAlsaPcmStreamRequest const*         pStreamRequest,
+  SkAlsaHardwareParameters*             pHardwareParameters
+) {
+  uint32_t idx;
+  SkBool32 isFound;
+  SkDriver driver;
+
+  // Note: The pool thread may also be requesting streams (if it exists).
+  driver = skGetDriverIMPL(endpoint);
+  isFound = SK_FALSE;
+  if (driver->poolMutex) {
+    skLockMutexPLT(driver->poolMutex);
+  }
+  for (idx = 0; idx < endpoint->configurationCount; ++idx) {
+    if (skIsSamePcmStreamRequestIMPL(&endpoint->pConfigurations[idx].request, pStreamRequest)) {
+      memcpy(pHardwareParameters, &endpoint->pConfigurations[idx].hw, sizeof(SkAlsaHardwareParameters));
+      isFound = SK_TRUE;
+      break;
+    }
+  }
+  if (driver->poolMutex) {
+    skUnlockMutexPLT(driver->poolMutex);
+  }
+
+  return isFound;
+}
+
+static void skSetPcmConfigurationIMPL(
+  SkEndpoint                            endpoint,
+  SkAlsaPcmStreamRequest const*         pStreamRequest,
+  SkAlsaHardwareParameters const*       pHardwareParameters
+) {
+  uint32_t idx;
+  SkDriver driver;
+  SkPcmConfigurationIMPL* pConfiguration;
+
+  driver = skGetDriverIMPL(endpoint);
+  if (driver->poolMutex) {
+    skLockMutexPLT(driver->poolMutex);
+  }
+
+  // Allocate the configurations the first time one is remembered.
+  // Note: The cache is best-effort, so failing to allocate is not an error.
+  if (!endpoint->pConfigurations) {
+    endpoint->pConfigurations = skAllocate(
+      driver->pAllocator,
+      sizeof(SkPcmConfigurationIMPL) * SK_MAX_PCM_CONFIGURATIONS_IMPL,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
+    );
+  }
+  if (endpoint->pConfigurations) {
+
+    // Replace the existing configuration, or the oldest one if full.
+    for (idx = 0; idx < endpoint->configurationCount; ++idx) {
+      if (skIsSamePcmStreamRequestIMPL(&endpoint->pConfigurations[idx].request, pStreamRequest)) {
+        break;
+      }
+    }
+    if (idx == endpoint->configurationCount) {
+      if (endpoint->configurationCount < SK_MAX_PCM_CONFIGURATIONS_IMPL) {
+        ++endpoint->configurationCount;
+      }
+      else {
+        idx = endpoint->nextConfiguration;
+        endpoint->nextConfiguration = (idx + 1) % SK_MAX_PCM_CONFIGURATIONS_IMPL;
+      }
+    }
+    pConfiguration = &endpoint->pConfigurations[idx];
+    memcpy(&pConfiguration->request, pStreamRequest, sizeof(SkAlsaPcmStreamRequest));
+    memcpy(&pConfiguration->hw, pHardwareParameters, sizeof(SkAlsaHardwareParameters));
+  }
+
+  if (driver->poolMutex) {
+    skUnlockMutexPLT(driver->poolMutex);
+  }
+}
+
+#define APPLY_CHECK(call) if ((err = call) < 0) { return err; }
+static int skApplyPcmHardwareParametersIMPL(
+  snd_pcm_t*                            pcmHandle,
+  snd_pcm_hw_params_t*                  hwParams,
+  SkAlsaHardwareParameters const*       pHardwareParameters
+) {
+  int err;
+
+  // Every value is already known, so there is nothing to search for.
+  APPLY_CHECK(snd_pcm_hw_params_any(pcmHandle, hwParams));
+  APPLY_CHECK(snd_pcm_hw_params_set_access(pcmHandle, hwParams, pHardwareParameters->accessMode));
+  APPLY_CHECK(snd_pcm_hw_params_set_format(pcmHandle, hwParams, pHardwareParameters->formatType));
+  APPLY_CHECK(snd_pcm_hw_params_set_subformat(pcmHandle, hwParams, pHardwareParameters->subformatType));
+  APPLY_CHECK(snd_pcm_hw_params_set_channels(pcmHandle, hwParams, pHardwareParameters->channels));
+  APPLY_CHECK(snd_pcm_hw_params_set_rate(pcmHandle, hwParams, pHardwareParameters->rate, pHardwareParameters->rateDir));
+  APPLY_CHECK(snd_pcm_hw_params_set_period_size(pcmHandle, hwParams, pHardwareParameters->periodSize, pHardwareParameters->periodSizeDir));
+  APPLY_CHECK(snd_pcm_hw_params_set_buffer_size(pcmHandle, hwParams, pHardwareParameters->bufferSize));
+  if (pHardwareParameters->noPeriodWakeup) {
+    APPLY_CHECK(snd_pcm_hw_params_set_period_wakeup(pcmHandle, hwParams, 0));
+  }
+
+  return snd_pcm_hw_params(pcmHandle, hwParams);
+}
+#undef APPLY_CHECK
+
+#define NEGOTIATE_CHECK(call) if ((err = call) < 0) { return err; }
+static int skNegotiatePcmHardwareParametersIMPL(
+  snd_pcm_t*                            pcmHandle,
+  snd_pcm_hw_params_t*                  hwParams,
+  SkAlsaPcmStreamRequest*               pStreamRequest
+) {
+  int err;
+  int minimumPeriodsDir;
+  unsigned int minimumPeriods;
+
+  // As-per standard, a "zero" value means "any". Drivers only need to handle
+  // values that they understand, so any unhandled values here is fine.
+  NEGOTIATE_CHECK(snd_pcm_hw_params_any(pcmHandle, hwParams));
+  // Format (Default = First)
+  if (pStreamRequest->hw.formatType != SND_PCM_FORMAT_ANY) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_format(pcmHandle, hwParams, pStreamRequest->hw.formatType));
+  }
+
+  // Subformat Type (Default = First)
+  if (pStreamRequest->hw.subformatType != SND_PCM_SUBFORMAT_ANY) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_subformat(pcmHandle, hwParams, pStreamRequest->hw.subformatType));
+  }
+
+  // Access Type (Default = First)
+  if (pStreamRequest->hw.accessMode != SND_PCM_ACCESS_ANY) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_access(pcmHandle, hwParams, pStreamRequest->hw.accessMode));
+  }
+
+  // Channels (Default = Minimum)
+  if (pStreamRequest->hw.channels) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_channels_near(pcmHandle, hwParams, &pStreamRequest->hw.channels));
+  }
+
+  // Sample Rate (Default = Minimum)
+  if (pStreamRequest->hw.rate) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_rate_near(pcmHandle, hwParams, &pStreamRequest->hw.rate, &pStreamRequest->hw.rateDir));
+  }
+
+  // Configure minimum period size
+  // Note: Period size of 2 is the minimum sensible size, because a period
+  //       represents the current subset of a buffer being processed. If there
+  //       is only 1 period, then we would immediately XRUN because another
+  //       period worth of samples is not available to play.
+  minimumPeriods = 2;
+  minimumPeriodsDir = 0;
+  NEGOTIATE_CHECK(snd_pcm_hw_params_set_periods_min(pcmHandle, hwParams, &minimumPeriods, &minimumPeriodsDir));
+
+  // Periods (Default = Maximum)
+  if (pStreamRequest->hw.periods) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_periods_near(pcmHandle, hwParams, &pStreamRequest->hw.periods, &pStreamRequest->hw.periodsDir));
+  }
+
+  // Force periods to be an integer value.
+  NEGOTIATE_CHECK(snd_pcm_hw_params_set_periods_integer(pcmHandle, hwParams));
+
+  // Period Time (Default = Maximum)
+  if (pStreamRequest->hw.periodTime) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_period_time_near(pcmHandle, hwParams, &pStreamRequest->hw.periodTime, &pStreamRequest->hw.periodTimeDir));
+  }
+
+  // Buffer Time (Default = Maximum)
+  if (pStreamRequest->hw.bufferTime) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_buffer_time_near(pcmHandle, hwParams, &pStreamRequest->hw.bufferTime, &pStreamRequest->hw.bufferTimeDir));
+  }
+
+  // Period Size (Default = Maximum)
+  if (pStreamRequest->hw.periodSize) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_period_size_near(pcmHandle, hwParams, &pStreamRequest->hw.periodSize, &pStreamRequest->hw.periodSizeDir));
+  }
+
+  // Buffer Size (Default = Maximum)
+  if (pStreamRequest->hw.bufferSize) {
+    NEGOTIATE_CHECK(snd_pcm_hw_params_set_buffer_size_near(pcmHandle, hwParams, &pStreamRequest->hw.bufferSize));
+  }
+
+  // Period Wakeups (Default = Enabled)
+  // Note: Not every device can disable these, in which case they stay enabled.
+  if (pStreamRequest->hw.noPeriodWakeup) {
+    if (!pStreamRequest->hw.bufferSize) {
+      NEGOTIATE_CHECK(snd_pcm_hw_params_set_buffer_size_last(pcmHandle, hwParams, &pStreamRequest->hw.bufferSize));
+    }
+    (void)snd_pcm_hw_params_set_period_wakeup(pcmHandle, hwParams, 0);
+  }
+
+  // Apply the hardware parameters and see if the configuration sticks.
+  return snd_pcm_hw_params(pcmHandle, hwParams);
+}
+#undef NEGOTIATE_CHECK
+
 #define ALSA_CHECK(call) if ((err = call) < 0) { snd_pcm_close(pcmHandle); return SK_ERROR_NOT_SUPPORTED; }
 #define EXPT_CHECK(call) if ((err = call) < 0) { snd_pcm_close(pcmHandle); return SK_ERROR_SYSTEM_INTERNAL; }
-static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
+// Note: This may be called from the pool thread, so it must never allocate
+//       through the driver's allocator (see skCreateOpenedPcmStreamIMPL).
+static SkResult skOpenPcmStreamIMPL(
   SkEndpoint                            endpoint,
   SkAlsaPcmStreamRequest*               pStreamRequest,
-  SkPcmStream*                          pStream
+  SkPcmOpenedStreamIMPL*                pOpenedStream
 ) {
   int err;
-  SkResult result;
   snd_pcm_t* pcmHandle;
-  int minimumPeriodsDir;
-  unsigned int minimumPeriods;
+  SkBool32 isCached;
+  unsigned int periodWakeup;
+  snd_pcm_uframes_t bufferSize;
   snd_pcm_hw_params_t* hwParams;
   snd_pcm_sw_params_t* swParams;
   SkPcmStreamInfo streamInfo;
+  SkAlsaPcmStreamRequest originalRequest;
+  SkAlsaHardwareParameters negotiatedParams;
   SkAlsaPcmStreamInfo icdStreamInfo;
-  SkPcmStreamCreateInfo createInfo;
-  SkPcmStreamUserDataIMPL userData;
 
   //----------------------------------------------------------------------------
   // Check all of the request values to make sure they make sense.
@@ -1283,76 +2298,18 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
 
   //----------------------------------------------------------------------------
   // Consume and configure the hardware parameters from the request values.
-  // As-per standard, a "zero" value means "any". Drivers only need to handle
-  // values that they understand, so any unhandled values here is fine.
+  // If this request has been negotiated before, the result is applied as-is.
+  // Otherwise (or if the result no longer applies) negotiate from scratch.
   //----------------------------------------------------------------------------
   snd_pcm_hw_params_alloca(&hwParams);
-  ALSA_CHECK(snd_pcm_hw_params_any(pcmHandle, hwParams));
-  {
-    // Format (Default = First)
-    if (pStreamRequest->hw.formatType != SND_PCM_FORMAT_ANY) {
-      ALSA_CHECK(snd_pcm_hw_params_set_format(pcmHandle, hwParams, pStreamRequest->hw.formatType));
-    }
-
-    // Subformat Type (Default = First)
-    if (pStreamRequest->hw.subformatType != SND_PCM_SUBFORMAT_ANY) {
-      ALSA_CHECK(snd_pcm_hw_params_set_subformat(pcmHandle, hwParams, pStreamRequest->hw.subformatType));
-    }
-
-    // Access Type (Default = First)
-    if (pStreamRequest->hw.accessMode != SND_PCM_ACCESS_ANY) {
-      ALSA_CHECK(snd_pcm_hw_params_set_access(pcmHandle, hwParams, pStreamRequest->hw.accessMode));
-    }
-
-    // Channels (Default = Minimum)
-    if (pStreamRequest->hw.channels) {
-      ALSA_CHECK(snd_pcm_hw_params_set_channels_near(pcmHandle, hwParams, &pStreamRequest->hw.channels));
-    }
-
-    // Sample Rate (Default = Minimum)
-    if (pStreamRequest->hw.rate) {
-      ALSA_CHECK(snd_pcm_hw_params_set_rate_near(pcmHandle, hwParams, &pStreamRequest->hw.rate, &pStreamRequest->hw.rateDir));
-    }
-
-    // Configure minimum period size
-    // Note: Period size of 2 is the minimum sensible size, because a period
-    //       represents the current subset of a buffer being processed. If there
-    //       is only 1 period, then we would immediately XRUN because another
-    //       period worth of samples is not available to play.
-    minimumPeriods = 2;
-    minimumPeriodsDir = 0;
-    ALSA_CHECK(snd_pcm_hw_params_set_periods_min(pcmHandle, hwParams, &minimumPeriods, &minimumPeriodsDir));
-
-    // Periods (Default = Maximum)
-    if (pStreamRequest->hw.periods) {
-      ALSA_CHECK(snd_pcm_hw_params_set_periods_near(pcmHandle, hwParams, &pStreamRequest->hw.periods, &pStreamRequest->hw.periodsDir));
-    }
-
-    // Force periods to be an integer value.
-    ALSA_CHECK(snd_pcm_hw_params_set_periods_integer(pcmHandle, hwParams));
-
-    // Period Time (Default = Maximum)
-    if (pStreamRequest->hw.periodTime) {
-      ALSA_CHECK(snd_pcm_hw_params_set_period_time_near(pcmHandle, hwParams, &pStreamRequest->hw.periodTime, &pStreamRequest->hw.periodTimeDir));
-    }
-
-    // Buffer Time (Default = Maximum)
-    if (pStreamRequest->hw.bufferTime) {
-      ALSA_CHECK(snd_pcm_hw_params_set_buffer_time_near(pcmHandle, hwParams, &pStreamRequest->hw.bufferTime, &pStreamRequest->hw.bufferTimeDir));
-    }
-
-    // Period Size (Default = Maximum)
-    if (pStreamRequest->hw.periodSize) {
-      ALSA_CHECK(snd_pcm_hw_params_set_period_size_near(pcmHandle, hwParams, &pStreamRequest->hw.periodSize, &pStreamRequest->hw.periodSizeDir));
-    }
-
-    // Buffer Size (Default = Maximum)
-    if (pStreamRequest->hw.bufferSize) {
-      ALSA_CHECK(snd_pcm_hw_params_set_buffer_size_near(pcmHandle, hwParams, &pStreamRequest->hw.bufferSize));
-    }
-
-    // Apply the hardware parameters and see if the configuration sticks.
-    err = snd_pcm_hw_params(pcmHandle, hwParams);
+  isCached = SK_FALSE;
+  if (skGetPcmConfigurationIMPL(endpoint, pStreamRequest, &negotiatedParams)) {
+    err = skApplyPcmHardwareParametersIMPL(pcmHandle, hwParams, &negotiatedParams);
+    isCached = (err >= 0);
+  }
+  if (!isCached) {
+    memcpy(&originalRequest, pStreamRequest, sizeof(SkAlsaPcmStreamRequest));
+    err = skNegotiatePcmHardwareParametersIMPL(pcmHandle, hwParams, pStreamRequest);
     if (err < 0) {
       snd_pcm_close(pcmHandle);
       return SK_ERROR_NOT_SUPPORTED;
@@ -1392,6 +2349,16 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
       ALSA_CHECK(snd_pcm_sw_params_set_stop_threshold(pcmHandle, swParams, pStreamRequest->sw.stopThreshold));
     }
 
+    // Without period wakeups, refill most of the buffer on each timer wakeup.
+    ALSA_CHECK(snd_pcm_hw_params_get_period_wakeup(pcmHandle, hwParams, &periodWakeup));
+    if (!periodWakeup) {
+      ALSA_CHECK(snd_pcm_sw_params_set_period_event(pcmHandle, swParams, 0));
+      if (!pStreamRequest->sw.availMin) {
+        ALSA_CHECK(snd_pcm_hw_params_get_buffer_size(hwParams, &bufferSize));
+        ALSA_CHECK(snd_pcm_sw_params_set_avail_min(pcmHandle, swParams, bufferSize - bufferSize / 4));
+      }
+    }
+
     // Apply the software parameters and see if the configuration sticks.
     err = snd_pcm_sw_params(pcmHandle, swParams);
     if (err < 0) {
@@ -1421,6 +2388,7 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
     EXPT_CHECK(snd_pcm_hw_params_get_period_time(hwParams, &icdStreamInfo.hw.periodTime, &icdStreamInfo.hw.periodTimeDir));
     EXPT_CHECK(snd_pcm_hw_params_get_buffer_size(hwParams, &icdStreamInfo.hw.bufferSize));
     EXPT_CHECK(snd_pcm_hw_params_get_buffer_time(hwParams, &icdStreamInfo.hw.bufferTime, &icdStreamInfo.hw.bufferTimeDir));
+    icdStreamInfo.hw.noPeriodWakeup = !periodWakeup;
 
     // Software Parameters
     EXPT_CHECK(snd_pcm_sw_params_get_avail_min(swParams, &icdStreamInfo.sw.availMin));
@@ -1439,6 +2407,9 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
     streamInfo.pNext = NULL;
     streamInfo.streamType = skConvertFromLocalPcmStreamTypeIMPL(icdStreamInfo.hw.streamType);
     streamInfo.accessFlags = skConvertFromLocalAccessTypeIMPL(icdStreamInfo.hw.accessMode, icdStreamInfo.hw.blockingMode);
+    if (icdStreamInfo.hw.noPeriodWakeup && streamInfo.accessFlags != SK_ACCESS_FLAG_BITS_MAX_ENUM) {
+      streamInfo.accessFlags |= SK_ACCESS_TIMER_WAKEUP_BIT;
+    }
     streamInfo.formatType = skConvertFromLocalPcmFormatIMPL(icdStreamInfo.hw.formatType);
     streamInfo.formatBits = (uint32_t)snd_pcm_format_physical_width(icdStreamInfo.hw.formatType);
     streamInfo.sampleRate = icdStreamInfo.hw.rate;
@@ -1463,6 +2434,43 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
     return SK_ERROR_NOT_SUPPORTED;
   }
 
+  pOpenedStream->pcmHandle = pcmHandle;
+  pOpenedStream->isCached = isCached;
+  if (!isCached) {
+    memcpy(&pOpenedStream->originalRequest, &originalRequest, sizeof(SkAlsaPcmStreamRequest));
+  }
+  memcpy(&pOpenedStream->streamInfo, &streamInfo, sizeof(SkPcmStreamInfo));
+  memcpy(&pOpenedStream->icdStreamInfo, &icdStreamInfo, sizeof(SkAlsaPcmStreamInfo));
+  return SK_SUCCESS;
+}
+
+// Note: Must be called from the application's thread, since it allocates.
+//       The handle is closed if the stream cannot be created.
+static SkResult skCreateOpenedPcmStreamIMPL(
+  SkEndpoint                            endpoint,
+  SkPcmOpenedStreamIMPL*                pOpenedStream,
+  SkPcmStream*                          pStream
+) {
+  int err;
+  SkResult result;
+  snd_pcm_t* pcmHandle;
+  snd_pcm_hw_params_t* hwParams;
+  snd_pcm_sw_params_t* swParams;
+  SkPcmStreamCreateInfo createInfo;
+  SkPcmStreamUserDataIMPL userData;
+
+  // Remember the negotiated result so the next identical request can skip it.
+  if (!pOpenedStream->isCached) {
+    skSetPcmConfigurationIMPL(endpoint, &pOpenedStream->originalRequest, &pOpenedStream->icdStreamInfo.hw);
+  }
+
+  // The parameters aren't kept while the handle waits, so query them again.
+  pcmHandle = pOpenedStream->pcmHandle;
+  snd_pcm_hw_params_alloca(&hwParams);
+  snd_pcm_sw_params_alloca(&swParams);
+  EXPT_CHECK(snd_pcm_hw_params_current(pcmHandle, hwParams));
+  EXPT_CHECK(snd_pcm_sw_params_current(pcmHandle, swParams));
+
   //----------------------------------------------------------------------------
   // Success! Create the ALSA PCM stream!
   //----------------------------------------------------------------------------
@@ -1473,8 +2481,8 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
   userData.hwParams = hwParams;
   userData.swParams = swParams;
   userData.pcmHandle = pcmHandle;
-  userData.pStreamInfo = &streamInfo;
-  userData.pIcdStreamInfo = &icdStreamInfo;
+  userData.pStreamInfo = &pOpenedStream->streamInfo;
+  userData.pIcdStreamInfo = &pOpenedStream->icdStreamInfo;
   result = skCreatePcmStream(
     endpoint,
     &createInfo,
@@ -1488,6 +2496,23 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
   return result;
 }
 #undef ALSA_CHECK
+#undef EXPT_CHECK
+
+static SkResult SKAPI_CALL skRequestPcmStream_alsaIMPL(
+  SkEndpoint                            endpoint,
+  SkAlsaPcmStreamRequest*               pStreamRequest,
+  SkPcmStream*                          pStream
+) {
+  SkResult result;
+  SkPcmOpenedStreamIMPL openedStream;
+
+  result = skOpenPcmStreamIMPL(endpoint, pStreamRequest, &openedStream);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+
+  return skCreateOpenedPcmStreamIMPL(endpoint, &openedStream, pStream);
+}
 
 static SkResult skConvertToLocalPcmRequestIMPL(
   SkPcmStreamRequest const*             pStreamRequest,
@@ -1541,6 +2566,46 @@ static SkResult skConvertToLocalPcmRequestIMPL(
       originalAccessFlags &= ~SK_ACCESS_MEMORY_MAPPED_BIT;
     }
 
+    // Linking is handled once both streams exist (see skJoinPcmStreamIMPL).
+    originalAccessFlags &= ~SK_ACCESS_LINKED_BIT;
+
+    // Timer-scheduled streams don't wake every period (see skWaitPcmStreamTimerIMPL).
+    // Note: A blocking read or write would wait on the device, which never
+    //       wakes it without period wakeups, so the two can't be combined.
+    if (originalAccessFlags & SK_ACCESS_TIMER_WAKEUP_BIT) {
+      if (pStreamRequest->accessFlags & SK_ACCESS_BLOCKING_BIT) {
+        return SK_ERROR_NOT_SUPPORTED;
+      }
+      pIcdStreamRequest->hw.noPeriodWakeup = 1;
+      originalAccessFlags &= ~SK_ACCESS_TIMER_WAKEUP_BIT;
+    }
+
+    // Recovery is handled by the stream (see skAutoRecoverPcmStreamIMPL).
+    originalAccessFlags &= ~SK_ACCESS_AUTO_RECOVER_BIT;
+
+    // Queueing is handled once the stream exists (see skStartPcmStreamQueueIMPL).
+    // Note: Only interleaved playback can be queued, capture is always pulled.
+    //       The service threads wait on the device, which never wakes them
+    //       for timer-scheduled streams.
+    if (originalAccessFlags & SK_ACCESS_ASYNC_BIT) {
+      if (pStreamRequest->streamType != SK_STREAM_PCM_WRITE_BIT ||
+          !(pStreamRequest->accessFlags & SK_ACCESS_INTERLEAVED_BIT) ||
+          (pStreamRequest->accessFlags & SK_ACCESS_TIMER_WAKEUP_BIT)) {
+        return SK_ERROR_NOT_SUPPORTED;
+      }
+      originalAccessFlags &= ~SK_ACCESS_ASYNC_BIT;
+    }
+
+    // Adaptive streams start from the smallest period the hardware allows,
+    // unless a period was already requested.
+    // Note: The depth is configured once the stream exists (see skEnableAdaptiveBufferingIMPL).
+    if (originalAccessFlags & SK_ACCESS_ADAPTIVE_BIT) {
+      if (!pIcdStreamRequest->hw.periodSize && !pIcdStreamRequest->hw.periodTime) {
+        pIcdStreamRequest->hw.periodSize = 1;
+      }
+      originalAccessFlags &= ~SK_ACCESS_ADAPTIVE_BIT;
+    }
+
     // Check that the entire access flag was consumed and handled
     if (originalAccessFlags) {
       return SK_ERROR_NOT_SUPPORTED;
@@ -1593,9 +2658,305 @@ static SkResult skConvertToLocalPcmRequestIMPL(
   return SK_SUCCESS;
 }
 
+static SkAccessFlags skGetPcmStreamRequestAccessFlagsIMPL(
+  SkPcmStreamRequest const*             pStreamRequest
+) {
+  // Note: ICD requests are already translated, so they carry no access flags.
+  switch (pStreamRequest->sType) {
+    case SK_STRUCTURE_TYPE_PCM_STREAM_REQUEST:
+      return pStreamRequest->accessFlags;
+    default:
+      return 0;
+  }
+}
+
+static SkResult skConvertPcmStreamRequestIMPL(
+  SkPcmStreamRequest const*             pStreamRequest,
+  SkAlsaPcmStreamRequest*               pIcdStreamRequest
+) {
+  switch (pStreamRequest->sType) {
+    case SK_STRUCTURE_TYPE_PCM_STREAM_REQUEST:
+      return skConvertToLocalPcmRequestIMPL(pStreamRequest, pIcdStreamRequest);
+    case SK_STRUCTURE_TYPE_ICD_PCM_STREAM_REQUEST:
+      memcpy(pIcdStreamRequest, pStreamRequest, sizeof(SkAlsaPcmStreamRequest));
+      pIcdStreamRequest->pNext = NULL;
+      return SK_SUCCESS;
+    default:
+      return SK_ERROR_INVALID;
+  }
+}
+
+static SkPcmStreamPoolIMPL* skGetPcmStreamPoolIMPL(
+  SkDriver                              driver,
+  SkEndpoint                            endpoint,
+  SkAlsaPcmStreamRequest const*         pRequest
+) {
+  SkPcmStreamPoolIMPL* pPool;
+  for (pPool = driver->pStreamPools; pPool; pPool = pPool->pNext) {
+    if (pPool->endpoint == endpoint && skIsSamePcmStreamRequestIMPL(&pPool->request, pRequest)) {
+      return pPool;
+    }
+  }
+  return NULL;
+}
+
+static void SKAPI_PTR skRunPcmStreamPoolIMPL(
+  void*                                 pUserData
+) {
+  SkResult result;
+  SkDriver driver;
+  SkEndpoint endpoint;
+  SkPcmStreamPoolIMPL* pPool;
+  SkAlsaPcmStreamRequest request;
+  SkPcmOpenedStreamIMPL openedStream;
+
+  driver = pUserData;
+  skLockMutexPLT(driver->poolMutex);
+  while (!driver->isPoolStopping) {
+
+    // Find a pool which is missing streams.
+    for (pPool = driver->pStreamPools; pPool; pPool = pPool->pNext) {
+      if (!pPool->isFailing && pPool->streamCount < pPool->targetCount) {
+        break;
+      }
+    }
+    if (!pPool) {
+      skWaitConditionPLT(driver->poolCondition, driver->poolMutex);
+      continue;
+    }
+
+    // Open the stream without holding the lock, this is the slow part.
+    // Note: The request is copied, because the negotiated values are written back.
+    //       Only the handle is opened here, the stream object is allocated by
+    //       the application's thread once it's acquired, since the allocator
+    //       isn't required to be thread-safe.
+    endpoint = pPool->endpoint;
+    memcpy(&request, &pPool->request, sizeof(SkAlsaPcmStreamRequest));
+    skUnlockMutexPLT(driver->poolMutex);
+    result = skOpenPcmStreamIMPL(endpoint, &request, &openedStream);
+    skLockMutexPLT(driver->poolMutex);
+
+    // If the stream can't be opened (commonly because the endpoint is busy),
+    // stop trying until the next time the pool is used or configured.
+    if (result != SK_SUCCESS) {
+      pPool->isFailing = SK_TRUE;
+      continue;
+    }
+
+    // The pool may have shrunk while the lock was released.
+    if (driver->isPoolStopping || pPool->streamCount >= pPool->targetCount) {
+      skUnlockMutexPLT(driver->poolMutex);
+      snd_pcm_close(openedStream.pcmHandle);
+      skLockMutexPLT(driver->poolMutex);
+      continue;
+    }
+    memcpy(&pPool->streams[pPool->streamCount], &openedStream, sizeof(SkPcmOpenedStreamIMPL));
+    ++pPool->streamCount;
+  }
+  skUnlockMutexPLT(driver->poolMutex);
+}
+
+static SkBool32 skAcquirePooledPcmStreamIMPL(
+  SkEndpoint                            endpoint,
+  SkAlsaPcmStreamRequest const*         pRequest,
+  SkPcmStream*                          pStream
+) {
+  SkResult result;
+  SkDriver driver;
+  snd_pcm_state_t state;
+  SkPcmStreamPoolIMPL* pPool;
+  SkPcmOpenedStreamIMPL openedStream;
+
+  // Early-out: Pools are opt-in, most drivers will never have any.
+  // Note: The mutex is only ever created on the application's thread.
+  driver = skGetDriverIMPL(endpoint);
+  if (!driver->poolMutex) {
+    return SK_FALSE;
+  }
+
+  for (;;) {
+    skLockMutexPLT(driver->poolMutex);
+    pPool = skGetPcmStreamPoolIMPL(driver, endpoint, pRequest);
+    if (!pPool) {
+      skUnlockMutexPLT(driver->poolMutex);
+      return SK_FALSE;
+    }
+
+    // Take the newest stream, and let the pool thread know to replace it.
+    pPool->isFailing = SK_FALSE;
+    skSignalConditionPLT(driver->poolCondition);
+    if (!pPool->streamCount) {
+      skUnlockMutexPLT(driver->poolMutex);
+      return SK_FALSE;
+    }
+    --pPool->streamCount;
+    memcpy(&openedStream, &pPool->streams[pPool->streamCount], sizeof(SkPcmOpenedStreamIMPL));
+    skUnlockMutexPLT(driver->poolMutex);
+
+    // A pooled stream may have been disconnected since it was opened.
+    state = snd_pcm_state(openedStream.pcmHandle);
+    if (state != SND_PCM_STATE_PREPARED) {
+      snd_pcm_close(openedStream.pcmHandle);
+      continue;
+    }
+
+    // Note: If the stream can't be created, the request is opened as usual.
+    result = skCreateOpenedPcmStreamIMPL(endpoint, &openedStream, pStream);
+    return (result == SK_SUCCESS);
+  }
+}
+
+static void skDestroyPcmStreamPoolsIMPL(
+  SkDriver                              driver
+) {
+  uint32_t idx;
+  SkPcmStreamPoolIMPL* pPool;
+
+  // Stop the pool thread (if one was ever started).
+  if (driver->poolThread) {
+    skLockMutexPLT(driver->poolMutex);
+    driver->isPoolStopping = SK_TRUE;
+    skBroadcastConditionPLT(driver->poolCondition);
+    skUnlockMutexPLT(driver->poolMutex);
+    skJoinThreadPLT(driver->pAllocator, driver->poolThread);
+    driver->poolThread = NULL;
+  }
+
+  // Close all of the streams which were never handed out.
+  while (driver->pStreamPools) {
+    pPool = driver->pStreamPools;
+    driver->pStreamPools = pPool->pNext;
+    for (idx = 0; idx < pPool->streamCount; ++idx) {
+      snd_pcm_close(pPool->streams[idx].pcmHandle);
+    }
+    skFree(driver->pAllocator, pPool);
+  }
+
+  if (driver->poolCondition) {
+    skDestroyConditionPLT(driver->pAllocator, driver->poolCondition);
+    driver->poolCondition = NULL;
+  }
+  if (driver->poolMutex) {
+    skDestroyMutexPLT(driver->pAllocator, driver->poolMutex);
+    driver->poolMutex = NULL;
+  }
+}
+
+static SkResult skStartPcmStreamPoolIMPL(
+  SkDriver                              driver
+) {
+  SkResult result;
+
+  // Note: Only called from the application's thread, before any pools exist.
+  if (!driver->poolMutex) {
+    result = skCreateMutexPLT(driver->pAllocator, SK_SYSTEM_ALLOCATION_SCOPE_DRIVER, &driver->poolMutex);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+  if (!driver->poolCondition) {
+    result = skCreateConditionPLT(driver->pAllocator, SK_SYSTEM_ALLOCATION_SCOPE_DRIVER, &driver->poolCondition);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+  if (!driver->poolThread) {
+    result = skCreateThreadPLT(
+      driver->pAllocator,
+      &skRunPcmStreamPoolIMPL,
+      driver,
+      &driver->poolThread
+    );
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+
+  return SK_SUCCESS;
+}
+
+static SkResult SKAPI_CALL skConfigurePcmStreamPool_alsa(
+  SkEndpoint                            endpoint,
+  SkPcmStreamRequest const*             pStreamRequest,
+  uint32_t                              streamCount
+) {
+  uint32_t idx;
+  uint32_t closeCount;
+  SkResult result;
+  SkDriver driver;
+  SkPcmStreamPoolIMPL* pPool;
+  SkAlsaPcmStreamRequest request;
+  snd_pcm_t* closeHandles[SK_MAX_POOLED_PCM_STREAMS_IMPL];
+
+  // Check the request, duplex requests are pooled one direction at a time.
+  if (streamCount > SK_MAX_POOLED_PCM_STREAMS_IMPL) {
+    return SK_ERROR_INVALID;
+  }
+  result = skConvertPcmStreamRequestIMPL(pStreamRequest, &request);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  if (request.hw.periods == 1) {
+    return SK_ERROR_INVALID;
+  }
+
+  // Nothing needs to be started to disable a pool which doesn't exist.
+  driver = skGetDriverIMPL(endpoint);
+  if (!streamCount && !driver->pStreamPools) {
+    return SK_SUCCESS;
+  }
+  result = skStartPcmStreamPoolIMPL(driver);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+
+  // Find (or create) the pool for the request.
+  skLockMutexPLT(driver->poolMutex);
+  pPool = skGetPcmStreamPoolIMPL(driver, endpoint, &request);
+  if (!pPool) {
+    if (!streamCount) {
+      skUnlockMutexPLT(driver->poolMutex);
+      return SK_SUCCESS;
+    }
+    pPool = skClearAllocate(
+      driver->pAllocator,
+      sizeof(SkPcmStreamPoolIMPL),
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
+    );
+    if (!pPool) {
+      skUnlockMutexPLT(driver->poolMutex);
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    pPool->endpoint = endpoint;
+    memcpy(&pPool->request, &request, sizeof(SkAlsaPcmStreamRequest));
+    pPool->pNext = driver->pStreamPools;
+    driver->pStreamPools = pPool;
+  }
+
+  // Resize the pool, the thread will open any additional streams.
+  closeCount = 0;
+  pPool->targetCount = streamCount;
+  pPool->isFailing = SK_FALSE;
+  while (pPool->streamCount > pPool->targetCount) {
+    --pPool->streamCount;
+    closeHandles[closeCount] = pPool->streams[pPool->streamCount].pcmHandle;
+    ++closeCount;
+  }
+  skSignalConditionPLT(driver->poolCondition);
+  skUnlockMutexPLT(driver->poolMutex);
+
+  for (idx = 0; idx < closeCount; ++idx) {
+    snd_pcm_close(closeHandles[idx]);
+  }
+
+  return SK_SUCCESS;
+}
+
 static SkResult skJoinPcmStreamIMPL(
   SkPcmStream                           readStream,
   SkPcmStream                           writeStream,
+  SkBool32                              isLinkRequired,
   SkPcmStream*                          pStream
 ) {
   int err;
@@ -1624,20 +2985,30 @@ static SkResult skJoinPcmStreamIMPL(
     return SK_ERROR_SYSTEM_INTERNAL;
   }
 
+  // Attempt to form a hardware-synchronization between the streams.
+  // Note: Not every pair of streams can be linked (e.g. across sound cards).
+  //       Unless linking was required, the streams are started one after the
+  //       other instead, which is reported by SK_ACCESS_LINKED_BIT missing.
+  err = snd_pcm_link(
+    readStream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle,
+    writeStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle
+  );
+  if (err < 0 && isLinkRequired) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
   // Join the stream into one
   readStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL] =
     writeStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+  readStream->isLinked = (err >= 0);
+  if (readStream->isLinked) {
+    readStream->data[SK_PCM_STREAM_READ_INDEX_IMPL].streamInfo.accessFlags |= SK_ACCESS_LINKED_BIT;
+    readStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].streamInfo.accessFlags |= SK_ACCESS_LINKED_BIT;
+  }
   skDeinitializePcmStreamBase(writeStream, driver->pAllocator);
   skFree(driver->pAllocator, writeStream);
 
-  // Attempt to form a hardware-synchronization between the streams.
-  err = snd_pcm_link(
-    readStream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle,
-    readStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle
-  );
-  (void)err;
-  // TODO: Handle err code.
-
+  *pStream = readStream;
   return SK_SUCCESS;
 }
 
@@ -1650,6 +3021,9 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsa(
   SkDriver driver;
   SkPcmStream readStream;
   SkPcmStream writeStream;
+  SkBool32 isLinkRequired;
+  SkBool32 isQueueRequired;
+  SkAccessFlags accessFlags;
   SkAlsaPcmStreamRequest request;
   SkPcmStreamRequest const* pCurrStreamRequest;
 
@@ -1663,6 +3037,8 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsa(
   result = SK_ERROR_INVALID;
   readStream = SK_NULL_HANDLE;
   writeStream = SK_NULL_HANDLE;
+  isLinkRequired = SK_FALSE;
+  isQueueRequired = SK_FALSE;
 
   // Enumerate through PCM requests until one is filled.
   // We must fill all valid request types to handle duplex streams.
@@ -1670,32 +3046,43 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsa(
   while (pCurrStreamRequest) {
 
     // Convert the stream request into the ICD request type.
-    switch (pCurrStreamRequest->sType) {
-      case SK_STRUCTURE_TYPE_PCM_STREAM_REQUEST:
-        result = skConvertToLocalPcmRequestIMPL(pCurrStreamRequest, &request);
-        break;
-      case SK_STRUCTURE_TYPE_ICD_PCM_STREAM_REQUEST:
-        result = SK_SUCCESS;
-        memcpy(&request, pCurrStreamRequest, sizeof(SkAlsaPcmStreamRequest));
-        break;
-      default:
-        result = SK_ERROR_INVALID;
-        break;
-    }
+    result = skConvertPcmStreamRequestIMPL(pCurrStreamRequest, &request);
     if (result != SK_SUCCESS) {
       break;
     }
+    accessFlags = skGetPcmStreamRequestAccessFlagsIMPL(pCurrStreamRequest);
+    if (accessFlags & SK_ACCESS_LINKED_BIT) {
+      isLinkRequired = SK_TRUE;
+    }
 
     // Construct the requested stream type if it doesn't already exist.
+    // Note: If a matching stream was opened ahead of time, it's used instead.
     switch (request.hw.streamType) {
       case SND_PCM_STREAM_PLAYBACK:
         if (!writeStream) {
-          result = skRequestPcmStream_alsaIMPL(endpoint, &request, &writeStream);
+          if (!skAcquirePooledPcmStreamIMPL(endpoint, &request, &writeStream)) {
+            result = skRequestPcmStream_alsaIMPL(endpoint, &request, &writeStream);
+          }
+          if (result == SK_SUCCESS) {
+            skConfigureAutoRecoveryIMPL(&writeStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (accessFlags & SK_ACCESS_AUTO_RECOVER_BIT) != 0);
+          }
+          if (result == SK_SUCCESS && (accessFlags & SK_ACCESS_ADAPTIVE_BIT)) {
+            result = skEnableAdaptiveBufferingIMPL(&writeStream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL]);
+          }
+          isQueueRequired = (accessFlags & SK_ACCESS_ASYNC_BIT) != 0;
         }
         break;
       case SND_PCM_STREAM_CAPTURE:
         if (!readStream) {
-          result = skRequestPcmStream_alsaIMPL(endpoint, &request, &readStream);
+          if (!skAcquirePooledPcmStreamIMPL(endpoint, &request, &readStream)) {
+            result = skRequestPcmStream_alsaIMPL(endpoint, &request, &readStream);
+          }
+          if (result == SK_SUCCESS) {
+            skConfigureAutoRecoveryIMPL(&readStream->data[SK_PCM_STREAM_READ_INDEX_IMPL], (accessFlags & SK_ACCESS_AUTO_RECOVER_BIT) != 0);
+          }
+          if (result == SK_SUCCESS && (accessFlags & SK_ACCESS_ADAPTIVE_BIT)) {
+            result = skEnableAdaptiveBufferingIMPL(&readStream->data[SK_PCM_STREAM_READ_INDEX_IMPL]);
+          }
         }
         break;
       default:
@@ -1726,7 +3113,7 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsa(
   }
 
   // If multiple streams were constructed, join them into one.
-  result = skJoinPcmStreamIMPL(readStream, writeStream, pStream);
+  result = skJoinPcmStreamIMPL(readStream, writeStream, isLinkRequired, pStream);
   if (result != SK_SUCCESS) {
     if (readStream) {
       skDestroyPcmStream(readStream, driver->pAllocator);
@@ -1737,6 +3124,16 @@ static SkResult SKAPI_CALL skRequestPcmStream_alsa(
     return result;
   }
 
+  // The service thread holds onto the stream data, so it can only be started
+  // once joining has moved the data to where it will stay.
+  if (isQueueRequired) {
+    result = skStartPcmStreamQueueIMPL(driver, &(*pStream)->data[SK_PCM_STREAM_WRITE_INDEX_IMPL]);
+    if (result != SK_SUCCESS) {
+      skDestroyPcmStream(*pStream, driver->pAllocator);
+      return result;
+    }
+  }
+
   return SK_SUCCESS;
 }
 
@@ -1806,6 +3203,8 @@ static SkResult SKAPI_CALL skCreatePcmStream_alsa(
   }
 
   // Initialize the PCM stream internals
+  stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].timer.timerFd = -1;
+  stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].timer.timerFd = -1;
   pStreamData->pcmHandle = pUserData->pcmHandle;
   pStreamData->supportsPausing = (SkBool32)snd_pcm_hw_params_can_pause(pUserData->hwParams);
   memcpy(&pStreamData->streamInfo, pUserData->pStreamInfo, sizeof(SkPcmStreamInfo));
@@ -1830,9 +3229,21 @@ static void SKAPI_CALL skDestroyPcmStream_alsa(
   SkPcmStream                           stream,
   SkAllocationCallbacks const*          pAllocator
 ) {
+  uint32_t idx;
+  for (idx = 0; idx < SK_PCM_STREAM_INDEX_SIZE; ++idx) {
+    skStopPcmStreamQueueIMPL(skGetDriverIMPL(stream), &stream->data[idx], SK_FALSE);
+  }
   skDeinitializePcmStreamBase(stream, pAllocator);
+  for (idx = 0; idx < SK_PCM_STREAM_INDEX_SIZE; ++idx) {
+    if (stream->data[idx].timer.timerFd >= 0) {
+      close(stream->data[idx].timer.timerFd);
+    }
+    skFree(pAllocator, stream->data[idx].pSpanBuffer);
+    skFree(pAllocator, stream->data[idx].queue.pFrames);
+  }
   skFree(pAllocator, stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pChannelMap);
   skFree(pAllocator, stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pChannelMap);
+  skFree(pAllocator, stream->pProcessBuffer);
   skFree(pAllocator, stream);
 }
 
@@ -1886,6 +3297,7 @@ static SkResult SKAPI_CALL skClosePcmStream_alsa(
     }
   }
   if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle) {
+    skStopPcmStreamQueueIMPL(skGetDriverIMPL(stream), &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], drain);
     result = skClosePcmStreamDataIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], drain);
     if (result != SK_SUCCESS) {
       return result;
@@ -2032,6 +3444,10 @@ static SkResult SKAPI_CALL skStartPcmStream_alsa(
   SkPcmStream                           stream
 ) {
   SkResult result;
+  // Note: Linked streams are started together, starting either starts both.
+  if (stream->isLinked) {
+    return skStartPcmStreamIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL]);
+  }
   if (stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle) {
     result = skStartPcmStreamIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL]);
     if (result != SK_SUCCESS) {
@@ -2064,11 +3480,15 @@ static SkResult skStopPcmStreamIMPL(
   return SK_SUCCESS;
 }
 
-static SkResult SKAPI_CALL skStopPcmStream_alsa(
+static SkResult skStopPcmStreamsIMPL(
   SkPcmStream                           stream,
   SkBool32                              drain
 ) {
   SkResult result;
+  // Note: Linked streams are stopped together, playback decides if it drains.
+  if (stream->isLinked) {
+    return skStopPcmStreamIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], drain);
+  }
   if (stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle) {
     result = skStopPcmStreamIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL], drain);
     if (result != SK_SUCCESS) {
@@ -2084,12 +3504,37 @@ static SkResult SKAPI_CALL skStopPcmStream_alsa(
   return SK_SUCCESS;
 }
 
-static SkResult skPausePcmStreamIMPL(
-  SkPcmStreamDataIMPL*                  pStreamData,
-  SkBool32                              pause
+static SkResult SKAPI_CALL skStopPcmStream_alsa(
+  SkPcmStream                           stream,
+  SkBool32                              drain
 ) {
-  int err;
-  if (!pStreamData->supportsPausing) {
+  SkDriver driver;
+  SkResult result;
+  SkResult queueResult;
+  SkPcmStreamDataIMPL* pWriteData;
+
+  // Note: Asynchronous streams finish (or abandon) their queue before the
+  //       device is stopped, and then restart it so the stream can be reused.
+  pWriteData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+  if (!pWriteData->queue.isRunning) {
+    return skStopPcmStreamsIMPL(stream, drain);
+  }
+  driver = skGetDriverIMPL(stream);
+  skStopPcmStreamQueueIMPL(driver, pWriteData, drain);
+  result = skStopPcmStreamsIMPL(stream, drain);
+  queueResult = skStartPcmStreamQueueIMPL(driver, pWriteData);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  return queueResult;
+}
+
+static SkResult skPausePcmStreamIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkBool32                              pause
+) {
+  int err;
+  if (!pStreamData->supportsPausing) {
     return SK_ERROR_FEATURE_NOT_PRESENT;
   }
   err = snd_pcm_pause(pStreamData->pcmHandle, pause);
@@ -2112,23 +3557,205 @@ static SkResult SKAPI_CALL skPausePcmStream_alsa(
     if (result != SK_SUCCESS) {
       return result;
     }
+    // Queued samples were held back while paused, so have them written now.
+    if (!pause && stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].queue.isRunning) {
+      skWakePcmStreamQueueIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].queue);
+    }
+  }
+  return SK_SUCCESS;
+}
+
+static SkResult skApplyAdaptiveDepthIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  int err;
+  snd_pcm_uframes_t depth;
+  snd_pcm_uframes_t periodSize;
+  snd_pcm_uframes_t bufferSize;
+  snd_pcm_sw_params_t* swParams;
+  SkAlsaSoftwareParameters software;
+
+  depth = pStreamData->adaptive.depth;
+  periodSize = pStreamData->icdStreamInfo.hw.periodSize;
+  bufferSize = pStreamData->icdStreamInfo.hw.bufferSize;
+  software = pStreamData->icdStreamInfo.sw;
+
+  // Playback wakes up once no more than depth - period samples remain queued
+  // (so one period can be written without going over the depth), and starts
+  // once depth samples have been queued. Writes are limited to the depth by
+  // skLimitAdaptiveAvailIMPL, the buffer itself is kept large so it can grow.
+  // Capture collects more samples per wakeup as the depth grows.
+  switch (pStreamData->icdStreamInfo.hw.streamType) {
+    case SND_PCM_STREAM_PLAYBACK:
+      software.availMin = bufferSize - depth + periodSize;
+      software.startThreshold = depth;
+      break;
+    default:
+      software.availMin = depth - periodSize;
+      break;
+  }
+
+  // Note: Software parameters can be changed while the stream is running.
+  snd_pcm_sw_params_alloca(&swParams);
+  err = snd_pcm_sw_params_current(pStreamData->pcmHandle, swParams);
+  if (err >= 0) {
+    err = snd_pcm_sw_params_set_avail_min(pStreamData->pcmHandle, swParams, software.availMin);
+  }
+  if (err >= 0) {
+    err = snd_pcm_sw_params_set_start_threshold(pStreamData->pcmHandle, swParams, software.startThreshold);
+  }
+  if (err >= 0) {
+    err = snd_pcm_sw_params(pStreamData->pcmHandle, swParams);
+  }
+  if (err < 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
   }
+  pStreamData->icdStreamInfo.sw = software;
+
   return SK_SUCCESS;
 }
 
+static SkResult skEnableAdaptiveBufferingIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  // Start with the shallowest depth possible, two periods.
+  pStreamData->adaptive.isEnabled = SK_TRUE;
+  pStreamData->adaptive.isDecayed = SK_FALSE;
+  pStreamData->adaptive.depth = 2 * pStreamData->icdStreamInfo.hw.periodSize;
+  pStreamData->adaptive.changeTime = skGetMonotonicTimePLT();
+  pStreamData->adaptive.decayTime = SK_ADAPTIVE_DECAY_TIME_IMPL;
+  pStreamData->streamInfo.accessFlags |= SK_ACCESS_ADAPTIVE_BIT;
+  return skApplyAdaptiveDepthIMPL(pStreamData);
+}
+
+static SkResult skIncreaseAdaptiveDepthIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  uint64_t currentTime;
+  SkPcmAdaptiveStateIMPL* pAdaptive;
+
+  // If the depth was only just lowered, wait longer before lowering it again.
+  // Note: This is what keeps the depth from bouncing around an unstable value.
+  pAdaptive = &pStreamData->adaptive;
+  currentTime = skGetMonotonicTimePLT();
+  if (pAdaptive->isDecayed && currentTime - pAdaptive->changeTime < pAdaptive->decayTime) {
+    pAdaptive->decayTime = SKMIN(2 * pAdaptive->decayTime, SK_ADAPTIVE_MAX_DECAY_TIME_IMPL);
+  }
+  pAdaptive->isDecayed = SK_FALSE;
+  pAdaptive->changeTime = currentTime;
+
+  // Buffer one more period (the depth can never be more than the buffer).
+  if (pAdaptive->depth >= pStreamData->icdStreamInfo.hw.bufferSize) {
+    return SK_SUCCESS;
+  }
+  pAdaptive->depth = SKMIN(
+    pAdaptive->depth + pStreamData->icdStreamInfo.hw.periodSize,
+    pStreamData->icdStreamInfo.hw.bufferSize
+  );
+  return skApplyAdaptiveDepthIMPL(pStreamData);
+}
+
+static void skDecayAdaptiveDepthIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  uint64_t currentTime;
+  SkPcmAdaptiveStateIMPL* pAdaptive;
+
+  // Only lower the depth after running for a while without any xruns.
+  pAdaptive = &pStreamData->adaptive;
+  if (pAdaptive->depth <= 2 * pStreamData->icdStreamInfo.hw.periodSize) {
+    return;
+  }
+  currentTime = skGetMonotonicTimePLT();
+  if (currentTime - pAdaptive->changeTime < pAdaptive->decayTime) {
+    return;
+  }
+  pAdaptive->depth -= pStreamData->icdStreamInfo.hw.periodSize;
+  pAdaptive->isDecayed = SK_TRUE;
+  pAdaptive->changeTime = currentTime;
+  (void)skApplyAdaptiveDepthIMPL(pStreamData);
+}
+
+// Note: Adaptive playback may only queue up to depth samples, so the space
+//       past that in the buffer is never reported as available.
+static snd_pcm_sframes_t skLimitAdaptiveAvailIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  snd_pcm_sframes_t                     available
+) {
+  snd_pcm_uframes_t headroom;
+  if (available < 0 || !pStreamData->adaptive.isEnabled ||
+      pStreamData->icdStreamInfo.hw.streamType != SND_PCM_STREAM_PLAYBACK) {
+    return available;
+  }
+  headroom = pStreamData->icdStreamInfo.hw.bufferSize - pStreamData->adaptive.depth;
+  if ((snd_pcm_uframes_t)available <= headroom) {
+    return 0;
+  }
+  return available - (snd_pcm_sframes_t)headroom;
+}
+
+// Note: Blocking streams wait until the write can go ahead, the wakeup is
+//       configured to happen once a period fits (see skApplyAdaptiveDepthIMPL).
+static snd_pcm_sframes_t skLimitAdaptiveWriteIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  snd_pcm_uframes_t                     frames
+) {
+  int err;
+  snd_pcm_sframes_t available;
+
+  for (;;) {
+    available = snd_pcm_avail_update(pStreamData->pcmHandle);
+    available = skLimitAdaptiveAvailIMPL(pStreamData, available);
+    if (available != 0) {
+      break;
+    }
+    if (pStreamData->icdStreamInfo.hw.blockingMode == SND_PCM_NONBLOCK) {
+      return -EAGAIN;
+    }
+    err = snd_pcm_wait(pStreamData->pcmHandle, -1);
+    if (err < 0) {
+      return err;
+    }
+  }
+  if (available < 0) {
+    return available;
+  }
+
+  return ((snd_pcm_uframes_t)available < frames) ? available : (snd_pcm_sframes_t)frames;
+}
+
 static SkResult skRecoverPcmStreamIMPL(
   SkPcmStreamDataIMPL*                  pStreamData
 ) {
+  int err;
+
   // If there was no error, return - nothing to do.
   if (!pStreamData->lastError) {
     return SK_SUCCESS;
   }
   // Otherwise, attempt to recover the error.
+  err = pStreamData->lastError;
   pStreamData->lastError = snd_pcm_recover(pStreamData->pcmHandle, pStreamData->lastError, 1);
   if (pStreamData->lastError < 0) {
     return skHandlePcmStreamErrorsIMPL(pStreamData, pStreamData->lastError);
   }
   pStreamData->lastError = 0;
+  switch (err) {
+    case -EPIPE:
+      ++pStreamData->statistics.xrunCount;
+      break;
+    case -ESTRPIPE:
+      ++pStreamData->statistics.suspendCount;
+      break;
+    case -EINTR:
+      ++pStreamData->statistics.interruptCount;
+      break;
+  }
+
+  // An xrun means the adaptive depth was too shallow for this machine.
+  if (err == -EPIPE && pStreamData->adaptive.isEnabled) {
+    return skIncreaseAdaptiveDepthIMPL(pStreamData);
+  }
   return SK_SUCCESS;
 }
 
@@ -2142,6 +3769,9 @@ static SkResult SKAPI_CALL skRecoverPcmStream_alsa(
       return result;
     }
   }
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].queue.isRunning) {
+    return skRecoverPcmStreamQueueIMPL(skGetDriverIMPL(stream), &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL]);
+  }
   if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle) {
     result = skRecoverPcmStreamIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL]);
     if (result != SK_SUCCESS) {
@@ -2151,6 +3781,148 @@ static SkResult SKAPI_CALL skRecoverPcmStream_alsa(
   return SK_SUCCESS;
 }
 
+static void skConfigureAutoRecoveryIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkBool32                              autoRecover
+) {
+  // Note: Pooled streams are reused, so the policy must always be reset.
+  pStreamData->autoRecover = autoRecover;
+  memset(&pStreamData->statistics, 0, sizeof(SkPcmStreamStatistics));
+  if (autoRecover) {
+    pStreamData->streamInfo.accessFlags |= SK_ACCESS_AUTO_RECOVER_BIT;
+  }
+  else {
+    pStreamData->streamInfo.accessFlags &= ~SK_ACCESS_AUTO_RECOVER_BIT;
+  }
+}
+
+static SkBool32 skAutoRecoverPcmStreamIMPL(
+  SkPcmStream                           stream,
+  SkPcmStreamIndexIMPL                  streamIndex,
+  int                                   error
+) {
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // Only errors which skRecoverPcmStream would handle are recovered.
+  pStreamData = &stream->data[streamIndex];
+  if (!pStreamData->autoRecover) {
+    return SK_FALSE;
+  }
+  switch (error) {
+    case -EPIPE:
+    case -ESTRPIPE:
+    case -EINTR:
+      break;
+    default:
+      return SK_FALSE;
+  }
+  pStreamData->lastError = error;
+  if (skRecoverPcmStreamIMPL(pStreamData) != SK_SUCCESS) {
+    return SK_FALSE;
+  }
+  ++pStreamData->statistics.autoRecoveryCount;
+
+  // Playback restarts from an empty buffer, so give it a period of headroom.
+  // Note: This is best-effort, the retried write still happens regardless.
+  if (error != -EINTR && streamIndex == SK_PCM_STREAM_WRITE_INDEX_IMPL) {
+    (void)skTransferPcmStreamSpansIMPL(stream, streamIndex, NULL, 0, (uint32_t)pStreamData->icdStreamInfo.hw.periodSize);
+  }
+  return SK_TRUE;
+}
+
+static SkResult skWaitPcmStreamTimerIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  int32_t                               timeout
+) {
+  int err;
+  double rate;
+  uint64_t position;
+  uint64_t expirations;
+  uint64_t currentTime;
+  uint64_t sleepTime;
+  SkBool32 isTimeout;
+  snd_pcm_sframes_t frames;
+  snd_pcm_sframes_t available;
+  snd_pcm_sframes_t remaining;
+  struct itimerspec timerSpec;
+  SkPcmTimerStateIMPL* pTimer;
+
+  // Nothing will be consumed until the stream is started (or recovered).
+  if (!timeout || snd_pcm_state(pStreamData->pcmHandle) != SND_PCM_STATE_RUNNING) {
+    return SK_SUCCESS;
+  }
+
+  // Find how many frames are left before the stream reaches avail_min.
+  // Note: Playback uses the delay, so that frames which have left the buffer
+  //       but have not been heard yet are also taken into account.
+  pTimer = &pStreamData->timer;
+  available = snd_pcm_avail(pStreamData->pcmHandle);
+  if (available < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, (int)available);
+  }
+  switch (pStreamData->icdStreamInfo.hw.streamType) {
+    case SND_PCM_STREAM_PLAYBACK:
+      err = snd_pcm_delay(pStreamData->pcmHandle, &frames);
+      if (err < 0) {
+        return skHandlePcmStreamErrorsIMPL(pStreamData, err);
+      }
+      remaining = frames - (snd_pcm_sframes_t)(pStreamData->icdStreamInfo.hw.bufferSize - pStreamData->icdStreamInfo.sw.availMin);
+      position = pTimer->transferredFrames - (uint64_t)frames;
+      break;
+    default:
+      remaining = (snd_pcm_sframes_t)pStreamData->icdStreamInfo.sw.availMin - available;
+      position = pTimer->transferredFrames + (uint64_t)available;
+      break;
+  }
+
+  // Measure the real rate of the stream over a window of time.
+  // Note: Anything far from the nominal rate means the position was reset.
+  currentTime = skGetMonotonicTimePLT();
+  if (!pTimer->measuredRate) {
+    pTimer->measuredRate = pStreamData->icdStreamInfo.hw.rate;
+  }
+  if (!pTimer->rateTime || position < pTimer->ratePosition) {
+    pTimer->rateTime = currentTime;
+    pTimer->ratePosition = position;
+  }
+  else if (currentTime - pTimer->rateTime >= SK_TIMER_RATE_WINDOW_IMPL) {
+    rate = (position - pTimer->ratePosition) * 1000000000.0 / (currentTime - pTimer->rateTime);
+    if (rate > pStreamData->icdStreamInfo.hw.rate * 0.95 && rate < pStreamData->icdStreamInfo.hw.rate * 1.05) {
+      pTimer->measuredRate = rate;
+    }
+    pTimer->rateTime = currentTime;
+    pTimer->ratePosition = position;
+  }
+  if (remaining <= 0) {
+    return SK_SUCCESS;
+  }
+
+  // Sleep until the stream should reach avail_min (or until the timeout).
+  isTimeout = SK_FALSE;
+  sleepTime = (uint64_t)(remaining * 1000000000.0 / pTimer->measuredRate);
+  if (timeout > 0 && sleepTime > (uint64_t)timeout * 1000000ull) {
+    sleepTime = (uint64_t)timeout * 1000000ull;
+    isTimeout = SK_TRUE;
+  }
+  if (pTimer->timerFd < 0) {
+    pTimer->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (pTimer->timerFd < 0) {
+      return SK_ERROR_SYSTEM_INTERNAL;
+    }
+  }
+  memset(&timerSpec, 0, sizeof(struct itimerspec));
+  timerSpec.it_value.tv_sec = (time_t)(sleepTime / 1000000000ull);
+  timerSpec.it_value.tv_nsec = (long)(sleepTime % 1000000000ull);
+  if (timerfd_settime(pTimer->timerFd, 0, &timerSpec, NULL) < 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  if (read(pTimer->timerFd, &expirations, sizeof(uint64_t)) != sizeof(uint64_t)) {
+    return SK_ERROR_INTERRUPTED;
+  }
+
+  return (isTimeout) ? SK_TIMEOUT : SK_SUCCESS;
+}
+
 static SkResult SKAPI_CALL skWaitPcmStream_alsa(
   SkPcmStream                           stream,
   SkStreamFlagBits                      streamType,
@@ -2176,6 +3948,11 @@ static SkResult SKAPI_CALL skWaitPcmStream_alsa(
     return SK_ERROR_NOT_SUPPORTED;
   }
 
+  // Without period wakeups, polling the stream would never return.
+  if (pStreamData->icdStreamInfo.hw.noPeriodWakeup) {
+    return skWaitPcmStreamTimerIMPL(pStreamData, timeout);
+  }
+
   // Attempt to wait for a given timeout.
   if (timeout) {
     err = snd_pcm_wait(pStreamData->pcmHandle, timeout);
@@ -2215,8 +3992,54 @@ static SkResult SKAPI_CALL skAvailPcmStreamSamples_alsa(
     return SK_ERROR_NOT_SUPPORTED;
   }
 
+  // Asynchronous streams are written into the queue, not into the device.
+  if (pStreamData->queue.isRunning) {
+    *pAvailable = skGetPcmStreamQueueSpaceIMPL(pStreamData);
+    return SK_SUCCESS;
+  }
+
   // Attempt to find the number of available samples.
-  err = snd_pcm_avail(pStreamData->pcmHandle);
+  err = skLimitAdaptiveAvailIMPL(pStreamData, snd_pcm_avail(pStreamData->pcmHandle));
+  if (err < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, (int)err);
+  }
+  *pAvailable = (uint32_t)err;
+  return SK_SUCCESS;
+}
+
+static SkResult SKAPI_CALL skAvailPcmStreamSamplesCached_alsa(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t*                             pAvailable
+) {
+  snd_pcm_sframes_t err;
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // Grab the stream index type.
+  switch (streamType) {
+    case SK_STREAM_PCM_READ_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_READ_INDEX_IMPL];
+      break;
+    case SK_STREAM_PCM_WRITE_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+      break;
+    default:
+      return SK_ERROR_INVALID;
+  }
+
+  // If this stream does not contain this kind of type, return that.
+  if (!pStreamData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Asynchronous streams are written into the queue, not into the device.
+  if (pStreamData->queue.isRunning) {
+    *pAvailable = skGetPcmStreamQueueSpaceIMPL(pStreamData);
+    return SK_SUCCESS;
+  }
+
+  // Note: Unlike snd_pcm_avail, this doesn't sync the hardware pointer.
+  err = skLimitAdaptiveAvailIMPL(pStreamData, snd_pcm_avail_update(pStreamData->pcmHandle));
   if (err < 0) {
     return skHandlePcmStreamErrorsIMPL(pStreamData, (int)err);
   }
@@ -2224,16 +4047,86 @@ static SkResult SKAPI_CALL skAvailPcmStreamSamples_alsa(
   return SK_SUCCESS;
 }
 
+static SkResult SKAPI_CALL skQueryPcmStreamStatus_alsa(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatus*                    pStatus
+) {
+  int err;
+  snd_pcm_status_t* status;
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // Grab the stream index type.
+  switch (streamType) {
+    case SK_STREAM_PCM_READ_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_READ_INDEX_IMPL];
+      break;
+    case SK_STREAM_PCM_WRITE_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+      break;
+    default:
+      return SK_ERROR_INVALID;
+  }
+
+  // If this stream does not contain this kind of type, return that.
+  if (!pStreamData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Note: A single status ioctl reports everything, instead of one per value.
+  snd_pcm_status_alloca(&status);
+  err = snd_pcm_status(pStreamData->pcmHandle, status);
+  if (err < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, err);
+  }
+  pStatus->state = skConvertFromLocalPcmStateIMPL(snd_pcm_status_get_state(status));
+  pStatus->availableSamples = (uint32_t)skLimitAdaptiveAvailIMPL(
+    pStreamData,
+    (snd_pcm_sframes_t)snd_pcm_status_get_avail(status)
+  );
+  pStatus->delaySamples = (int64_t)snd_pcm_status_get_delay(status);
+
+  // Samples waiting in the queue are played after the ones in the device.
+  if (pStreamData->queue.isRunning) {
+    pStatus->availableSamples = skGetPcmStreamQueueSpaceIMPL(pStreamData);
+    pStatus->delaySamples += pStreamData->queue.capacity - pStatus->availableSamples;
+  }
+  return SK_SUCCESS;
+}
+
 static int64_t SKAPI_CALL skWritePcmStreamInterleaved_alsa(
   SkPcmStream                           stream,
   void const*                           pBuffer,
   uint32_t                              samples
 ) {
   snd_pcm_sframes_t frames;
+  SkPcmStreamSpan span;
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].queue.isRunning) {
+    span.pBuffer = (void*)pBuffer;
+    span.samples = samples;
+    return skEnqueuePcmStreamSpansIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], &span, 1, 0);
+  }
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].adaptive.isEnabled) {
+    frames = skLimitAdaptiveWriteIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (snd_pcm_uframes_t)samples);
+    if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, (int)frames)) {
+      frames = skLimitAdaptiveWriteIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (snd_pcm_uframes_t)samples);
+    }
+    if (frames < 0) {
+      return skHandlePcmStreamErrorsIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (int)frames);
+    }
+    samples = (uint32_t)frames;
+  }
   frames = snd_pcm_writei(stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, (int)frames)) {
+    frames = snd_pcm_writei(stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  }
   if (frames < 0) {
     return skHandlePcmStreamErrorsIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (int)frames);
   }
+  stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].timer.transferredFrames += (uint64_t)frames;
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].adaptive.isEnabled) {
+    skDecayAdaptiveDepthIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL]);
+  }
   return frames;
 }
 
@@ -2243,10 +4136,27 @@ static int64_t SKAPI_CALL skWritePcmStreamNoninterleaved_alsa(
   uint32_t                              samples
 ) {
   snd_pcm_sframes_t frames;
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].adaptive.isEnabled) {
+    frames = skLimitAdaptiveWriteIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (snd_pcm_uframes_t)samples);
+    if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, (int)frames)) {
+      frames = skLimitAdaptiveWriteIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (snd_pcm_uframes_t)samples);
+    }
+    if (frames < 0) {
+      return skHandlePcmStreamErrorsIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (int)frames);
+    }
+    samples = (uint32_t)frames;
+  }
   frames = snd_pcm_writen(stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, (int)frames)) {
+    frames = snd_pcm_writen(stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  }
   if (frames < 0) {
     return skHandlePcmStreamErrorsIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], (int)frames);
   }
+  stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].timer.transferredFrames += (uint64_t)frames;
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].adaptive.isEnabled) {
+    skDecayAdaptiveDepthIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL]);
+  }
   return frames;
 }
 
@@ -2257,9 +4167,16 @@ static int64_t SKAPI_CALL skReadPcmStreamInterleaved_alsa(
 ) {
   snd_pcm_sframes_t frames;
   frames = snd_pcm_readi(stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_READ_INDEX_IMPL, (int)frames)) {
+    frames = snd_pcm_readi(stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  }
   if (frames < 0) {
     return skHandlePcmStreamErrorsIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL], (int)frames);
   }
+  stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].timer.transferredFrames += (uint64_t)frames;
+  if (stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].adaptive.isEnabled) {
+    skDecayAdaptiveDepthIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL]);
+  }
   return frames;
 }
 
@@ -2270,9 +4187,1164 @@ static int64_t SKAPI_CALL skReadPcmStreamNoninterleaved_alsa(
 ) {
   snd_pcm_sframes_t frames;
   frames = snd_pcm_readn(stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_READ_INDEX_IMPL, (int)frames)) {
+    frames = snd_pcm_readn(stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].pcmHandle, pBuffer, (snd_pcm_uframes_t)samples);
+  }
   if (frames < 0) {
     return skHandlePcmStreamErrorsIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL], (int)frames);
   }
+  stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].timer.transferredFrames += (uint64_t)frames;
+  if (stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].adaptive.isEnabled) {
+    skDecayAdaptiveDepthIMPL(&stream->data[SK_PCM_STREAM_READ_INDEX_IMPL]);
+  }
+  return frames;
+}
+
+static snd_pcm_uframes_t skCopyPcmStreamSpansIMPL(
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint32_t*                             pSpanIndex,
+  snd_pcm_uframes_t*                    pSpanOffset,
+  void*                                 pBuffer,
+  snd_pcm_uframes_t                     frames,
+  size_t                                frameBytes,
+  SkBool32                              isWrite
+) {
+  size_t bytes;
+  char* pSpanData;
+  snd_pcm_uframes_t count;
+  snd_pcm_uframes_t copied;
+
+  // Copy between the spans (starting at the cursor) and a contiguous buffer.
+  copied = 0;
+  while (copied < frames && *pSpanIndex < spanCount) {
+    count = pSpans[*pSpanIndex].samples - *pSpanOffset;
+    if (count > frames - copied) {
+      count = frames - copied;
+    }
+    bytes = count * frameBytes;
+    pSpanData = (char*)pSpans[*pSpanIndex].pBuffer + *pSpanOffset * frameBytes;
+    if (isWrite) {
+      memcpy((char*)pBuffer + copied * frameBytes, pSpanData, bytes);
+    }
+    else {
+      memcpy(pSpanData, (char*)pBuffer + copied * frameBytes, bytes);
+    }
+    copied += count;
+    *pSpanOffset += count;
+    if (*pSpanOffset == pSpans[*pSpanIndex].samples) {
+      ++*pSpanIndex;
+      *pSpanOffset = 0;
+    }
+  }
+
+  return copied;
+}
+
+// Note: If pSpans is NULL, remainingFrames of silence are written instead.
+static int64_t skTransferPcmStreamMappedIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint64_t                              remainingFrames,
+  SkBool32                              isWrite
+) {
+  int err;
+  size_t frameBytes;
+  uint32_t spanIndex;
+  int64_t totalFrames;
+  snd_pcm_t* pcmHandle;
+  snd_pcm_state_t state;
+  snd_pcm_uframes_t offset;
+  snd_pcm_uframes_t frames;
+  snd_pcm_uframes_t spanOffset;
+  snd_pcm_sframes_t available;
+  snd_pcm_sframes_t committed;
+  snd_pcm_channel_area_t const* pAreas;
+
+  err = 0;
+  spanIndex = 0;
+  spanOffset = 0;
+  totalFrames = 0;
+  pcmHandle = pStreamData->pcmHandle;
+  frameBytes = (size_t)snd_pcm_frames_to_bytes(pcmHandle, 1);
+  while (remainingFrames) {
+
+    // Capture must be running before there is anything to read.
+    state = snd_pcm_state(pcmHandle);
+    if (!isWrite && state == SND_PCM_STATE_PREPARED) {
+      err = snd_pcm_start(pcmHandle);
+      if (err < 0) {
+        break;
+      }
+    }
+
+    // Wait until some part of the ring buffer can be accessed.
+    // Note: A full playback buffer which hasn't reached the start threshold
+    //       would never drain, so start it rather than waiting forever.
+    available = snd_pcm_avail_update(pcmHandle);
+    if (available < 0) {
+      err = (int)available;
+      break;
+    }
+    if (skLimitAdaptiveAvailIMPL(pStreamData, available) == 0) {
+      if (pStreamData->icdStreamInfo.hw.blockingMode == SND_PCM_NONBLOCK) {
+        err = (totalFrames) ? 0 : -EAGAIN;
+        break;
+      }
+      if (isWrite && state == SND_PCM_STATE_PREPARED) {
+        err = snd_pcm_start(pcmHandle);
+      }
+      else {
+        err = snd_pcm_wait(pcmHandle, -1);
+      }
+      if (err < 0) {
+        break;
+      }
+      continue;
+    }
+
+    // Copy the spans directly into (or out of) the mapped ring buffer.
+    // Note: For interleaved access, every channel shares the first area.
+    frames = (snd_pcm_uframes_t)skLimitAdaptiveAvailIMPL(pStreamData, available);
+    if (frames > remainingFrames) {
+      frames = (snd_pcm_uframes_t)remainingFrames;
+    }
+    err = snd_pcm_mmap_begin(pcmHandle, &pAreas, &offset, &frames);
+    if (err < 0) {
+      break;
+    }
+    if (pSpans) {
+      frames = skCopyPcmStreamSpansIMPL(
+        pSpans,
+        spanCount,
+        &spanIndex,
+        &spanOffset,
+        (char*)pAreas[0].addr + (pAreas[0].first + offset * pAreas[0].step) / 8,
+        frames,
+        frameBytes,
+        isWrite
+      );
+    }
+    else {
+      err = snd_pcm_areas_silence(
+        pAreas,
+        offset,
+        pStreamData->icdStreamInfo.hw.channels,
+        frames,
+        pStreamData->icdStreamInfo.hw.formatType
+      );
+      if (err < 0) {
+        break;
+      }
+    }
+    committed = snd_pcm_mmap_commit(pcmHandle, offset, frames);
+    if (committed < 0) {
+      err = (int)committed;
+      break;
+    }
+    totalFrames += committed;
+    remainingFrames -= (uint64_t)committed;
+
+    // Unlike snd_pcm_writei, committing never starts playback on its own.
+    if (isWrite && state == SND_PCM_STATE_PREPARED) {
+      frames = pStreamData->icdStreamInfo.hw.bufferSize - ((snd_pcm_uframes_t)available - (snd_pcm_uframes_t)committed);
+      if (frames >= pStreamData->icdStreamInfo.sw.startThreshold) {
+        err = snd_pcm_start(pcmHandle);
+        if (err < 0) {
+          break;
+        }
+      }
+    }
+  }
+
+  // Only report an error if nothing at all was transferred.
+  if (err < 0 && !totalFrames) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, err);
+  }
+  return totalFrames;
+}
+
+// Note: If pSpans is NULL, remainingFrames of silence are written instead.
+static int64_t skTransferPcmStreamStagedIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint64_t                              remainingFrames,
+  SkBool32                              isWrite,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  size_t frameBytes;
+  uint32_t spanIndex;
+  int64_t totalFrames;
+  snd_pcm_uframes_t frames;
+  snd_pcm_uframes_t spanOffset;
+  snd_pcm_uframes_t bufferSize;
+  snd_pcm_sframes_t transferred;
+
+  // Allocate a staging buffer, one hardware buffer in size, the first time.
+  frameBytes = (size_t)snd_pcm_frames_to_bytes(pStreamData->pcmHandle, 1);
+  bufferSize = pStreamData->icdStreamInfo.hw.bufferSize;
+  if (!pStreamData->pSpanBuffer) {
+    pStreamData->pSpanBuffer = skAllocate(
+      pAllocator,
+      bufferSize * frameBytes,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_STREAM
+    );
+    if (!pStreamData->pSpanBuffer) {
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+
+  // Silence is the same every time, so it only has to be generated once.
+  if (!pSpans) {
+    frames = (remainingFrames < bufferSize) ? (snd_pcm_uframes_t)remainingFrames : bufferSize;
+    snd_pcm_format_set_silence(
+      pStreamData->icdStreamInfo.hw.formatType,
+      pStreamData->pSpanBuffer,
+      (unsigned int)(frames * pStreamData->icdStreamInfo.hw.channels)
+    );
+  }
+
+  // Gather (or scatter) up to a hardware buffer of samples per call.
+  spanIndex = 0;
+  spanOffset = 0;
+  totalFrames = 0;
+  while (remainingFrames) {
+    frames = (remainingFrames < bufferSize) ? (snd_pcm_uframes_t)remainingFrames : bufferSize;
+    if (isWrite) {
+      if (pStreamData->adaptive.isEnabled) {
+        transferred = skLimitAdaptiveWriteIMPL(pStreamData, frames);
+        if (transferred < 0) {
+          if (!totalFrames) {
+            return skHandlePcmStreamErrorsIMPL(pStreamData, (int)transferred);
+          }
+          break;
+        }
+        frames = (snd_pcm_uframes_t)transferred;
+      }
+      if (pSpans) {
+        frames = skCopyPcmStreamSpansIMPL(pSpans, spanCount, &spanIndex, &spanOffset, pStreamData->pSpanBuffer, frames, frameBytes, SK_TRUE);
+      }
+      transferred = snd_pcm_writei(pStreamData->pcmHandle, pStreamData->pSpanBuffer, frames);
+    }
+    else {
+      transferred = snd_pcm_readi(pStreamData->pcmHandle, pStreamData->pSpanBuffer, frames);
+      if (transferred > 0) {
+        (void)skCopyPcmStreamSpansIMPL(pSpans, spanCount, &spanIndex, &spanOffset, pStreamData->pSpanBuffer, (snd_pcm_uframes_t)transferred, frameBytes, SK_FALSE);
+      }
+    }
+    if (transferred < 0) {
+      if (!totalFrames) {
+        return skHandlePcmStreamErrorsIMPL(pStreamData, (int)transferred);
+      }
+      break;
+    }
+    totalFrames += transferred;
+    remainingFrames -= (uint64_t)transferred;
+    if ((snd_pcm_uframes_t)transferred < frames) {
+      break;
+    }
+  }
+
+  return totalFrames;
+}
+
+// Note: If pSpans is NULL, silenceFrames of silence are written instead.
+static int64_t skTransferPcmStreamSpansIMPL(
+  SkPcmStream                           stream,
+  SkPcmStreamIndexIMPL                  streamIndex,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint32_t                              silenceFrames
+) {
+  uint32_t idx;
+  int64_t frames;
+  SkBool32 isWrite;
+  uint64_t totalFrames;
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // If this stream does not contain this kind of type, return that.
+  pStreamData = &stream->data[streamIndex];
+  if (!pStreamData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  totalFrames = silenceFrames;
+  for (idx = 0; idx < spanCount; ++idx) {
+    totalFrames += pSpans[idx].samples;
+  }
+
+  // Memory-mapped streams are copied into place, anything else is staged.
+  isWrite = (streamIndex == SK_PCM_STREAM_WRITE_INDEX_IMPL);
+  switch (pStreamData->icdStreamInfo.hw.accessMode) {
+    case SND_PCM_ACCESS_MMAP_INTERLEAVED:
+      frames = skTransferPcmStreamMappedIMPL(pStreamData, pSpans, spanCount, totalFrames, isWrite);
+      break;
+    case SND_PCM_ACCESS_RW_INTERLEAVED:
+      frames = skTransferPcmStreamStagedIMPL(pStreamData, pSpans, spanCount, totalFrames, isWrite, skGetDriverIMPL(stream)->pAllocator);
+      break;
+    default:
+      return SK_ERROR_NOT_SUPPORTED;
+  }
+  if (frames < 0) {
+    return frames;
+  }
+
+  pStreamData->timer.transferredFrames += (uint64_t)frames;
+  if (pStreamData->adaptive.isEnabled) {
+    skDecayAdaptiveDepthIMPL(pStreamData);
+  }
+  return frames;
+}
+
+static void skWakePcmStreamQueueIMPL(
+  SkPcmQueueStateIMPL*                  pQueue
+) {
+  uint64_t value;
+  // Note: An eventfd never blocks the writer (it only counts up).
+  value = 1;
+  (void)write(pQueue->eventFd, &value, sizeof(value));
+}
+
+static void skFinishPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmQueueStateIMPL*                  pQueue
+) {
+  // The stream is left disarmed, so no other service thread will pick it up.
+  skLockMutexPLT(driver->queueMutex);
+  pQueue->isStopped = SK_TRUE;
+  skBroadcastConditionPLT(driver->queueCondition);
+  skUnlockMutexPLT(driver->queueMutex);
+}
+
+static void skServicePcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  uint32_t idx;
+  uint64_t value;
+  uint32_t offset;
+  uint32_t stopMode;
+  uint32_t readIndex;
+  uint32_t queuedFrames;
+  SkResult result;
+  SkBool32 isWoken;
+  SkBool32 isDeviceWait;
+  unsigned short revents;
+  snd_pcm_uframes_t frames;
+  snd_pcm_sframes_t transferred;
+  struct epoll_event event;
+  SkPcmQueueStateIMPL* pQueue;
+
+  // Clear the wakeup, whatever it was for is picked up below.
+  pQueue = &pStreamData->queue;
+  isWoken = (read(pQueue->eventFd, &value, sizeof(value)) == sizeof(value));
+  skAtomicStorePLT(&pQueue->isIdle, 0);
+
+  // While waiting on the device, ask it whether there's really room.
+  // Note: Plugins (e.g. dmix, pulse, pipewire) signal their descriptors for
+  //       their own reasons, and some only clear them through revents. Not
+  //       doing this would spin the service thread, so if the application
+  //       didn't wake the stream, it stays armed until the device is ready.
+  isDeviceWait = SK_FALSE;
+  if (pQueue->isDeviceArmed) {
+    for (idx = 0; idx < pQueue->deviceFdCount; ++idx) {
+      pQueue->pDeviceFds[idx].revents = 0;
+    }
+    revents = 0;
+    (void)poll(pQueue->pDeviceFds, pQueue->deviceFdCount, 0);
+    if (snd_pcm_poll_descriptors_revents(pStreamData->pcmHandle, pQueue->pDeviceFds, pQueue->deviceFdCount, &revents) >= 0) {
+      isDeviceWait = !isWoken && !(revents & (POLLOUT | POLLERR));
+    }
+  }
+
+  readIndex = pQueue->readIndex;
+  while (!isDeviceWait) {
+    stopMode = skAtomicLoadPLT(&pQueue->stopMode);
+    queuedFrames = skAtomicLoadPLT(&pQueue->writeIndex) - readIndex;
+    if (stopMode == SK_PCM_QUEUE_DROP_IMPL || (stopMode == SK_PCM_QUEUE_DRAIN_IMPL && !queuedFrames)) {
+      skFinishPcmStreamQueueIMPL(driver, pQueue);
+      return;
+    }
+
+    // Note: The application only wakes idle streams, so look once more after
+    //       going idle, in case samples were queued before it could notice.
+    if (!queuedFrames) {
+      skAtomicStorePLT(&pQueue->isIdle, 1);
+      skAtomicFencePLT();
+      if (skAtomicLoadPLT(&pQueue->writeIndex) == readIndex) {
+        break;
+      }
+      skAtomicStorePLT(&pQueue->isIdle, 0);
+      continue;
+    }
+
+    // Write as much as is contiguous, the rest is picked up next time around.
+    offset = readIndex & (pQueue->capacity - 1);
+    frames = queuedFrames;
+    if (frames > pQueue->capacity - offset) {
+      frames = pQueue->capacity - offset;
+    }
+    if (pStreamData->adaptive.isEnabled) {
+      transferred = skLimitAdaptiveAvailIMPL(pStreamData, snd_pcm_avail_update(pStreamData->pcmHandle));
+      if (transferred == 0) {
+        isDeviceWait = SK_TRUE;
+        break;
+      }
+      if (transferred > 0 && (snd_pcm_uframes_t)transferred < frames) {
+        frames = (snd_pcm_uframes_t)transferred;
+      }
+    }
+    if (pStreamData->icdStreamInfo.hw.accessMode == SND_PCM_ACCESS_MMAP_INTERLEAVED) {
+      transferred = snd_pcm_mmap_writei(pStreamData->pcmHandle, pQueue->pFrames + offset * pQueue->frameBytes, frames);
+    }
+    else {
+      transferred = snd_pcm_writei(pStreamData->pcmHandle, pQueue->pFrames + offset * pQueue->frameBytes, frames);
+    }
+
+    // Note: The device is recovered here, the application only finds out
+    //       through the statistics (or through the next write, if it failed).
+    if (transferred == -EAGAIN) {
+      isDeviceWait = SK_TRUE;
+      break;
+    }
+    if (transferred == -EBADFD) {
+      // The device is paused or stopped, wait to be woken up by the application.
+      if (stopMode != SK_PCM_QUEUE_RUNNING_IMPL) {
+        skFinishPcmStreamQueueIMPL(driver, pQueue);
+        return;
+      }
+      skAtomicStorePLT(&pQueue->isIdle, 1);
+      break;
+    }
+    if (transferred < 0) {
+      skLockMutexPLT(driver->queueMutex);
+      pStreamData->lastError = (int)transferred;
+      result = skRecoverPcmStreamIMPL(pStreamData);
+      skUnlockMutexPLT(driver->queueMutex);
+      if (result != SK_SUCCESS) {
+        skAtomicStorePLT(&pQueue->failedError, (uint32_t)-transferred);
+        skFinishPcmStreamQueueIMPL(driver, pQueue);
+        return;
+      }
+      continue;
+    }
+
+    readIndex += (uint32_t)transferred;
+    skAtomicStorePLT(&pQueue->readIndex, readIndex);
+    skLockMutexPLT(driver->queueMutex);
+    pStreamData->timer.transferredFrames += (uint64_t)transferred;
+    if (pStreamData->adaptive.isEnabled) {
+      skDecayAdaptiveDepthIMPL(pStreamData);
+    }
+    skUnlockMutexPLT(driver->queueMutex);
+  }
+
+  // Only listen to the device while waiting on it, otherwise it's always ready.
+  if (pQueue->isDeviceArmed != isDeviceWait) {
+    for (idx = 0; idx < pQueue->deviceFdCount; ++idx) {
+      event.events = isDeviceWait ? (uint32_t)pQueue->pDeviceFds[idx].events : 0;
+      event.data.ptr = NULL;
+      (void)epoll_ctl(pQueue->pollFd, EPOLL_CTL_MOD, pQueue->pDeviceFds[idx].fd, &event);
+    }
+    pQueue->isDeviceArmed = isDeviceWait;
+  }
+
+  // Hand the stream back, to be picked up by whichever thread is free next.
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.ptr = pStreamData;
+  (void)epoll_ctl(driver->queueEpollFd, EPOLL_CTL_MOD, pQueue->pollFd, &event);
+}
+
+static void SKAPI_PTR skRunPcmStreamQueuesIMPL(
+  void*                                 pUserData
+) {
+  int count;
+  SkDriver driver;
+  struct epoll_event event;
+
+  // Note: Streams are registered one-shot, so a ready stream is given to
+  //       exactly one thread, and isn't seen again until it's handed back.
+  //       Whichever thread is free takes the next ready stream, so a slow
+  //       stream never holds up the others behind it.
+  driver = pUserData;
+  for (;;) {
+    count = epoll_wait(driver->queueEpollFd, &event, 1, -1);
+    if (count < 0 && errno != EINTR) {
+      break;
+    }
+    if (count <= 0) {
+      continue;
+    }
+    if (!event.data.ptr) {
+      break;
+    }
+    skServicePcmStreamQueueIMPL(driver, event.data.ptr);
+  }
+}
+
+static SkResult skStartPcmQueueThreadsIMPL(
+  SkDriver                              driver
+) {
+  int stopFd;
+  int epollFd;
+  uint32_t idx;
+  SkResult result;
+  uint32_t threadCount;
+  SkThreadPLT* pThreads;
+  struct epoll_event event;
+
+  // Note: Like the stream pools, this is only started from the application's
+  //       thread, the first time that an asynchronous stream is requested.
+  if (driver->pQueueThreads) {
+    return SK_SUCCESS;
+  }
+  if (!driver->queueMutex) {
+    result = skCreateMutexPLT(driver->pAllocator, SK_SYSTEM_ALLOCATION_SCOPE_DRIVER, &driver->queueMutex);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+  if (!driver->queueCondition) {
+    result = skCreateConditionPLT(driver->pAllocator, SK_SYSTEM_ALLOCATION_SCOPE_DRIVER, &driver->queueCondition);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+
+  // The stop event is never cleared, so that it wakes every thread.
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (epollFd < 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (stopFd < 0) {
+    close(epollFd);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;
+  if (epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) < 0) {
+    close(stopFd);
+    close(epollFd);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  // One thread per processor, no matter how many streams there are.
+  threadCount = skGetProcessorCountPLT();
+  pThreads = skAllocate(
+    driver->pAllocator,
+    sizeof(SkThreadPLT) * threadCount,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
+  );
+  if (!pThreads) {
+    close(stopFd);
+    close(epollFd);
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  driver->queueEpollFd = epollFd;
+  driver->queueStopFd = stopFd;
+  result = SK_SUCCESS;
+  for (idx = 0; idx < threadCount; ++idx) {
+    result = skCreateThreadPLT(driver->pAllocator, &skRunPcmStreamQueuesIMPL, driver, &pThreads[idx]);
+    if (result != SK_SUCCESS) {
+      break;
+    }
+    // Note: This is best-effort, unprivileged processes still get the threads.
+    (void)skPromoteThreadPLT(pThreads[idx], idx);
+  }
+  if (!idx) {
+    skFree(driver->pAllocator, pThreads);
+    close(stopFd);
+    close(epollFd);
+    return result;
+  }
+  driver->pQueueThreads = pThreads;
+  driver->queueThreadCount = idx;
+  return SK_SUCCESS;
+}
+
+static void skStopPcmQueueThreadsIMPL(
+  SkDriver                              driver
+) {
+  uint32_t idx;
+  uint64_t value;
+
+  // Stop the service threads (if they were ever started).
+  if (driver->pQueueThreads) {
+    value = 1;
+    (void)write(driver->queueStopFd, &value, sizeof(value));
+    for (idx = 0; idx < driver->queueThreadCount; ++idx) {
+      skJoinThreadPLT(driver->pAllocator, driver->pQueueThreads[idx]);
+    }
+    skFree(driver->pAllocator, driver->pQueueThreads);
+    driver->pQueueThreads = NULL;
+    driver->queueThreadCount = 0;
+    close(driver->queueStopFd);
+    close(driver->queueEpollFd);
+  }
+
+  if (driver->queueCondition) {
+    skDestroyConditionPLT(driver->pAllocator, driver->queueCondition);
+    driver->queueCondition = NULL;
+  }
+  if (driver->queueMutex) {
+    skDestroyMutexPLT(driver->pAllocator, driver->queueMutex);
+    driver->queueMutex = NULL;
+  }
+}
+
+static void skClosePcmStreamQueueIMPL(
+  SkPcmQueueStateIMPL*                  pQueue,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  if (pQueue->pollFd >= 0) {
+    close(pQueue->pollFd);
+    pQueue->pollFd = -1;
+  }
+  if (pQueue->eventFd >= 0) {
+    close(pQueue->eventFd);
+    pQueue->eventFd = -1;
+  }
+  skFree(pAllocator, pQueue->pDeviceFds);
+  pQueue->pDeviceFds = NULL;
+  pQueue->deviceFdCount = 0;
+}
+
+static SkResult skOpenPcmStreamQueueIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  int count;
+  uint32_t idx;
+  struct epoll_event event;
+  SkPcmQueueStateIMPL* pQueue;
+
+  // Each stream gets its own epoll set (the wakeup event, and the device),
+  // so that it's a single descriptor as far as the service threads see.
+  pQueue = &pStreamData->queue;
+  pQueue->pollFd = epoll_create1(EPOLL_CLOEXEC);
+  pQueue->eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (pQueue->pollFd < 0 || pQueue->eventFd < 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;
+  if (epoll_ctl(pQueue->pollFd, EPOLL_CTL_ADD, pQueue->eventFd, &event) < 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+
+  // The device descriptors are added disarmed (see skServicePcmStreamQueueIMPL).
+  count = snd_pcm_poll_descriptors_count(pStreamData->pcmHandle);
+  if (count <= 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  pQueue->pDeviceFds = skAllocate(
+    pAllocator,
+    sizeof(struct pollfd) * (size_t)count,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_STREAM
+  );
+  if (!pQueue->pDeviceFds) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  count = snd_pcm_poll_descriptors(pStreamData->pcmHandle, pQueue->pDeviceFds, (unsigned int)count);
+  if (count <= 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  pQueue->deviceFdCount = (uint32_t)count;
+  pQueue->isDeviceArmed = SK_FALSE;
+  for (idx = 0; idx < pQueue->deviceFdCount; ++idx) {
+    event.events = 0;
+    event.data.ptr = NULL;
+    if (epoll_ctl(pQueue->pollFd, EPOLL_CTL_ADD, pQueue->pDeviceFds[idx].fd, &event) < 0 && errno != EEXIST) {
+      return SK_ERROR_SYSTEM_INTERNAL;
+    }
+  }
+
+  // Service threads must never block on the device, they wait on epoll.
+  if (snd_pcm_nonblock(pStreamData->pcmHandle, 1) < 0) {
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  return SK_SUCCESS;
+}
+
+static SkResult skStartPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  SkResult result;
+  struct epoll_event event;
+  SkPcmQueueStateIMPL* pQueue;
+
+  result = skStartPcmQueueThreadsIMPL(driver);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+
+  // Allocate the queue the first time, rounded up to a power of two.
+  pQueue = &pStreamData->queue;
+  if (!pQueue->pFrames) {
+    pQueue->capacity = 1;
+    while (pQueue->capacity < SK_ASYNC_QUEUE_BUFFERS_IMPL * pStreamData->icdStreamInfo.hw.bufferSize) {
+      pQueue->capacity <<= 1;
+    }
+    pQueue->frameBytes = (size_t)snd_pcm_frames_to_bytes(pStreamData->pcmHandle, 1);
+    pQueue->pFrames = skAllocate(
+      driver->pAllocator,
+      pQueue->capacity * pQueue->frameBytes,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_STREAM
+    );
+    if (!pQueue->pFrames) {
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+
+  pQueue->pollFd = -1;
+  pQueue->eventFd = -1;
+  result = skOpenPcmStreamQueueIMPL(pStreamData, driver->pAllocator);
+  if (result != SK_SUCCESS) {
+    skClosePcmStreamQueueIMPL(pQueue, driver->pAllocator);
+    return result;
+  }
+
+  // The queue always starts out empty (and so, idle).
+  pQueue->readIndex = 0;
+  pQueue->writeIndex = 0;
+  pQueue->isIdle = 1;
+  pQueue->stopMode = SK_PCM_QUEUE_RUNNING_IMPL;
+  pQueue->failedError = 0;
+  pQueue->isStopped = SK_FALSE;
+  event.events = EPOLLIN | EPOLLONESHOT;
+  event.data.ptr = pStreamData;
+  if (epoll_ctl(driver->queueEpollFd, EPOLL_CTL_ADD, pQueue->pollFd, &event) < 0) {
+    (void)snd_pcm_nonblock(pStreamData->pcmHandle, (pStreamData->icdStreamInfo.hw.blockingMode & SND_PCM_NONBLOCK) != 0);
+    skClosePcmStreamQueueIMPL(pQueue, driver->pAllocator);
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  pQueue->isEnabled = SK_TRUE;
+  pQueue->isRunning = SK_TRUE;
+  pStreamData->streamInfo.accessFlags |= SK_ACCESS_ASYNC_BIT;
+  return SK_SUCCESS;
+}
+
+static void skStopPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkBool32                              drain
+) {
+  SkPcmQueueStateIMPL* pQueue;
+
+  // Let the service threads finish (or abandon) the queue, and wait for
+  // them to let go of the stream before it's taken out of the epoll set.
+  pQueue = &pStreamData->queue;
+  if (!pQueue->isRunning) {
+    return;
+  }
+  skAtomicStorePLT(&pQueue->stopMode, drain ? SK_PCM_QUEUE_DRAIN_IMPL : SK_PCM_QUEUE_DROP_IMPL);
+  skWakePcmStreamQueueIMPL(pQueue);
+  skLockMutexPLT(driver->queueMutex);
+  while (!pQueue->isStopped) {
+    skWaitConditionPLT(driver->queueCondition, driver->queueMutex);
+  }
+  skUnlockMutexPLT(driver->queueMutex);
+  (void)epoll_ctl(driver->queueEpollFd, EPOLL_CTL_DEL, pQueue->pollFd, NULL);
+  skClosePcmStreamQueueIMPL(pQueue, driver->pAllocator);
+
+  // Give the device back to the application the way that it was requested.
+  (void)snd_pcm_nonblock(pStreamData->pcmHandle, (pStreamData->icdStreamInfo.hw.blockingMode & SND_PCM_NONBLOCK) != 0);
+  pQueue->isRunning = SK_FALSE;
+}
+
+static SkResult skRecoverPcmStreamQueueIMPL(
+  SkDriver                              driver,
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  uint32_t error;
+  SkResult result;
+  SkResult queueResult;
+
+  // While the queue is healthy the service threads recover the device, this
+  // only has to synchronize with them.
+  error = skAtomicLoadPLT(&pStreamData->queue.failedError);
+  if (!error) {
+    skLockMutexPLT(driver->queueMutex);
+    result = skRecoverPcmStreamIMPL(pStreamData);
+    skUnlockMutexPLT(driver->queueMutex);
+    return result;
+  }
+
+  // Otherwise the service threads gave up on the device, so take it back,
+  // recover it, and start the queue again (anything still queued is dropped).
+  // Note: If the device can't be recovered, writes keep reporting the error.
+  skStopPcmStreamQueueIMPL(driver, pStreamData, SK_FALSE);
+  pStreamData->lastError = -(int)error;
+  result = skRecoverPcmStreamIMPL(pStreamData);
+  queueResult = skStartPcmStreamQueueIMPL(driver, pStreamData);
+  if (result != SK_SUCCESS) {
+    if (queueResult == SK_SUCCESS) {
+      skAtomicStorePLT(&pStreamData->queue.failedError, error);
+    }
+    return result;
+  }
+  return queueResult;
+}
+
+static uint32_t skGetPcmStreamQueueSpaceIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData
+) {
+  SkPcmQueueStateIMPL* pQueue;
+  pQueue = &pStreamData->queue;
+  return pQueue->capacity - (pQueue->writeIndex - skAtomicLoadPLT(&pQueue->readIndex));
+}
+
+// Note: If pSpans is NULL, silenceFrames of silence are queued instead.
+//       The samples are always consumed, whatever doesn't fit is dropped.
+static int64_t skEnqueuePcmStreamSpansIMPL(
+  SkPcmStreamDataIMPL*                  pStreamData,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount,
+  uint32_t                              silenceFrames
+) {
+  uint32_t idx;
+  uint32_t offset;
+  uint32_t error;
+  uint32_t readIndex;
+  uint32_t writeIndex;
+  uint32_t spanIndex;
+  uint32_t queuedFrames;
+  char* pFrames;
+  uint64_t totalFrames;
+  snd_pcm_uframes_t frames;
+  snd_pcm_uframes_t copied;
+  snd_pcm_uframes_t count;
+  snd_pcm_uframes_t spanOffset;
+  SkPcmQueueStateIMPL* pQueue;
+
+  // If the service thread couldn't recover the device, report why.
+  pQueue = &pStreamData->queue;
+  error = skAtomicLoadPLT(&pQueue->failedError);
+  if (error) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, -(int)error);
+  }
+
+  totalFrames = silenceFrames;
+  for (idx = 0; idx < spanCount; ++idx) {
+    totalFrames += pSpans[idx].samples;
+  }
+
+  // Only take as many frames as there is space for.
+  readIndex = skAtomicLoadPLT(&pQueue->readIndex);
+  writeIndex = pQueue->writeIndex;
+  frames = pQueue->capacity - (writeIndex - readIndex);
+  if (frames > totalFrames) {
+    frames = (snd_pcm_uframes_t)totalFrames;
+  }
+
+  // Copy into the queue, which wraps around at most once.
+  spanIndex = 0;
+  spanOffset = 0;
+  copied = 0;
+  while (copied < frames) {
+    offset = (writeIndex + (uint32_t)copied) & (pQueue->capacity - 1);
+    count = frames - copied;
+    if (count > pQueue->capacity - offset) {
+      count = pQueue->capacity - offset;
+    }
+    pFrames = pQueue->pFrames + offset * pQueue->frameBytes;
+    if (pSpans) {
+      count = skCopyPcmStreamSpansIMPL(pSpans, spanCount, &spanIndex, &spanOffset, pFrames, count, pQueue->frameBytes, SK_TRUE);
+    }
+    else {
+      snd_pcm_format_set_silence(
+        pStreamData->icdStreamInfo.hw.formatType,
+        pFrames,
+        (unsigned int)(count * pStreamData->icdStreamInfo.hw.channels)
+      );
+    }
+    copied += count;
+  }
+  skAtomicStorePLT(&pQueue->writeIndex, writeIndex + (uint32_t)frames);
+
+  // Wake the service threads if they ran out of samples for this stream.
+  skAtomicFencePLT();
+  if (frames && skAtomicLoadPLT(&pQueue->isIdle)) {
+    skWakePcmStreamQueueIMPL(pQueue);
+  }
+
+  // Report how deep the queue got, and what was dropped.
+  queuedFrames = writeIndex + (uint32_t)frames - readIndex;
+  if (queuedFrames > pStreamData->statistics.queueHighWaterMark) {
+    pStreamData->statistics.queueHighWaterMark = queuedFrames;
+  }
+  pStreamData->statistics.droppedSamples += totalFrames - frames;
+  return (int64_t)totalFrames;
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamv_alsa(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  int64_t frames;
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].queue.isRunning) {
+    return skEnqueuePcmStreamSpansIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], pSpans, spanCount, 0);
+  }
+  frames = skTransferPcmStreamSpansIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, pSpans, spanCount, 0);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].lastError)) {
+    frames = skTransferPcmStreamSpansIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, pSpans, spanCount, 0);
+  }
+  return frames;
+}
+
+static int64_t SKAPI_CALL skReadPcmStreamv_alsa(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  int64_t frames;
+  frames = skTransferPcmStreamSpansIMPL(stream, SK_PCM_STREAM_READ_INDEX_IMPL, pSpans, spanCount, 0);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_READ_INDEX_IMPL, stream->data[SK_PCM_STREAM_READ_INDEX_IMPL].lastError)) {
+    frames = skTransferPcmStreamSpansIMPL(stream, SK_PCM_STREAM_READ_INDEX_IMPL, pSpans, spanCount, 0);
+  }
+  return frames;
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamSilence_alsa(
+  SkPcmStream                           stream,
+  uint32_t                              samples
+) {
+  int64_t frames;
+  if (stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].queue.isRunning) {
+    return skEnqueuePcmStreamSpansIMPL(&stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL], NULL, 0, samples);
+  }
+  frames = skTransferPcmStreamSpansIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, NULL, 0, samples);
+  if (frames < 0 && skAutoRecoverPcmStreamIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL].lastError)) {
+    frames = skTransferPcmStreamSpansIMPL(stream, SK_PCM_STREAM_WRITE_INDEX_IMPL, NULL, 0, samples);
+  }
+  return frames;
+}
+
+static SkResult SKAPI_CALL skGetPcmStreamStatistics_alsa(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatistics*                pStatistics
+) {
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // Grab the stream index type.
+  switch (streamType) {
+    case SK_STREAM_PCM_READ_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_READ_INDEX_IMPL];
+      break;
+    case SK_STREAM_PCM_WRITE_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+      break;
+    default:
+      return SK_ERROR_INVALID;
+  }
+
+  // If this stream does not contain this kind of type, return that.
+  if (!pStreamData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Note: The service threads update the statistics of asynchronous streams.
+  if (pStreamData->queue.isRunning) {
+    skLockMutexPLT(skGetDriverIMPL(stream)->queueMutex);
+    *pStatistics = pStreamData->statistics;
+    skUnlockMutexPLT(skGetDriverIMPL(stream)->queueMutex);
+    return SK_SUCCESS;
+  }
+  *pStatistics = pStreamData->statistics;
+  return SK_SUCCESS;
+}
+
+static int64_t SKAPI_CALL skRewindPcmStream_alsa(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  snd_pcm_sframes_t frames;
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // Grab the stream index type.
+  switch (streamType) {
+    case SK_STREAM_PCM_READ_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_READ_INDEX_IMPL];
+      break;
+    case SK_STREAM_PCM_WRITE_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+      break;
+    default:
+      return SK_ERROR_INVALID;
+  }
+
+  // If this stream does not contain this kind of type, return that.
+  if (!pStreamData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Note: Queued samples belong to the service thread, they can't be moved.
+  if (pStreamData->queue.isRunning) {
+    return 0;
+  }
+
+  // Only rewind what is safe to, samples near the hardware are already gone.
+  frames = snd_pcm_rewindable(pStreamData->pcmHandle);
+  if (frames < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, (int)frames);
+  }
+  if ((snd_pcm_uframes_t)frames > samples) {
+    frames = samples;
+  }
+  frames = snd_pcm_rewind(pStreamData->pcmHandle, (snd_pcm_uframes_t)frames);
+  if (frames < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, (int)frames);
+  }
+  pStreamData->timer.transferredFrames -= (uint64_t)frames;
+  return frames;
+}
+
+static int64_t SKAPI_CALL skForwardPcmStream_alsa(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  snd_pcm_sframes_t frames;
+  SkPcmStreamDataIMPL* pStreamData;
+
+  // Grab the stream index type.
+  switch (streamType) {
+    case SK_STREAM_PCM_READ_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_READ_INDEX_IMPL];
+      break;
+    case SK_STREAM_PCM_WRITE_BIT:
+      pStreamData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+      break;
+    default:
+      return SK_ERROR_INVALID;
+  }
+
+  // If this stream does not contain this kind of type, return that.
+  if (!pStreamData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Note: Queued samples belong to the service thread, they can't be moved.
+  if (pStreamData->queue.isRunning) {
+    return 0;
+  }
+
+  // Only skip ahead as far as the buffer allows.
+  frames = snd_pcm_forwardable(pStreamData->pcmHandle);
+  if (frames < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, (int)frames);
+  }
+  if ((snd_pcm_uframes_t)frames > samples) {
+    frames = samples;
+  }
+  frames = snd_pcm_forward(pStreamData->pcmHandle, (snd_pcm_uframes_t)frames);
+  if (frames < 0) {
+    return skHandlePcmStreamErrorsIMPL(pStreamData, (int)frames);
+  }
+  pStreamData->timer.transferredFrames += (uint64_t)frames;
+  return frames;
+}
+
+static int64_t SKAPI_CALL skProcessPcmStreamInterleaved_alsa(
+  SkPcmStream                           stream,
+  PFN_skPcmStreamProcessCallback        pfnCallback,
+  void*                                 pUserData
+) {
+  uint32_t idx;
+  uint32_t samples;
+  SkResult result;
+  size_t readBytes;
+  size_t writeBytes;
+  void* pReadBuffer;
+  void* pWriteBuffer;
+  snd_pcm_sframes_t frames;
+  SkPcmStreamDataIMPL* pReadData;
+  SkPcmStreamDataIMPL* pWriteData;
+
+  if (!pfnCallback) {
+    return SK_ERROR_INVALID;
+  }
+
+  // Both directions must exist, and must agree on the size of a period.
+  pReadData = &stream->data[SK_PCM_STREAM_READ_INDEX_IMPL];
+  pWriteData = &stream->data[SK_PCM_STREAM_WRITE_INDEX_IMPL];
+  if (!pReadData->pcmHandle || !pWriteData->pcmHandle) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+  if (pReadData->icdStreamInfo.hw.accessMode != SND_PCM_ACCESS_RW_INTERLEAVED ||
+      pWriteData->icdStreamInfo.hw.accessMode != SND_PCM_ACCESS_RW_INTERLEAVED ||
+      pReadData->streamInfo.periodSamples != pWriteData->streamInfo.periodSamples ||
+      pWriteData->queue.isRunning) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+
+  // Allocate one period for each direction the first time it's processed.
+  samples = pReadData->streamInfo.periodSamples;
+  readBytes = (size_t)snd_pcm_frames_to_bytes(pReadData->pcmHandle, samples);
+  writeBytes = (size_t)snd_pcm_frames_to_bytes(pWriteData->pcmHandle, samples);
+  if (!stream->pProcessBuffer) {
+    stream->pProcessBuffer = skAllocate(
+      skGetDriverIMPL(stream)->pAllocator,
+      readBytes + writeBytes,
+      1,
+      SK_SYSTEM_ALLOCATION_SCOPE_STREAM
+    );
+    if (!stream->pProcessBuffer) {
+      return SK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+  }
+  pReadBuffer = stream->pProcessBuffer;
+  pWriteBuffer = (char*)stream->pProcessBuffer + readBytes;
+
+  // If the stream hasn't started, prime two periods of silence and start it.
+  // Note: One period isn't enough, playback would run dry at the exact moment
+  //       that the first period has been captured.
+  if (snd_pcm_state(pWriteData->pcmHandle) == SND_PCM_STATE_PREPARED) {
+    snd_pcm_format_set_silence(
+      pWriteData->icdStreamInfo.hw.formatType,
+      pWriteBuffer,
+      samples * pWriteData->streamInfo.channels
+    );
+    for (idx = 0; idx < 2; ++idx) {
+      frames = snd_pcm_writei(pWriteData->pcmHandle, pWriteBuffer, (snd_pcm_uframes_t)samples);
+      if (frames < 0) {
+        return skHandlePcmStreamErrorsIMPL(pWriteData, (int)frames);
+      }
+    }
+
+    // Note: The start threshold may have started playback (and anything it's
+    //       linked to) already, so only start what is still waiting.
+    for (idx = 0; idx < SK_PCM_STREAM_INDEX_SIZE; ++idx) {
+      if (snd_pcm_state(stream->data[idx].pcmHandle) == SND_PCM_STATE_PREPARED) {
+        result = skStartPcmStreamIMPL(&stream->data[idx]);
+        if (result != SK_SUCCESS) {
+          return result;
+        }
+      }
+    }
+  }
+
+  // Capture a period, let the callback produce the output, and play it.
+  frames = snd_pcm_readi(pReadData->pcmHandle, pReadBuffer, (snd_pcm_uframes_t)samples);
+  if (frames < 0) {
+    return skHandlePcmStreamErrorsIMPL(pReadData, (int)frames);
+  }
+  pfnCallback(pUserData, pReadBuffer, pWriteBuffer, (uint32_t)frames);
+  frames = snd_pcm_writei(pWriteData->pcmHandle, pWriteBuffer, (snd_pcm_uframes_t)frames);
+  if (frames < 0) {
+    return skHandlePcmStreamErrorsIMPL(pWriteData, (int)frames);
+  }
   return frames;
 }
 
@@ -2311,9 +5383,13 @@ SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetDriverProcAddr_alsa(
   HANDLE_PROC(skQueryDeviceFeatures);
   HANDLE_PROC(skQueryDeviceProperties);
   HANDLE_PROC(skEnumerateDeviceEndpoints);
+  HANDLE_PROC(skRegisterDeviceChangeCallback);
   HANDLE_PROC(skQueryEndpointFeatures);
   HANDLE_PROC(skQueryEndpointProperties);
+  HANDLE_PROC(skEnumerateEndpointPcmFormats);
   HANDLE_PROC(skRequestPcmStream);
+  HANDLE_PROC(skGetDriverTopologyVersion);
+  HANDLE_PROC(skConfigurePcmStreamPool);
   return NULL;
 }
 
@@ -2339,6 +5415,15 @@ SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetPcmStreamProcAddr_alsa(
   HANDLE_PROC(skWritePcmStreamNoninterleaved);
   HANDLE_PROC(skReadPcmStreamInterleaved);
   HANDLE_PROC(skReadPcmStreamNoninterleaved);
+  HANDLE_PROC(skProcessPcmStreamInterleaved);
+  HANDLE_PROC(skWritePcmStreamv);
+  HANDLE_PROC(skReadPcmStreamv);
+  HANDLE_PROC(skWritePcmStreamSilence);
+  HANDLE_PROC(skGetPcmStreamStatistics);
+  HANDLE_PROC(skAvailPcmStreamSamplesCached);
+  HANDLE_PROC(skQueryPcmStreamStatus);
+  HANDLE_PROC(skRewindPcmStream);
+  HANDLE_PROC(skForwardPcmStream);
   return NULL;
 }
 #undef HANDLE_PROC
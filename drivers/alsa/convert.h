@@ -175,6 +175,29 @@ static SkChannel skConvertFromLocalChannelIMPL(
   }
 }
 
+static SkPcmStreamState skConvertFromLocalPcmStateIMPL(
+  snd_pcm_state_t                       state
+) {
+  switch (state) {
+    case SND_PCM_STATE_PREPARED:
+      return SK_PCM_STREAM_STATE_PREPARED;
+    case SND_PCM_STATE_RUNNING:
+      return SK_PCM_STREAM_STATE_RUNNING;
+    case SND_PCM_STATE_XRUN:
+      return SK_PCM_STREAM_STATE_XRUN;
+    case SND_PCM_STATE_DRAINING:
+      return SK_PCM_STREAM_STATE_DRAINING;
+    case SND_PCM_STATE_PAUSED:
+      return SK_PCM_STREAM_STATE_PAUSED;
+    case SND_PCM_STATE_SUSPENDED:
+      return SK_PCM_STREAM_STATE_SUSPENDED;
+    case SND_PCM_STATE_DISCONNECTED:
+      return SK_PCM_STREAM_STATE_DISCONNECTED;
+    default:
+      return SK_PCM_STREAM_STATE_UNKNOWN;
+  }
+}
+
 static snd_pcm_format_t skConvertToLocalPcmFormatIMPL(
   SkPcmFormat                           format
 ) {
@@ -19,15 +19,19 @@
 // OpenSK
 #include <OpenSK/dev/md5.h>
 #include <OpenSK/ext/sk_global.h>
+#include <OpenSK/plt/platform.h>
 
 // C99
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <errno.h>
 
 // Non-Standard
 #include <dlfcn.h>
 #include <libudev.h>
+#include <poll.h>
+#include <unistd.h>
 
 // Internal
 #include "udev.h"
@@ -46,6 +50,15 @@
 typedef struct SkUDevIMPL_T {
   SkAllocationCallbacks const*          pAllocator;
   struct udev*                          udev;
+  struct udev_monitor*                  monitor;
+  SkThreadPLT                           monitorThread;
+  uint64_t volatile                     monitorThreadId;
+  int                                   wakeDescriptors[2];
+  PFN_skUDevChangeCallbackIMPL          pfnCallback;
+  void*                                 pUserData;
+  uint32_t volatile                     changeCount;
+  uint32_t                              scannedChangeCount;
+  SkBool32                              isScanned;
   uint32_t                              udeviceCount;
   uint32_t                              udeviceCapacity;
   SkUDeviceInfoIMPL*                    pUDeviceInfo;
@@ -90,6 +103,80 @@ static uint32_t parseHexadecimal(char const* pString) {
   return result;
 }
 
+static uint32_t skDrainUDevMonitorIMPL(
+  SkUDevIMPL                            udev
+) {
+  uint32_t count;
+  struct pollfd pollDescriptor;
+  struct udev_device* uDevice;
+
+  // Receive every pending event without blocking.
+  // Note: We only need to know that something changed, the next scan will
+  //       pick up the actual changes. Plugging in a single card will usually
+  //       produce a burst of events (card, control, pcm, midi...).
+  count = 0;
+  pollDescriptor.fd = udev_monitor_get_fd(udev->monitor);
+  pollDescriptor.events = POLLIN;
+  while (poll(&pollDescriptor, 1, 0) > 0) {
+    uDevice = udev_monitor_receive_device(udev->monitor);
+    if (!uDevice) {
+      break;
+    }
+    udev_device_unref(uDevice);
+    ++count;
+  }
+
+  return count;
+}
+
+static void SKAPI_PTR skRunUDevMonitorIMPL(
+  void*                                 pUserData
+) {
+  SkUDevIMPL udev;
+  struct pollfd pollDescriptors[2];
+
+  // Wait for either hotplug events, or for the wake pipe to be written to.
+  udev = pUserData;
+  udev->monitorThreadId = skGetCurrentThreadIdPLT();
+  pollDescriptors[0].fd = udev_monitor_get_fd(udev->monitor);
+  pollDescriptors[0].events = POLLIN;
+  pollDescriptors[1].fd = udev->wakeDescriptors[0];
+  pollDescriptors[1].events = POLLIN;
+  for (;;) {
+    if (poll(pollDescriptors, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    if (pollDescriptors[1].revents) {
+      break;
+    }
+    if (skDrainUDevMonitorIMPL(udev)) {
+      skAtomicIncrementPLT(&udev->changeCount);
+      udev->pfnCallback(udev->pUserData);
+    }
+  }
+}
+
+static void skStopUDevMonitorThreadIMPL(
+  SkUDevIMPL                            udev
+) {
+  if (!udev->monitorThread) {
+    return;
+  }
+
+  // Wake the monitor thread, and wait for it to exit.
+  while (write(udev->wakeDescriptors[1], "", 1) < 0 && errno == EINTR);
+  skJoinThreadPLT(udev->pAllocator, udev->monitorThread);
+  close(udev->wakeDescriptors[0]);
+  close(udev->wakeDescriptors[1]);
+  udev->monitorThread = NULL;
+  udev->monitorThreadId = 0;
+  udev->wakeDescriptors[0] = -1;
+  udev->wakeDescriptors[1] = -1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,6 +207,21 @@ SKAPI_ATTR SkResult SKAPI_CALL skCreateUDevIMPL(
   }
   udev->udev = udevInternal;
   udev->pAllocator = pAllocator;
+  udev->wakeDescriptors[0] = -1;
+  udev->wakeDescriptors[1] = -1;
+
+  // Start listening for hotplug events before the first scan, so that no
+  // event can be missed between scanning and monitoring.
+  // Note: If this fails (e.g. no netlink access), we simply scan every time.
+  udev->monitor = udev_monitor_new_from_netlink(udevInternal, "udev");
+  if (udev->monitor) {
+    if (udev_monitor_filter_add_match_subsystem_devtype(udev->monitor, "sound", NULL) < 0
+    ||  udev_monitor_enable_receiving(udev->monitor) < 0
+    ) {
+      udev_monitor_unref(udev->monitor);
+      udev->monitor = NULL;
+    }
+  }
 
   // Note: No need to allocate, everyone shares one udev instance.
   *pUdev = udev;
@@ -131,6 +233,10 @@ SKAPI_ATTR void SKAPI_CALL skDestroyUDevIMPL(
   SkUDevIMPL                            udev,
   SkAllocationCallbacks const*          pAllocator
 ) {
+  skStopUDevMonitorThreadIMPL(udev);
+  if (udev->monitor) {
+    udev_monitor_unref(udev->monitor);
+  }
   skFree(pAllocator, udev->pUDeviceInfo);
   udev_unref(udev->udev);
   skFree(pAllocator, udev);
@@ -157,7 +263,10 @@ static SkResult skInitializeUDevDeviceIMPL(
 ) {
   MD5_CTX ctx;
   char const* pCharConst;
+  uint32_t udeviceCapacity;
   SkUDeviceInfoIMPL deviceInfo;
+  SkUDeviceInfoIMPL* pUDeviceInfo;
+  memset(&deviceInfo, 0, sizeof(SkUDeviceInfoIMPL));
 
   // Find the audio subsystem:ALSA device pairing.
   pCharConst = udev_device_get_sysnum(uDevice);
@@ -249,21 +358,21 @@ static SkResult skInitializeUDevDeviceIMPL(
   }
 
   // Grow the udevice info array if needed
+  // Note: The old array is kept on failure, so that the next scan can reuse it.
   if (udev->udeviceCount >= udev->udeviceCapacity) {
-    if (!udev->udeviceCapacity) {
-      udev->udeviceCapacity = 1;
-    }
-    udev->udeviceCapacity *= 2;
-    udev->pUDeviceInfo = skReallocate(
+    udeviceCapacity = (udev->udeviceCapacity) ? udev->udeviceCapacity * 2 : 2;
+    pUDeviceInfo = skReallocate(
       udev->pAllocator,
       udev->pUDeviceInfo,
-      sizeof(SkUDeviceInfoIMPL) * udev->udeviceCapacity,
+      sizeof(SkUDeviceInfoIMPL) * udeviceCapacity,
       1,
       SK_SYSTEM_ALLOCATION_SCOPE_DRIVER
     );
-    if (!udev->pUDeviceInfo) {
+    if (!pUDeviceInfo) {
       return SK_ERROR_OUT_OF_HOST_MEMORY;
     }
+    udev->pUDeviceInfo = pUDeviceInfo;
+    udev->udeviceCapacity = udeviceCapacity;
   }
 
   // Copy the udevice info into the array.
@@ -311,6 +420,7 @@ static SkResult skScanUDevDevicesIMPL(
   SkUDevIMPL                            udev
 ) {
   char const *path;
+  SkResult result;
   struct udev_device* device;
   struct udev_enumerate* enumerate;
   struct udev_list_entry* devices, *iterator;
@@ -320,36 +430,122 @@ static SkResult skScanUDevDevicesIMPL(
 
   // Enumerate all "sound" subsystem devices
   enumerate = udev_enumerate_new(udev->udev);
+  if (!enumerate) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
   udev_enumerate_add_match_subsystem(enumerate, "sound");
   udev_enumerate_scan_devices(enumerate);
   devices = udev_enumerate_get_list_entry(enumerate);
 
   // Process each subsystem device
+  // Note: Devices which can't be read (or aren't recognized) are skipped, only
+  //       running out of memory makes the scan incomplete.
+  result = SK_SUCCESS;
   udev_list_entry_foreach(iterator, devices) {
     path = udev_list_entry_get_name(iterator);
     device = udev_device_new_from_syspath(udev->udev, path);
-    skAddOrUpdateDeviceIMPL(udev, device);
+    if (!device) {
+      continue;
+    }
+    result = skAddOrUpdateDeviceIMPL(udev, device);
     udev_device_unref(device);
+    if (result == SK_ERROR_OUT_OF_HOST_MEMORY) {
+      break;
+    }
+    result = SK_SUCCESS;
   }
   udev_enumerate_unref(enumerate);
 
-  return SK_SUCCESS;
+  return result;
 }
 
-SKAPI_ATTR SkResult SKAPI_CALL skEnumerateUDevDevicesIMPL(
+SKAPI_ATTR SkBool32 SKAPI_CALL skUpdateUDevDevicesIMPL(
+  SkUDevIMPL                            udev
+) {
+  uint32_t changeCount;
+
+  // Without a monitor, there is no way to know if anything changed.
+  // Note: Every update is a full scan, so a failed scan is retried regardless.
+  if (!udev->monitor) {
+    (void)skScanUDevDevicesIMPL(udev);
+    return SK_TRUE;
+  }
+
+  // If the monitor thread isn't running, we must process the events here.
+  if (!udev->monitorThread && skDrainUDevMonitorIMPL(udev)) {
+    skAtomicIncrementPLT(&udev->changeCount);
+  }
+
+  // Only rescan if an event has been received since the last scan.
+  changeCount = udev->changeCount;
+  if (udev->isScanned && changeCount == udev->scannedChangeCount) {
+    return SK_FALSE;
+  }
+  // Note: If the scan fails, the device list is incomplete but still changed.
+  //       Leaving it unscanned makes the next update try again.
+  udev->isScanned = SK_FALSE;
+  if (skScanUDevDevicesIMPL(udev) == SK_SUCCESS) {
+    udev->scannedChangeCount = changeCount;
+    udev->isScanned = SK_TRUE;
+  }
+  return SK_TRUE;
+}
+
+SKAPI_ATTR SkResult SKAPI_CALL skSetUDevChangeCallbackIMPL(
   SkUDevIMPL                            udev,
-  uint32_t*                             pDeviceCount,
-  SkUDeviceInfoIMPL*                    pDevices
+  PFN_skUDevChangeCallbackIMPL          pfnCallback,
+  void*                                 pUserData
 ) {
-  uint32_t count;
   SkResult result;
 
-  // Update the internal device list.
-  result = skScanUDevDevicesIMPL(udev);
+  // The monitor thread can't stop itself (it would wait on its own exit).
+  if (udev->monitorThread && udev->monitorThreadId == skGetCurrentThreadIdPLT()) {
+    return SK_ERROR_INVALID;
+  }
+
+  // Note: The thread is always stopped while the callback changes, this way
+  //       the monitor thread never has to synchronize with the caller.
+  skStopUDevMonitorThreadIMPL(udev);
+  udev->pfnCallback = pfnCallback;
+  udev->pUserData = pUserData;
+  if (!pfnCallback) {
+    return SK_SUCCESS;
+  }
+  if (!udev->monitor) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+
+  // Start the monitor thread, with a pipe which is used to wake it on exit.
+  if (pipe(udev->wakeDescriptors) != 0) {
+    udev->wakeDescriptors[0] = -1;
+    udev->wakeDescriptors[1] = -1;
+    return SK_ERROR_SYSTEM_INTERNAL;
+  }
+  result = skCreateThreadPLT(
+    udev->pAllocator,
+    &skRunUDevMonitorIMPL,
+    udev,
+    &udev->monitorThread
+  );
   if (result != SK_SUCCESS) {
+    close(udev->wakeDescriptors[0]);
+    close(udev->wakeDescriptors[1]);
+    udev->monitorThread = NULL;
+    udev->wakeDescriptors[0] = -1;
+    udev->wakeDescriptors[1] = -1;
     return result;
   }
 
+  return SK_SUCCESS;
+}
+
+SKAPI_ATTR SkResult SKAPI_CALL skEnumerateUDevDevicesIMPL(
+  SkUDevIMPL                            udev,
+  uint32_t*                             pDeviceCount,
+  SkUDeviceInfoIMPL*                    pDevices
+) {
+  uint32_t count;
+
   // Return the device count if it's requested.
   if (!pDevices) {
     *pDeviceCount = udev->udeviceCount;
@@ -357,12 +553,13 @@ SKAPI_ATTR SkResult SKAPI_CALL skEnumerateUDevDevicesIMPL(
   }
 
   // Otherwise return the device information.
-  for (count = 0; count < *pDeviceCount; ++count) {
+  for (count = 0; count < udev->udeviceCount; ++count) {
     if (count >= *pDeviceCount) {
       return SK_INCOMPLETE;
     }
     memcpy(&pDevices[count], &udev->pUDeviceInfo[count], sizeof(SkUDeviceInfoIMPL));
   }
 
+  *pDeviceCount = count;
   return SK_SUCCESS;
 }
@@ -29,6 +29,10 @@
 
 SK_DEFINE_HANDLE(SkUDevIMPL);
 
+typedef void (SKAPI_PTR *PFN_skUDevChangeCallbackIMPL)(
+  void*                                 pUserData
+);
+
 typedef struct SkUDeviceInfoIMPL {
   uint32_t                              vendorId;
   uint32_t                              modelId;
@@ -52,6 +56,23 @@ SKAPI_ATTR void SKAPI_CALL skDestroyUDevIMPL(
   SkAllocationCallbacks const*          pAllocator
 );
 
+// Applies any pending hotplug events to the device list (scanning if needed).
+// Returns SK_TRUE if the device list may have changed since the last call.
+// Note: If hotplug events cannot be monitored, every call is a full scan.
+SKAPI_ATTR SkBool32 SKAPI_CALL skUpdateUDevDevicesIMPL(
+  SkUDevIMPL                            udev
+);
+
+// Starts (or stops, if pfnCallback is NULL) a thread which calls pfnCallback
+// whenever hotplug events arrive. Any previous callback is replaced.
+// Note: Returns SK_ERROR_INVALID if called from within pfnCallback.
+SKAPI_ATTR SkResult SKAPI_CALL skSetUDevChangeCallbackIMPL(
+  SkUDevIMPL                            udev,
+  PFN_skUDevChangeCallbackIMPL          pfnCallback,
+  void*                                 pUserData
+);
+
+// Returns the device list as of the last call to skUpdateUDevDevicesIMPL.
 SKAPI_ATTR SkResult SKAPI_CALL skEnumerateUDevDevicesIMPL(
   SkUDevIMPL                            udev,
   uint32_t*                             pDeviceCount,
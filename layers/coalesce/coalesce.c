@@ -0,0 +1,599 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * A layer which batches small interleaved writes into period-sized writes, so
+ * that producers which write a few samples at a time don't pay for a trip into
+ * the driver (and usually the kernel) for every one of those writes.
+ * Note: The layer runs no thread of its own, so a partial period is only ever
+ *       submitted from inside a call into the stream: by the next write or
+ *       wait once it has been held for a period, or straight away by calls
+ *       which flush (e.g. skFlushPcmStream, skStopPcmStream). Producers which
+ *       go quiet must call skFlushPcmStream, or the tail is held until then.
+ ******************************************************************************/
+
+// OpenSK
+#include <OpenSK/ext/sk_layer.h>
+#include <OpenSK/plt/platform.h>
+
+// C99
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Layer Definitions
+////////////////////////////////////////////////////////////////////////////////
+
+#define SK_LAYER_OPENSK_COALESCE_NAME "SK_LAYER_OPENSK_COALESCE"
+#define SK_LAYER_OPENSK_COALESCE_DISPLAY_NAME "OpenSK (Write Coalescing Layer)"
+#define SK_LAYER_OPENSK_COALESCE_DESCRIPTION "A layer which batches small PCM writes into period-sized writes."
+#define SK_LAYER_OPENSK_COALESCE_UUID_STRING "3f0c6d52-8a41-4e27-b9d3-5c1e7a2f9b64"
+#define SK_LAYER_OPENSK_COALESCE_UUID SK_INTERNAL_CREATE_UUID(SK_LAYER_OPENSK_COALESCE_UUID_STRING)
+
+// Note: The staging area is set up on the first write, since that's the first
+//       point where the driver is guaranteed to know the write stream's period.
+//       If the stream can't be coalesced, pStaging stays NULL after that.
+typedef struct SkPcmStreamLayer_T {
+  SK_INTERNAL_OBJECT_BASE;
+  SkAllocationCallbacks const*          pAllocator;
+  SkBool32                              isConfigured;
+  uint8_t*                              pStaging;
+  size_t                                frameBytes;
+  uint32_t                              periodSamples;
+  uint32_t                              stagedSamples;
+  uint64_t                              stagedTime;
+  uint64_t                              deadline;
+} SkPcmStreamLayer_T;
+
+void SKAPI_CALL skGetLayerProperties_coalesce(
+  SkLayerProperties*                    pProperties
+) {
+  pProperties->apiVersion = SK_API_VERSION_0_0;
+  pProperties->implVersion = SK_MAKE_VERSION(0, 0, 0);
+  strcpy(pProperties->layerName, SK_LAYER_OPENSK_COALESCE_NAME);
+  strcpy(pProperties->displayName, SK_LAYER_OPENSK_COALESCE_DISPLAY_NAME);
+  strcpy(pProperties->description, SK_LAYER_OPENSK_COALESCE_DESCRIPTION);
+  memcpy(pProperties->layerUuid, SK_LAYER_OPENSK_COALESCE_UUID, SK_UUID_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Layer Helper Functions
+////////////////////////////////////////////////////////////////////////////////
+
+static void skConfigureStagingIMPL(
+  SkPcmStream                           stream,
+  SkPcmStreamLayer                      layer,
+  SkPcmStreamFunctionTable const*       vtable
+) {
+  SkResult result;
+  SkPcmStreamInfo streamInfo;
+
+  // Only interleaved streams with a known period can be coalesced.
+  layer->isConfigured = SK_TRUE;
+  result = vtable->pfnGetPcmStreamInfo(stream, SK_STREAM_PCM_WRITE_BIT, &streamInfo);
+  if (result != SK_SUCCESS) {
+    return;
+  }
+  if (!(streamInfo.accessFlags & SK_ACCESS_INTERLEAVED_BIT)) {
+    return;
+  }
+  if (!streamInfo.periodSamples || !streamInfo.frameBits || !streamInfo.sampleRate) {
+    return;
+  }
+
+  // Partial periods become due for submission once they've waited a period.
+  // Note: They're only checked on the next call (see the note at the top).
+  layer->frameBytes = streamInfo.frameBits / 8;
+  layer->periodSamples = streamInfo.periodSamples;
+  layer->deadline = (uint64_t)streamInfo.periodSamples * 1000000000ull / streamInfo.sampleRate;
+  layer->pStaging = skAllocate(
+    layer->pAllocator,
+    layer->frameBytes * layer->periodSamples,
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_STREAM
+  );
+}
+
+static SkResult skFlushStagingIMPL(
+  SkPcmStream                           stream,
+  SkPcmStreamLayer                      layer,
+  SkPcmStreamFunctionTable const*       vtable
+) {
+  int64_t samples;
+
+  // Keep whatever the driver doesn't accept, so that nothing is lost.
+  while (layer->stagedSamples) {
+    samples = vtable->pfnWritePcmStreamInterleaved(stream, layer->pStaging, layer->stagedSamples);
+    if (samples < 0) {
+      return (SkResult)samples;
+    }
+    if (samples == 0) {
+      return SK_ERROR_BUSY;
+    }
+    layer->stagedSamples -= (uint32_t)samples;
+    memmove(
+      layer->pStaging,
+      layer->pStaging + (size_t)samples * layer->frameBytes,
+      layer->stagedSamples * layer->frameBytes
+    );
+  }
+
+  return SK_SUCCESS;
+}
+
+static SkResult skFlushExpiredStagingIMPL(
+  SkPcmStream                           stream,
+  SkPcmStreamLayer                      layer,
+  SkPcmStreamFunctionTable const*       vtable
+) {
+  if (!layer->stagedSamples) {
+    return SK_SUCCESS;
+  }
+  if (skGetMonotonicTimePLT() - layer->stagedTime < layer->deadline) {
+    return SK_SUCCESS;
+  }
+  return skFlushStagingIMPL(stream, layer, vtable);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SkPcmStreamLayer
+// Note: To be a valid PCM layer, you MUST implement skCreatePcmStream() and
+//       skDestroyPcmStream(). All other PCM functions are optional.
+////////////////////////////////////////////////////////////////////////////////
+static SkResult SKAPI_CALL skCreatePcmStream_coalesce(
+  SkPcmStreamCreateInfo const*          pCreateInfo,
+  SkAllocationCallbacks const*          pAllocator,
+  SkPcmStream*                          pStream
+) {
+  SkPcmStreamLayer layer;
+
+  layer = skClearAllocate(
+    pAllocator,
+    sizeof(SkPcmStreamLayer_T),
+    1,
+    SK_SYSTEM_ALLOCATION_SCOPE_STREAM
+  );
+  if (!layer) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  layer->pAllocator = pAllocator;
+
+  return skInitializePcmStreamLayerBase(
+    pCreateInfo,
+    pAllocator,
+    layer,
+    SK_LAYER_OPENSK_COALESCE_UUID,
+    pStream
+  );
+}
+
+static void SKAPI_CALL skDestroyPcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkAllocationCallbacks const*          pAllocator
+) {
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  vtable->pfnDestroyPcmStream(stream, pAllocator);
+  skFree(pAllocator, layer->pStaging);
+  skDeinitializePcmStreamLayerBase(pAllocator, layer);
+  skFree(pAllocator, layer);
+}
+
+static SkResult SKAPI_CALL skClosePcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkBool32                              drain
+) {
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (drain) {
+    (void)skFlushStagingIMPL(stream, layer, vtable);
+  }
+  layer->stagedSamples = 0;
+  return vtable->pfnClosePcmStream(stream, drain);
+}
+
+static SkResult SKAPI_CALL skStartPcmStream_coalesce(
+  SkPcmStream                           stream
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  result = skFlushStagingIMPL(stream, layer, vtable);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  return vtable->pfnStartPcmStream(stream);
+}
+
+static SkResult SKAPI_CALL skStopPcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkBool32                              drain
+) {
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (drain) {
+    (void)skFlushStagingIMPL(stream, layer, vtable);
+  }
+  layer->stagedSamples = 0;
+  return vtable->pfnStopPcmStream(stream, drain);
+}
+
+static SkResult SKAPI_CALL skPausePcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkBool32                              pause
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (pause) {
+    result = skFlushStagingIMPL(stream, layer, vtable);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+  return vtable->pfnPausePcmStream(stream, pause);
+}
+
+static SkResult SKAPI_CALL skWaitPcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  int32_t                               timeout
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (streamType == SK_STREAM_PCM_WRITE_BIT) {
+    result = skFlushExpiredStagingIMPL(stream, layer, vtable);
+    if (result != SK_SUCCESS && result != SK_ERROR_BUSY) {
+      return result;
+    }
+  }
+  return vtable->pfnWaitPcmStream(stream, streamType, timeout);
+}
+
+static SkResult SKAPI_CALL skAvailPcmStreamSamples_coalesce(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t*                             pSamples
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  result = vtable->pfnAvailPcmStreamSamples(stream, streamType, pSamples);
+  if (result != SK_SUCCESS || streamType != SK_STREAM_PCM_WRITE_BIT) {
+    return result;
+  }
+
+  // Note: Samples which are staged already take up space in the device.
+  *pSamples = (*pSamples > layer->stagedSamples) ? *pSamples - layer->stagedSamples : 0;
+  return SK_SUCCESS;
+}
+
+static SkResult SKAPI_CALL skAvailPcmStreamSamplesCached_coalesce(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t*                             pSamples
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (vtable->pfnAvailPcmStreamSamplesCached) {
+    result = vtable->pfnAvailPcmStreamSamplesCached(stream, streamType, pSamples);
+  }
+  else {
+    result = vtable->pfnAvailPcmStreamSamples(stream, streamType, pSamples);
+  }
+  if (result != SK_SUCCESS || streamType != SK_STREAM_PCM_WRITE_BIT) {
+    return result;
+  }
+  *pSamples = (*pSamples > layer->stagedSamples) ? *pSamples - layer->stagedSamples : 0;
+  return SK_SUCCESS;
+}
+
+static SkResult SKAPI_CALL skQueryPcmStreamStatus_coalesce(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatus*                    pStatus
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (!vtable->pfnQueryPcmStreamStatus) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  result = vtable->pfnQueryPcmStreamStatus(stream, streamType, pStatus);
+  if (result != SK_SUCCESS || streamType != SK_STREAM_PCM_WRITE_BIT) {
+    return result;
+  }
+  if (pStatus->availableSamples > layer->stagedSamples) {
+    pStatus->availableSamples -= layer->stagedSamples;
+  }
+  else {
+    pStatus->availableSamples = 0;
+  }
+  pStatus->delaySamples += layer->stagedSamples;
+  return SK_SUCCESS;
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamInterleaved_coalesce(
+  SkPcmStream                           stream,
+  void const*                           pBuffer,
+  uint32_t                              samples
+) {
+  int64_t written;
+  SkResult result;
+  uint32_t count;
+  uint32_t accepted;
+  uint32_t remaining;
+  uint8_t const* pSource;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (!layer->isConfigured) {
+    skConfigureStagingIMPL(stream, layer, vtable);
+  }
+  if (!layer->pStaging) {
+    return vtable->pfnWritePcmStreamInterleaved(stream, pBuffer, samples);
+  }
+
+  pSource = pBuffer;
+  accepted = 0;
+  while (accepted < samples) {
+
+    // A full staging area must be submitted before anything else is taken.
+    if (layer->stagedSamples == layer->periodSamples) {
+      result = skFlushStagingIMPL(stream, layer, vtable);
+      if (result != SK_SUCCESS) {
+        return (accepted) ? (int64_t)accepted : result;
+      }
+    }
+
+    // Whole periods skip the staging area, if there's nothing staged before them.
+    remaining = samples - accepted;
+    if (!layer->stagedSamples && remaining >= layer->periodSamples) {
+      count = remaining - remaining % layer->periodSamples;
+      written = vtable->pfnWritePcmStreamInterleaved(stream, pSource + (size_t)accepted * layer->frameBytes, count);
+      if (written < 0) {
+        return (accepted) ? (int64_t)accepted : written;
+      }
+      accepted += (uint32_t)written;
+      if (written < count) {
+        return accepted;
+      }
+      continue;
+    }
+
+    // Otherwise, top up the staging area.
+    count = layer->periodSamples - layer->stagedSamples;
+    if (count > remaining) {
+      count = remaining;
+    }
+    if (!layer->stagedSamples) {
+      layer->stagedTime = skGetMonotonicTimePLT();
+    }
+    memcpy(
+      layer->pStaging + (size_t)layer->stagedSamples * layer->frameBytes,
+      pSource + (size_t)accepted * layer->frameBytes,
+      (size_t)count * layer->frameBytes
+    );
+    layer->stagedSamples += count;
+    accepted += count;
+  }
+
+  // Submit a full period right away, and a partial one once it has waited too long.
+  // Note: An error here is reported by the next call, these samples were accepted.
+  if (layer->stagedSamples == layer->periodSamples) {
+    (void)skFlushStagingIMPL(stream, layer, vtable);
+  }
+  else {
+    (void)skFlushExpiredStagingIMPL(stream, layer, vtable);
+  }
+  return accepted;
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamNoninterleaved_coalesce(
+  SkPcmStream                           stream,
+  void**                                pBuffer,
+  uint32_t                              samples
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  result = skFlushStagingIMPL(stream, layer, vtable);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  return vtable->pfnWritePcmStreamNoninterleaved(stream, pBuffer, samples);
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamv_coalesce(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+
+  // Spans are already batched, so they only need to follow what's staged.
+  if (vtable->pfnWritePcmStreamv) {
+    result = skFlushStagingIMPL(stream, layer, vtable);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+    return vtable->pfnWritePcmStreamv(stream, pSpans, spanCount);
+  }
+
+  // Note: Otherwise, coalescing the spans is exactly what this layer does.
+  return skWritePcmStreamvBase(
+    stream,
+    (PFN_skWritePcmStreamInterleaved)(PFN_skVoidFunction)&skWritePcmStreamInterleaved_coalesce,
+    pSpans,
+    spanCount
+  );
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamSilence_coalesce(
+  SkPcmStream                           stream,
+  uint32_t                              samples
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (!vtable->pfnWritePcmStreamSilence) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  result = skFlushStagingIMPL(stream, layer, vtable);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  return vtable->pfnWritePcmStreamSilence(stream, samples);
+}
+
+static int64_t SKAPI_CALL skProcessPcmStreamInterleaved_coalesce(
+  SkPcmStream                           stream,
+  PFN_skPcmStreamProcessCallback        pfnCallback,
+  void*                                 pUserData
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (!vtable->pfnProcessPcmStreamInterleaved) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  result = skFlushStagingIMPL(stream, layer, vtable);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  return vtable->pfnProcessPcmStreamInterleaved(stream, pfnCallback, pUserData);
+}
+
+static SkResult SKAPI_CALL skFlushPcmStream_coalesce(
+  SkPcmStream                           stream
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  result = skFlushStagingIMPL(stream, layer, vtable);
+  if (result != SK_SUCCESS || !vtable->pfnFlushPcmStream) {
+    return result;
+  }
+  return vtable->pfnFlushPcmStream(stream);
+}
+
+static int64_t SKAPI_CALL skRewindPcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  int64_t rewound;
+  uint32_t count;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+
+  // The most recently written samples are staged, so those are taken back first.
+  count = 0;
+  if (streamType == SK_STREAM_PCM_WRITE_BIT) {
+    count = (samples < layer->stagedSamples) ? samples : layer->stagedSamples;
+    layer->stagedSamples -= count;
+    samples -= count;
+  }
+  if (!samples) {
+    return count;
+  }
+  if (!vtable->pfnRewindPcmStream) {
+    return (count) ? (int64_t)count : SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  rewound = vtable->pfnRewindPcmStream(stream, streamType, samples);
+  if (rewound < 0) {
+    return (count) ? (int64_t)count : rewound;
+  }
+  return count + rewound;
+}
+
+static int64_t SKAPI_CALL skForwardPcmStream_coalesce(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  SkResult result;
+  SkPcmStreamLayer layer;
+  SkPcmStreamFunctionTable const* vtable;
+  layer = skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable);
+  if (!vtable->pfnForwardPcmStream) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  if (streamType == SK_STREAM_PCM_WRITE_BIT) {
+    result = skFlushStagingIMPL(stream, layer, vtable);
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+  return vtable->pfnForwardPcmStream(stream, streamType, samples);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Layer Entrypoint
+////////////////////////////////////////////////////////////////////////////////
+
+#define HANDLE_PROC(name)                                                       \
+if (strcmp(pName, #name) == 0) return (PFN_skVoidFunction)&name##_coalesce
+SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetPcmStreamProcAddr_coalesce(
+  SkPcmStream                           pcmStream,
+  char const*                           pName
+) {
+  SkPcmStreamFunctionTable const* vtable;
+
+  // PcmStream Core 1.0
+  // Note: Only calls which interact with staged samples are intercepted.
+  HANDLE_PROC(skGetPcmStreamProcAddr);
+  HANDLE_PROC(skGetLayerProperties);
+  HANDLE_PROC(skCreatePcmStream);
+  HANDLE_PROC(skDestroyPcmStream);
+  HANDLE_PROC(skClosePcmStream);
+  HANDLE_PROC(skStartPcmStream);
+  HANDLE_PROC(skStopPcmStream);
+  HANDLE_PROC(skWaitPcmStream);
+  HANDLE_PROC(skPausePcmStream);
+  HANDLE_PROC(skAvailPcmStreamSamples);
+  HANDLE_PROC(skWritePcmStreamInterleaved);
+  HANDLE_PROC(skWritePcmStreamNoninterleaved);
+  HANDLE_PROC(skProcessPcmStreamInterleaved);
+  HANDLE_PROC(skWritePcmStreamv);
+  HANDLE_PROC(skWritePcmStreamSilence);
+  HANDLE_PROC(skAvailPcmStreamSamplesCached);
+  HANDLE_PROC(skQueryPcmStreamStatus);
+  HANDLE_PROC(skFlushPcmStream);
+  HANDLE_PROC(skRewindPcmStream);
+  HANDLE_PROC(skForwardPcmStream);
+  if (!skGetPcmStreamLayer(pcmStream, SK_LAYER_OPENSK_COALESCE_UUID, &vtable)) {
+    return NULL;
+  }
+  return vtable->pfnGetPcmStreamProcAddr(pcmStream, pName);
+}
+#undef HANDLE_PROC
@@ -503,6 +503,165 @@ static int64_t SKAPI_CALL skReadPcmStreamNoninterleaved_validation(
   return result;
 }
 
+static int64_t SKAPI_CALL skWritePcmStreamv_validation(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  uint32_t idx;
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  assert(pSpans || !spanCount);
+  for (idx = 0; idx < spanCount; ++idx) {
+    assert(pSpans[idx].pBuffer || !pSpans[idx].samples);
+  }
+  if (vtable->pfnWritePcmStreamv) {
+    return vtable->pfnWritePcmStreamv(stream, pSpans, spanCount);
+  }
+  return skWritePcmStreamvBase(stream, vtable->pfnWritePcmStreamInterleaved, pSpans, spanCount);
+}
+
+static int64_t SKAPI_CALL skReadPcmStreamv_validation(
+  SkPcmStream                           stream,
+  SkPcmStreamSpan const*                pSpans,
+  uint32_t                              spanCount
+) {
+  uint32_t idx;
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  assert(pSpans || !spanCount);
+  for (idx = 0; idx < spanCount; ++idx) {
+    assert(pSpans[idx].pBuffer || !pSpans[idx].samples);
+  }
+  if (vtable->pfnReadPcmStreamv) {
+    return vtable->pfnReadPcmStreamv(stream, pSpans, spanCount);
+  }
+  return skReadPcmStreamvBase(stream, vtable->pfnReadPcmStreamInterleaved, pSpans, spanCount);
+}
+
+static int64_t SKAPI_CALL skWritePcmStreamSilence_validation(
+  SkPcmStream                           stream,
+  uint32_t                              samples
+) {
+  int64_t result;
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  if (!vtable->pfnWritePcmStreamSilence) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  result = vtable->pfnWritePcmStreamSilence(stream, samples);
+  assert(result < 0 || result <= samples);
+  return result;
+}
+
+static SkResult SKAPI_CALL skGetPcmStreamStatistics_validation(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatistics*                pStatistics
+) {
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  assert(pStatistics);
+  if (!vtable->pfnGetPcmStreamStatistics) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return vtable->pfnGetPcmStreamStatistics(stream, streamType, pStatistics);
+}
+
+static SkResult SKAPI_CALL skAvailPcmStreamSamplesCached_validation(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t*                             pSamples
+) {
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  assert(pSamples);
+  if (!vtable->pfnAvailPcmStreamSamplesCached) {
+    return vtable->pfnAvailPcmStreamSamples(stream, streamType, pSamples);
+  }
+  return vtable->pfnAvailPcmStreamSamplesCached(stream, streamType, pSamples);
+}
+
+static SkResult SKAPI_CALL skQueryPcmStreamStatus_validation(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  SkPcmStreamStatus*                    pStatus
+) {
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  assert(pStatus);
+  if (!vtable->pfnQueryPcmStreamStatus) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  return vtable->pfnQueryPcmStreamStatus(stream, streamType, pStatus);
+}
+
+static SkResult SKAPI_CALL skFlushPcmStream_validation(
+  SkPcmStream                           stream
+) {
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  if (!vtable->pfnFlushPcmStream) {
+    return SK_SUCCESS;
+  }
+  return vtable->pfnFlushPcmStream(stream);
+}
+
+static int64_t SKAPI_CALL skRewindPcmStream_validation(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  int64_t result;
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  if (!vtable->pfnRewindPcmStream) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  result = vtable->pfnRewindPcmStream(stream, streamType, samples);
+  assert(result < 0 || result <= samples);
+  return result;
+}
+
+static int64_t SKAPI_CALL skForwardPcmStream_validation(
+  SkPcmStream                           stream,
+  SkStreamFlagBits                      streamType,
+  uint32_t                              samples
+) {
+  int64_t result;
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  if (!vtable->pfnForwardPcmStream) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+  result = vtable->pfnForwardPcmStream(stream, streamType, samples);
+  assert(result < 0 || result <= samples);
+  return result;
+}
+
+static int64_t SKAPI_CALL skProcessPcmStreamInterleaved_validation(
+  SkPcmStream                           stream,
+  PFN_skPcmStreamProcessCallback        pfnCallback,
+  void*                                 pUserData
+) {
+  SkPcmStreamInfo readInfo;
+  SkPcmStreamInfo writeInfo;
+  SkPcmStreamFunctionTable const* vtable;
+  (void)skGetPcmStreamLayer(stream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable);
+  assert(pfnCallback);
+  if (!vtable->pfnProcessPcmStreamInterleaved) {
+    return SK_ERROR_FEATURE_NOT_PRESENT;
+  }
+
+  // Processing only makes sense for duplex streams.
+  if (vtable->pfnGetPcmStreamInfo(stream, SK_STREAM_PCM_READ_BIT, &readInfo) != SK_SUCCESS ||
+      vtable->pfnGetPcmStreamInfo(stream, SK_STREAM_PCM_WRITE_BIT, &writeInfo) != SK_SUCCESS) {
+    return SK_ERROR_NOT_SUPPORTED;
+  }
+  assert(readInfo.periodSamples == writeInfo.periodSamples);
+  return vtable->pfnProcessPcmStreamInterleaved(stream, pfnCallback, pUserData);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Layer Entrypoint
 ////////////////////////////////////////////////////////////////////////////////
@@ -578,6 +737,16 @@ SKAPI_ATTR PFN_skVoidFunction SKAPI_CALL skGetPcmStreamProcAddr_validation(
   HANDLE_PROC(skWritePcmStreamNoninterleaved);
   HANDLE_PROC(skReadPcmStreamInterleaved);
   HANDLE_PROC(skReadPcmStreamNoninterleaved);
+  HANDLE_PROC(skWritePcmStreamv);
+  HANDLE_PROC(skReadPcmStreamv);
+  HANDLE_PROC(skWritePcmStreamSilence);
+  HANDLE_PROC(skGetPcmStreamStatistics);
+  HANDLE_PROC(skAvailPcmStreamSamplesCached);
+  HANDLE_PROC(skQueryPcmStreamStatus);
+  HANDLE_PROC(skFlushPcmStream);
+  HANDLE_PROC(skRewindPcmStream);
+  HANDLE_PROC(skForwardPcmStream);
+  HANDLE_PROC(skProcessPcmStreamInterleaved);
   if (!skGetPcmStreamLayer(pcmStream, SK_LAYER_OPENSK_VALIDATION_UUID, &vtable)) {
     return NULL;
   }
@@ -0,0 +1,329 @@
+/*******************************************************************************
+ * Copyright 2016 Trent Reed
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *------------------------------------------------------------------------------
+ * A simple application that repeatedly creates an instance and reports the
+ * startup trace statistics, to catch cold-start regressions.
+ ******************************************************************************/
+
+// External Dependencies
+#include <OpenSK/opensk.h>
+#include <OpenSK/ext/sk_loader.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Utility Dependencies
+#include <OpenSK/utl/error.h>
+#include <OpenSK/utl/string.h>
+#include <OpenSK/utl/macros.h>
+
+// Defaults and constants
+#define SKBENCH_DEFAULT_ITERATIONS 20
+#define SKBENCH_MAX_EVENT_NAMES 64
+
+/*******************************************************************************
+ * User settings/properties and defaults
+ ******************************************************************************/
+static uint32_t iterations          = SKBENCH_DEFAULT_ITERATIONS;
+static SkBool32 isWarm              = SK_FALSE;
+static SkBool32 isLazy              = SK_FALSE;
+static SkBool32 isEnumerating       = SK_FALSE;
+static SkBool32 isJson              = SK_FALSE;
+
+/*******************************************************************************
+ * Benchmark statistics
+ ******************************************************************************/
+typedef struct SkBenchEventStatistics {
+  char                                  name[SK_MAX_TRACE_NAME_SIZE];
+  double*                               pSamples;
+  double                                min;
+  double                                median;
+  double                                mean;
+  double                                max;
+} SkBenchEventStatistics;
+
+static uint32_t currentIteration;
+static uint32_t eventNameCount;
+static SkBenchEventStatistics eventStatistics[SKBENCH_MAX_EVENT_NAMES];
+
+static SkBenchEventStatistics* skGetEventStatistics(char const* pName) {
+  uint32_t idx;
+  for (idx = 0; idx < eventNameCount; ++idx) {
+    if (strcmp(eventStatistics[idx].name, pName) == 0) {
+      return &eventStatistics[idx];
+    }
+  }
+  if (eventNameCount == SKBENCH_MAX_EVENT_NAMES) {
+    return NULL;
+  }
+  eventStatistics[idx].pSamples = calloc(iterations, sizeof(double));
+  if (!eventStatistics[idx].pSamples) {
+    return NULL;
+  }
+  strcpy(eventStatistics[idx].name, pName);
+  ++eventNameCount;
+  return &eventStatistics[idx];
+}
+
+// Note: Events which happen multiple times (e.g. once per manifest) are summed,
+//       so that each sample is the total time spent on that event per run.
+static void SKAPI_PTR skCollectStartupTrace(void* pUserData, uint32_t eventCount, SkStartupTraceEvent const* pEvents) {
+  uint32_t idx;
+  SkBenchEventStatistics* pStatistics;
+  (void)pUserData;
+  for (idx = 0; idx < eventCount; ++idx) {
+    pStatistics = skGetEventStatistics(pEvents[idx].name);
+    if (pStatistics) {
+      pStatistics->pSamples[currentIteration] += pEvents[idx].duration / 1e6;
+    }
+  }
+}
+
+static int skCompareSamples(void const* pLeft, void const* pRight) {
+  double lhs = *(double const*)pLeft;
+  double rhs = *(double const*)pRight;
+  return (lhs < rhs) ? -1 : (lhs > rhs) ? 1 : 0;
+}
+
+static void skCalculateStatistics(SkBenchEventStatistics* pStatistics) {
+  uint32_t idx;
+  qsort(pStatistics->pSamples, iterations, sizeof(double), &skCompareSamples);
+  pStatistics->min = pStatistics->pSamples[0];
+  pStatistics->max = pStatistics->pSamples[iterations - 1];
+  pStatistics->median = (iterations % 2)
+    ? pStatistics->pSamples[iterations / 2]
+    : (pStatistics->pSamples[iterations / 2 - 1] + pStatistics->pSamples[iterations / 2]) / 2.0;
+  pStatistics->mean = 0.0;
+  for (idx = 0; idx < iterations; ++idx) {
+    pStatistics->mean += pStatistics->pSamples[idx];
+  }
+  pStatistics->mean /= iterations;
+}
+
+/*******************************************************************************
+ * Benchmark functions
+ ******************************************************************************/
+static SkResult skEnumerateEverything(SkInstance instance) {
+  SkResult result;
+  uint32_t driverIdx;
+  uint32_t deviceIdx;
+  uint32_t driverCount;
+  uint32_t deviceCount;
+  uint32_t endpointCount;
+  SkDriver* pDrivers;
+  SkDevice* pDevices;
+
+  // Enumerate all of the drivers
+  result = skEnumerateInstanceDrivers(instance, &driverCount, NULL);
+  if (result != SK_SUCCESS) {
+    return result;
+  }
+  pDrivers = malloc(sizeof(SkDriver) * driverCount);
+  if (driverCount && !pDrivers) {
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+  result = skEnumerateInstanceDrivers(instance, &driverCount, pDrivers);
+
+  // Enumerate all of the devices and endpoints (this is what skls does)
+  for (driverIdx = 0; result == SK_SUCCESS && driverIdx < driverCount; ++driverIdx) {
+    result = skEnumerateDriverEndpoints(pDrivers[driverIdx], &endpointCount, NULL);
+    if (result != SK_SUCCESS) {
+      break;
+    }
+    result = skEnumerateDriverDevices(pDrivers[driverIdx], &deviceCount, NULL);
+    if (result != SK_SUCCESS) {
+      break;
+    }
+    pDevices = malloc(sizeof(SkDevice) * deviceCount);
+    if (deviceCount && !pDevices) {
+      result = SK_ERROR_OUT_OF_HOST_MEMORY;
+      break;
+    }
+    result = skEnumerateDriverDevices(pDrivers[driverIdx], &deviceCount, pDevices);
+    for (deviceIdx = 0; result == SK_SUCCESS && deviceIdx < deviceCount; ++deviceIdx) {
+      result = skEnumerateDeviceEndpoints(pDevices[deviceIdx], &endpointCount, NULL);
+    }
+    free(pDevices);
+  }
+
+  free(pDrivers);
+  return result;
+}
+
+static SkResult skRunIteration(void) {
+  SkResult result;
+  SkInstance instance;
+
+  SkApplicationInfo applicationInfo;
+  memset(&applicationInfo, 0, sizeof(SkApplicationInfo));
+  applicationInfo.sType = SK_STRUCTURE_TYPE_APPLICATION_INFO;
+  applicationInfo.apiVersion = SK_API_VERSION_0_0;
+  applicationInfo.applicationVersion = SK_API_VERSION_0_0;
+  applicationInfo.engineVersion = SK_API_VERSION_0_0;
+  applicationInfo.pApplicationName = "skbench-startup";
+  applicationInfo.pEngineName = "OpenSK";
+
+  SkStartupTraceCreateInfo traceInfo;
+  memset(&traceInfo, 0, sizeof(SkStartupTraceCreateInfo));
+  traceInfo.sType = SK_STRUCTURE_TYPE_STARTUP_TRACE_CREATE_INFO;
+  traceInfo.format = SK_STARTUP_TRACE_FORMAT_NONE;
+  traceInfo.pfnCallback = &skCollectStartupTrace;
+
+  SkInstanceCreateInfo createInfo;
+  memset(&createInfo, 0, sizeof(SkInstanceCreateInfo));
+  createInfo.sType = SK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  createInfo.pNext = &traceInfo;
+  createInfo.flags = (isLazy) ? SK_INSTANCE_CREATE_LAZY_DRIVERS_BIT : 0;
+  createInfo.pApplicationInfo = &applicationInfo;
+
+  // Unless a warm start was requested, start from an uninitialized loader.
+  if (!isWarm) {
+    skDeinitializeLoader();
+  }
+
+  // Create the OpenSK instance (and optionally walk the entire topology).
+  result = skCreateInstance(&createInfo, NULL, &instance);
+  if (skCheckCreateInstanceUTL(result)) {
+    return result;
+  }
+  if (isEnumerating) {
+    result = skEnumerateEverything(instance);
+    if (result != SK_SUCCESS) {
+      SKWRN("Failed to enumerate the instance topology (%d)", result);
+    }
+  }
+
+  // Note: The startup trace is reported when the instance is destroyed.
+  skDestroyInstance(instance, NULL);
+  return SK_SUCCESS;
+}
+
+/*******************************************************************************
+ * Main Entry Point
+ ******************************************************************************/
+int
+main(int argc, char const* argv[]) {
+  uint32_t idx;
+  SkResult result;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Handle command-line options.
+  //////////////////////////////////////////////////////////////////////////////
+  char const *param;
+  for (idx = 1; idx < (uint32_t)argc; ++idx) {
+    param = argv[idx];
+    if (skCheckParamUTL(param, "-n", "--iterations")) {
+      ++idx;
+      if (idx >= (uint32_t)argc) {
+        SKERR("Expected an iteration count after '%s' in parameter list!\n", param);
+        return -1;
+      }
+      if (sscanf(argv[idx], "%u", &iterations) != 1 || !iterations) {
+        SKERR("Failed to parse iteration count '%s'!\n", argv[idx]);
+        return -1;
+      }
+    }
+    else if (skCheckParamUTL(param, "-w", "--warm")) {
+      isWarm = SK_TRUE;
+    }
+    else if (skCheckParamUTL(param, "-l", "--lazy")) {
+      isLazy = SK_TRUE;
+    }
+    else if (skCheckParamUTL(param, "-e", "--enumerate")) {
+      isEnumerating = SK_TRUE;
+    }
+    else if (skCheckParamUTL(param, "-j", "--json")) {
+      isJson = SK_TRUE;
+    }
+    else if (skCheckParamUTL(param, "-h", "--help", NULL)) {
+      printf(
+        "Usage: skbench-startup [options]\n"
+        "\n"
+        "Repeatedly creates and destroys an OpenSK instance, and reports the\n"
+        "  startup trace statistics for each traced event (in milliseconds).\n"
+        "\n"
+        "Options:\n"
+        "  -h, --help        Prints this help documentation.\n"
+        "  -n, --iterations  The number of instances to create.\n"
+        "                    (Default: " SKSTR(SKBENCH_DEFAULT_ITERATIONS) ")\n"
+        "  -w, --warm        Keeps the loader initialized between iterations.\n"
+        "  -l, --lazy        Creates the instance with lazily-created drivers.\n"
+        "  -e, --enumerate   Enumerates all drivers, devices, and endpoints.\n"
+        "  -j, --json        Prints the statistics as JSON.\n"
+        "\n"
+        "Set SK_NO_MANIFEST_CACHE to measure startup without the manifest cache.\n"
+        "\n"
+        "OpenSK is copyright Trent Reed 2016 - All rights reserved.\n"
+        "Full documentation can be found online at <http://www.opensk.org/>.\n"
+      );
+      return 0;
+    }
+    else {
+      SKERR("Invalid or unsupported argument '%s'! (See --help)\n", param);
+      return -1;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Run the benchmark.
+  //////////////////////////////////////////////////////////////////////////////
+  for (currentIteration = 0; currentIteration < iterations; ++currentIteration) {
+    result = skRunIteration();
+    if (result != SK_SUCCESS) {
+      return result;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  // Report the statistics.
+  //////////////////////////////////////////////////////////////////////////////
+  for (idx = 0; idx < eventNameCount; ++idx) {
+    skCalculateStatistics(&eventStatistics[idx]);
+  }
+  if (isJson) {
+    printf("{\"iterations\":%u,\"warm\":%s,\"events\":[", iterations, (isWarm) ? "true" : "false");
+    for (idx = 0; idx < eventNameCount; ++idx) {
+      printf(
+        "%s\n{\"name\":\"%s\",\"min\":%.3f,\"median\":%.3f,\"mean\":%.3f,\"max\":%.3f}",
+        (idx) ? "," : "",
+        eventStatistics[idx].name,
+        eventStatistics[idx].min,
+        eventStatistics[idx].median,
+        eventStatistics[idx].mean,
+        eventStatistics[idx].max
+      );
+    }
+    printf("\n]}\n");
+  }
+  else {
+    printf("skbench-startup: %u iterations (%s loader)\n", iterations, (isWarm) ? "warm" : "cold");
+    printf("%-40s %10s %10s %10s %10s\n", "event", "min", "median", "mean", "max");
+    for (idx = 0; idx < eventNameCount; ++idx) {
+      printf(
+        "%-40s %10.3f %10.3f %10.3f %10.3f\n",
+        eventStatistics[idx].name,
+        eventStatistics[idx].min,
+        eventStatistics[idx].median,
+        eventStatistics[idx].mean,
+        eventStatistics[idx].max
+      );
+    }
+  }
+
+  for (idx = 0; idx < eventNameCount; ++idx) {
+    free(eventStatistics[idx].pSamples);
+  }
+  return 0;
+}
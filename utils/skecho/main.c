@@ -18,18 +18,21 @@
 
 // External Dependencies
 #include <OpenSK/opensk.h>
-#include <stdio.h>  // malloc
-#include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 
 // Utility Dependencies
+#include <OpenSK/utl/allocators.h>
 #include <OpenSK/utl/error.h>
+#include <OpenSK/utl/ring_buffer.h>
 #include <OpenSK/utl/string.h>
 #include <OpenSK/utl/macros.h>
 
 // Defaults and constants
 #define SKECHO_DEFAULT_DURATION 5.0
 #define SKECHO_DEFAULT_ENDPOINT NULL
+#define SKECHO_LIVE_RING_PERIODS 4
+#define SKECHO_LIVE_PRIME_PERIODS 2
 
 /*******************************************************************************
  * User settings/properties and defaults
@@ -37,6 +40,200 @@
 static float duration               = (float)(SKECHO_DEFAULT_DURATION);
 static char const* skCapturePath    = SKECHO_DEFAULT_ENDPOINT;
 static char const* skPlaybackPath   = SKECHO_DEFAULT_ENDPOINT;
+static SkBool32 isLive              = SK_FALSE;
+
+/*******************************************************************************
+ * Live echo statistics
+ ******************************************************************************/
+typedef struct SkEchoStatistics {
+  uint32_t                              overruns;
+  uint32_t                              underruns;
+  uint32_t                              droppedPeriods;
+  uint32_t                              latencyCount;
+  double                                latencyMin;
+  double                                latencyMax;
+  double                                latencySum;
+} SkEchoStatistics;
+
+static SkResult skRecoverEchoStream(SkPcmStream stream, int64_t result, uint32_t* pXruns) {
+  // Only xruns are expected while echoing, anything else is fatal.
+  if (result != SK_ERROR_XRUN) {
+    return (SkResult)result;
+  }
+  ++(*pXruns);
+  return skRecoverPcmStream(stream);
+}
+
+static void skRecordEchoLatency(SkEchoStatistics* pStatistics, double latency) {
+  if (!pStatistics->latencyCount || latency < pStatistics->latencyMin) {
+    pStatistics->latencyMin = latency;
+  }
+  if (!pStatistics->latencyCount || latency > pStatistics->latencyMax) {
+    pStatistics->latencyMax = latency;
+  }
+  pStatistics->latencySum += latency;
+  ++pStatistics->latencyCount;
+}
+
+/*******************************************************************************
+ * Live echo - passes captured periods through a fixed-size ring buffer.
+ ******************************************************************************/
+static SkResult skEchoLive(
+  SkPcmStream captureStream,
+  SkPcmStreamInfo const* pCaptureInfo,
+  SkPcmStream playbackStream,
+  SkPcmStreamInfo const* pPlaybackInfo,
+  uint32_t totalSamples
+) {
+  uint32_t idx;
+  void* pLocation;
+  void* pPeriodData;
+  int64_t samples;
+  SkResult result;
+  size_t ringBytes;
+  size_t frameBytes;
+  size_t captureBytes;
+  size_t playbackBytes;
+  size_t bytesRead;
+  size_t contiguousBytes;
+  uint32_t available;
+  uint32_t capturePeriod;
+  uint32_t captureSamples;
+  uint32_t playbackPeriod;
+  uint32_t samplesCaptured;
+  SkRingBufferUTL ringBuffer;
+  SkEchoStatistics statistics;
+
+  // Both streams were checked to be compatible, so frames are the same size.
+  frameBytes = pCaptureInfo->frameBits / 8;
+  capturePeriod = (pCaptureInfo->periodSamples) ? pCaptureInfo->periodSamples : pCaptureInfo->bufferSamples;
+  playbackPeriod = (pPlaybackInfo->periodSamples) ? pPlaybackInfo->periodSamples : pPlaybackInfo->bufferSamples;
+  if (!capturePeriod || !playbackPeriod || !frameBytes) {
+    SKERR("The streams did not report a period or buffer size.");
+    return SK_ERROR_INVALID;
+  }
+  captureBytes = capturePeriod * frameBytes;
+  playbackBytes = playbackPeriod * frameBytes;
+
+  // The ring holds whole capture periods (so a capture never has to be split),
+  // and must be able to hold at least two playback periods.
+  ringBytes = SKECHO_LIVE_RING_PERIODS * captureBytes;
+  if (ringBytes < 2 * playbackBytes) {
+    ringBytes = ((2 * playbackBytes + captureBytes - 1) / captureBytes) * captureBytes;
+  }
+  result = skCreateRingBufferUTL(
+    ringBytes,
+    SK_RING_BUFFER_CREATE_LOCKED_BIT_UTL,
+    NULL,
+    SK_SYSTEM_ALLOCATION_SCOPE_COMMAND,
+    &ringBuffer
+  );
+  if (result != SK_SUCCESS) {
+    SKERR("Failed to allocate the ring buffer for live echo.");
+    return result;
+  }
+  pPeriodData = skAllocatePcmBufferUTL(pPlaybackInfo, 1, 0);
+  if (!pPeriodData) {
+    SKERR("Failed to allocate the playback period for live echo.");
+    skDestroyRingBufferUTL(ringBuffer);
+    return SK_ERROR_OUT_OF_HOST_MEMORY;
+  }
+
+  // Prime the playback stream, so that it doesn't run dry before the first
+  // capture period arrives (this is the minimum latency of the echo).
+  // Note: The requested format is signed, so silence is all zeroes if the
+  //       driver can't write silence on its own.
+  memset(&statistics, 0, sizeof(SkEchoStatistics));
+  memset(pPeriodData, 0, playbackBytes);
+  for (idx = 0; idx < SKECHO_LIVE_PRIME_PERIODS; ++idx) {
+    samples = skWritePcmStreamSilence(playbackStream, playbackPeriod);
+    if (samples == SK_ERROR_FEATURE_NOT_PRESENT) {
+      samples = skWritePcmStreamInterleaved(playbackStream, pPeriodData, playbackPeriod);
+    }
+    if (skCheckWritePcmStreamUTL(samples, playbackPeriod)) {
+      skFreePcmBufferUTL(pPeriodData);
+      skDestroyRingBufferUTL(ringBuffer);
+      return SK_ERROR_INVALID;
+    }
+  }
+
+  // Capture and playback run at the same time, the ring buffer absorbs any
+  // difference between their period sizes.
+  result = SK_SUCCESS;
+  samplesCaptured = 0;
+  while (samplesCaptured < totalSamples) {
+
+    // If playback fell behind, drop the oldest period to keep latency bounded.
+    if (skRingBufferWriteRemainingUTL(ringBuffer) < captureBytes) {
+      skRingBufferAdvanceReadLocationUTL(ringBuffer, captureBytes);
+      ++statistics.droppedPeriods;
+    }
+
+    // Capture directly into the ring buffer.
+    // Note: Short reads can leave the end of the ring part-way through a
+    //       period, so never read past the contiguous space.
+    contiguousBytes = skRingBufferNUTLWriteLocationUTL(ringBuffer, &pLocation);
+    captureSamples = (uint32_t)SKMIN(capturePeriod, contiguousBytes / frameBytes);
+    samples = skReadPcmStreamInterleaved(captureStream, pLocation, captureSamples);
+    if (samples < 0) {
+      result = skRecoverEchoStream(captureStream, samples, &statistics.overruns);
+      if (result != SK_SUCCESS) {
+        SKERR("Failed to read from the capture stream.");
+        break;
+      }
+      continue;
+    }
+    skRingBufferAdvanceWriteLocationUTL(ringBuffer, (size_t)samples * frameBytes);
+    samplesCaptured += (uint32_t)samples;
+
+    // Play every complete period which is available.
+    while (skRingBufferReadRemainingUTL(ringBuffer) >= playbackBytes) {
+      bytesRead = skRingBufferReadUTL(ringBuffer, pPeriodData, playbackBytes);
+      if (bytesRead < playbackBytes) {
+        skRingBufferReadUTL(ringBuffer, (char*)pPeriodData + bytesRead, playbackBytes - bytesRead);
+      }
+
+      // Latency is everything captured which hasn't been heard yet.
+      if (skAvailPcmStreamSamples(playbackStream, SK_STREAM_PCM_WRITE_BIT, &available) == SK_SUCCESS) {
+        skRecordEchoLatency(
+          &statistics,
+          1000.0 * (double)(playbackPeriod + skRingBufferReadRemainingUTL(ringBuffer) / frameBytes + pPlaybackInfo->bufferSamples - SKMIN(available, pPlaybackInfo->bufferSamples)) / pCaptureInfo->sampleRate
+        );
+      }
+
+      samples = skWritePcmStreamInterleaved(playbackStream, pPeriodData, playbackPeriod);
+      if (samples < 0) {
+        result = skRecoverEchoStream(playbackStream, samples, &statistics.underruns);
+        if (result != SK_SUCCESS) {
+          SKERR("Failed to write to the playback stream.");
+          break;
+        }
+      }
+    }
+    if (result != SK_SUCCESS) {
+      break;
+    }
+  }
+
+  // Report how the echo performed.
+  printf("Captured:  %u samples\n", samplesCaptured);
+  if (statistics.latencyCount) {
+    printf(
+      "Latency:   %.2fms min, %.2fms avg, %.2fms max\n",
+      statistics.latencyMin,
+      statistics.latencySum / statistics.latencyCount,
+      statistics.latencyMax
+    );
+  }
+  printf("Overruns:  %u\n", statistics.overruns);
+  printf("Underruns: %u\n", statistics.underruns);
+  printf("Dropped:   %u periods\n", statistics.droppedPeriods);
+  printf("Memory:    %u bytes\n", (uint32_t)(ringBytes + playbackBytes));
+
+  skFreePcmBufferUTL(pPeriodData);
+  skDestroyRingBufferUTL(ringBuffer);
+  return result;
+}
 
 /*******************************************************************************
  * Main Entry Point
@@ -86,6 +283,9 @@ main(int argc, char const* argv[]) {
       }
       skPlaybackPath = argv[idx];
     }
+    else if (skCheckParamUTL(param, "-l", "--live", NULL)) {
+      isLive = SK_TRUE;
+    }
     else if (skCheckParamUTL(param, "-h", "--help", NULL)) {
       printf(
         "Usage: skecho [options]\n"
@@ -100,6 +300,8 @@ main(int argc, char const* argv[]) {
         "                   e.g. sk://<host>/<endpoint>\n"
         "  -d, --duration   Parses the next argument as a float in seconds, for note duration.\n"
         "                   (Default: " SKSTR(SKECHO_DEFAULT_DURATION) ")\n"
+        "  -l, --live       Plays back while capturing (through a fixed-size ring buffer),\n"
+        "                   and reports the measured latency and xruns.\n"
         "\n"
         "OpenSK is copyright Trent Reed 2016 - All rights reserved.\n"
         "Full documentation can be found online at <http://www.opensk.org/>.\n"
@@ -138,6 +340,7 @@ main(int argc, char const* argv[]) {
   SkInstanceCreateInfo createInfo;
   memset(&createInfo, 0, sizeof(SkInstanceCreateInfo));
   createInfo.sType = SK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  createInfo.flags = SK_INSTANCE_CREATE_LAZY_DRIVERS_BIT;
   createInfo.pApplicationInfo = &applicationInfo;
 
   // Create the OpenSK instance
@@ -236,10 +439,29 @@ main(int argc, char const* argv[]) {
     return -1;
   }
 
-  // Allocate enough data to hold all samples.
+  // In live mode, the memory used does not depend on the duration.
+  if (isLive) {
+    result = skEchoLive(captureStream, &captureInfo, playbackStream, &playbackInfo, totalSamples);
+    skDestroyInstance(instance, NULL);
+    return (result == SK_SUCCESS) ? 0 : -1;
+  }
+
+  // Allocate enough periods to hold all samples.
   // Note: This is done instead of a ring buffer for debugging/simplicity.
+  //       The buffer is prefaulted and locked so capture doesn't page fault.
+  uint32_t periodSamples;
+  periodSamples = (captureInfo.periodSamples) ? captureInfo.periodSamples : captureInfo.bufferSamples;
+  if (!periodSamples) {
+    SKERR("The capture stream did not report a period or buffer size.");
+    skDestroyInstance(instance, NULL);
+    return -1;
+  }
   void* sampleData;
-  sampleData = malloc(totalSamples * (captureInfo.frameBits / 8));
+  sampleData = skAllocatePcmBufferUTL(
+    &captureInfo,
+    (totalSamples + periodSamples - 1) / periodSamples,
+    0
+  );
   if (!sampleData) {
     SKERR("Failed to allocate enough space for capturing the requested data.");
     skDestroyInstance(instance, NULL);
@@ -252,7 +474,7 @@ main(int argc, char const* argv[]) {
   samplesCaptured = skReadPcmStreamInterleaved(captureStream, sampleData, totalSamples);
   if (skCheckWritePcmStreamUTL(samplesCaptured, totalSamples)) {
     skDestroyInstance(instance, NULL);
-    free(sampleData);
+    skFreePcmBufferUTL(sampleData);
     return -1;
   }
 
@@ -262,7 +484,7 @@ main(int argc, char const* argv[]) {
   samplesPlayback = skWritePcmStreamInterleaved(playbackStream, sampleData, totalSamples);
   if (skCheckWritePcmStreamUTL(samplesPlayback, totalSamples)) {
     skDestroyInstance(instance, NULL);
-    free(sampleData);
+    skFreePcmBufferUTL(sampleData);
     return -1;
   }
 
@@ -270,7 +492,7 @@ main(int argc, char const* argv[]) {
   result = skClosePcmStream(playbackStream, SK_TRUE);
   if (skCheckClosePcmStreamUTL(result)) {
     skDestroyInstance(instance, NULL);
-    free(sampleData);
+    skFreePcmBufferUTL(sampleData);
     return -1;
   }
 
@@ -279,7 +501,7 @@ main(int argc, char const* argv[]) {
   //////////////////////////////////////////////////////////////////////////////
   // Note: When calling skDestroyInstance, all SkObjects are destroyed.
   skDestroyInstance(instance, NULL);
-  free(sampleData);
+  skFreePcmBufferUTL(sampleData);
 
   return 0;
 }
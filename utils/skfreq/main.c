@@ -249,6 +249,7 @@ main(int argc, char const *argv[]) {
   SkInstanceCreateInfo instanceInfo;
   memset(&instanceInfo, 0, sizeof(SkInstanceCreateInfo));
   instanceInfo.sType = SK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  instanceInfo.flags = SK_INSTANCE_CREATE_LAZY_DRIVERS_BIT;
   instanceInfo.pApplicationInfo = &applicationInfo;
 
   // Create the OpenSK instance